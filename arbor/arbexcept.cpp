@@ -42,6 +42,12 @@ bad_probe_id::bad_probe_id(cell_member_type probe_id):
     probe_id(probe_id)
 {}
 
+bad_sample_sink::bad_sample_sink(cell_member_type probe_id, std::size_t width):
+    arbor_exception(pprintf("sample sink for probe id {} requires a ring buffer of width {}", probe_id, width)),
+    probe_id(probe_id),
+    width(width)
+{}
+
 gj_unsupported_domain_decomposition::gj_unsupported_domain_decomposition(cell_gid_type gid_0, cell_gid_type gid_1):
     arbor_exception(pprintf("No support for gap junctions across domain decomposition groups for gid {} and {}", gid_0, gid_1)),
     gid_0(gid_0),
@@ -123,6 +129,10 @@ range_check_failure::range_check_failure(const std::string& whatstr, double valu
     value(value)
 {}
 
+bad_checkpoint::bad_checkpoint(const std::string& msg):
+    arbor_exception(pprintf("invalid checkpoint: {}", msg))
+{}
+
 file_not_found_error::file_not_found_error(const std::string &fn)
     : arbor_exception(pprintf("Could not find file '{}'", fn)),
       filename{fn}
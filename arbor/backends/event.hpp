@@ -48,6 +48,11 @@ inline deliverable_event_data event_data(const deliverable_event& ev) {
     return {ev.handle.mech_id, ev.handle.mech_index, ev.weight};
 }
 
+// Events are partitioned by target mechanism in multi_event_stream:
+inline cell_local_size_type event_key(const deliverable_event& ev) {
+    return ev.handle.mech_id;
+}
+
 
 // Sample events (raw values from back-end state).
 
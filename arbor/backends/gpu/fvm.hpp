@@ -41,6 +41,9 @@ struct backend {
     }
 
     using matrix_state = arb::gpu::matrix_state_fine<value_type, index_type>;
+
+    // The GPU matrix solver does not use the thread pool.
+    static void matrix_set_thread_pool(matrix_state&, const execution_context&) {}
     using threshold_watcher = arb::gpu::threshold_watcher;
 
     using deliverable_event_stream = arb::gpu::deliverable_event_stream;
@@ -67,6 +70,17 @@ struct backend {
     }
 
     static value_type* mechanism_field_data(arb::mechanism* mptr, const std::string& field);
+
+    // Point mechanism instances stay in CV order, as required by reduce_by_key.
+    static unsigned mechanism_simd_width(arb::mechanism*) { return 1; }
+
+    // Tiled time stepping and fused density mechanisms are not supported on
+    // the GPU back end.
+    static constexpr bool supports_tiling = false;
+    static constexpr bool supports_fused_density = false;
+    static constexpr bool supports_adaptive_dt = false;
+    static constexpr bool supports_implicit_gj = false;
+    static constexpr bool supports_checkpoint = false;
 };
 
 } // namespace gpu
@@ -0,0 +1,190 @@
+#pragma once
+
+// Branch-parallel Hines solver for the matrix of a single large cell.
+//
+// The CVs of the cell are renumbered with a root chosen to minimize the depth
+// of the tree (see `tree::minimize_depth`), such that each unbranched section
+// (branch) occupies a contiguous range of CVs, with parents preceding
+// children. Branches are grouped into levels by the number of branch points
+// between them and the root.
+//
+// The backward sweep eliminates the branches of each level, from the leaves
+// to the root, concurrently on the task system; the contribution of each
+// branch to its parent CV, which lies at the end of a branch in the level
+// above, is stored per branch and then accumulated serially in branch order,
+// so that results do not depend upon the number of threads. The forward sweep
+// proceeds from the root, again concurrently over the branches of each level.
+
+#include <algorithm>
+#include <vector>
+
+#include <arbor/assert.hpp>
+
+#include "threading/threading.hpp"
+#include "tree.hpp"
+#include "util/partition.hpp"
+#include "util/span.hpp"
+
+namespace arb {
+namespace multicore {
+
+template <typename T, typename I>
+class fine_solver {
+public:
+    using value_type = T;
+    using index_type = I;
+
+    fine_solver() = default;
+
+    // Construct from the parent index of the cell's CVs, relative to the
+    // first CV of the cell. Sets `perm` to the renumbering of the CVs, such
+    // that CV i in solver order is CV perm[i] in the given order.
+    fine_solver(const std::vector<index_type>& p, std::vector<index_type>& perm) {
+        auto n = p.size();
+        arb_assert(n>0);
+
+        std::vector<tree::int_type> tree_p(n);
+        for (auto i: util::make_span(n)) {
+            tree_p[i] = p[i]<0 || p[i]==(index_type)i? tree::no_parent: p[i];
+        }
+
+        tree t(tree_p);
+        auto order = t.minimize_depth();
+        perm.assign(order.begin(), order.end());
+
+        parent_.resize(n);
+        for (auto i: util::make_span(n)) {
+            auto q = t.parent(i);
+            parent_[i] = q==tree::no_parent? -1: (index_type)q;
+            arb_assert(parent_[i]<(index_type)i);
+        }
+
+        // Partition CVs into branches.
+        std::vector<index_type> n_child(n, 0);
+        for (auto i: util::make_span(1, n)) {
+            ++n_child[parent_[i]];
+        }
+
+        branch_divs_ = {0};
+        for (auto i: util::make_span(1, n)) {
+            auto q = parent_[i];
+            if (q!=index_type(i)-1 || n_child[q]>1) {
+                branch_divs_.push_back(i);
+            }
+        }
+        branch_divs_.push_back(n);
+
+        // Group branches by level.
+        auto n_branch = branch_divs_.size()-1;
+        std::vector<index_type> branch_level(n_branch, 0), cv_branch(n);
+        for (auto b: util::make_span(n_branch)) {
+            auto first = branch_divs_[b];
+            std::fill(cv_branch.begin()+first, cv_branch.begin()+branch_divs_[b+1], b);
+            if (first>0) {
+                branch_level[b] = branch_level[cv_branch[parent_[first]]]+1;
+            }
+        }
+
+        auto n_level = *std::max_element(branch_level.begin(), branch_level.end())+1;
+        std::vector<index_type> level_count(n_level, 0);
+        for (auto l: branch_level) ++level_count[l];
+        util::make_partition(level_divs_, level_count);
+
+        level_branches_.resize(n_branch);
+        level_cvs_.assign(n_level, 0);
+        std::vector<index_type> pos(level_divs_.begin(), level_divs_.end()-1);
+        for (auto b: util::make_span(n_branch)) {
+            level_branches_[pos[branch_level[b]]++] = b;
+            level_cvs_[branch_level[b]] += branch_divs_[b+1]-branch_divs_[b];
+        }
+
+        contrib_d_.assign(n_branch, 0);
+        contrib_rhs_.assign(n_branch, 0);
+    }
+
+    // Parent of CV i in solver order; -1 for the root.
+    const std::vector<index_type>& parent_index() const { return parent_; }
+
+    // Solve in place, with the matrix entries in solver order. Cells with a
+    // zero diagonal (zero dt) are left as-is.
+    void solve(value_type* d, const value_type* u, value_type* rhs, threading::task_system* ts) {
+        if (parent_.empty() || d[0]==0) return;
+
+        auto levels = util::partition_view(level_divs_);
+
+        // backward sweep
+        for (auto l = levels.size(); l-->0; ) {
+            for_each_branch(l, ts,
+                [&](index_type b) {
+                    auto first = branch_divs_[b];
+                    for (auto i = branch_divs_[b+1]-1; i>first; --i) {
+                        auto factor = u[i] / d[i];
+                        d[i-1]   -= factor * u[i];
+                        rhs[i-1] -= factor * rhs[i];
+                    }
+                    if (first>0) {
+                        auto factor = u[first] / d[first];
+                        contrib_d_[b]   = factor * u[first];
+                        contrib_rhs_[b] = factor * rhs[first];
+                    }
+                });
+
+            if (l>0) {
+                for (auto k: util::make_span(levels[l])) {
+                    auto b = level_branches_[k];
+                    auto p = parent_[branch_divs_[b]];
+                    d[p]   -= contrib_d_[b];
+                    rhs[p] -= contrib_rhs_[b];
+                }
+            }
+        }
+        rhs[0] /= d[0];
+
+        // forward sweep
+        for (auto l: util::make_span(levels.size())) {
+            for_each_branch(l, ts,
+                [&](index_type b) {
+                    auto first = branch_divs_[b];
+                    if (first>0) {
+                        rhs[first] -= u[first] * rhs[parent_[first]];
+                        rhs[first] /= d[first];
+                    }
+                    for (auto i = first+1; i<branch_divs_[b+1]; ++i) {
+                        rhs[i] -= u[i] * rhs[i-1];
+                        rhs[i] /= d[i];
+                    }
+                });
+        }
+    }
+
+private:
+    std::vector<index_type> parent_;
+    std::vector<index_type> branch_divs_;     // Partition of CVs by branch.
+    std::vector<index_type> level_divs_;      // Partition of level_branches_ by level.
+    std::vector<index_type> level_branches_;  // Branches ordered by level.
+    std::vector<index_type> level_cvs_;       // Number of CVs in each level.
+
+    std::vector<value_type> contrib_d_;       // Per branch contribution to parent CV.
+    std::vector<value_type> contrib_rhs_;
+
+    // Levels with fewer CVs than this are eliminated serially.
+    static constexpr index_type min_parallel_cvs = 4096;
+
+    template <typename F>
+    void for_each_branch(index_type l, threading::task_system* ts, F&& f) {
+        auto first = level_divs_[l];
+        auto last = level_divs_[l+1];
+
+        if (!ts || ts->get_num_threads()<2 || last-first<2 || level_cvs_[l]<min_parallel_cvs) {
+            for (auto k: util::make_span(first, last)) f(level_branches_[k]);
+        }
+        else {
+            int batch = std::max(1, (last-first)/(4*ts->get_num_threads()));
+            threading::parallel_for::apply(first, last, batch, ts,
+                [&](int k) { f(level_branches_[k]); });
+        }
+    }
+};
+
+} // namespace multicore
+} // namespace arb
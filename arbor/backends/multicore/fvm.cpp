@@ -1,10 +1,12 @@
 #include <string>
 
+#include <arbor/arbexcept.hpp>
 #include <arbor/mechanism.hpp>
 #include "fvm.hpp"
 #include "mechanism.hpp"
 
-// Provides implementation of backend::mechanism_field_data.
+// Provides implementation of backend::mechanism_field_data, the mechanism
+// tiling and blocking interfaces, and mechanism checkpoints.
 
 namespace arb {
 namespace multicore {
@@ -14,5 +16,46 @@ fvm_value_type* backend::mechanism_field_data(arb::mechanism* mptr, const std::s
     return m? m->field_data(field): nullptr;
 }
 
+unsigned backend::mechanism_simd_width(arb::mechanism* mptr) {
+    arb::multicore::mechanism* m = dynamic_cast<arb::multicore::mechanism*>(mptr);
+    return m? m->simd_width(): 1;
+}
+
+bool backend::mechanism_set_tiles(arb::mechanism* mptr, const std::vector<index_type>& tile_cv_divs) {
+    arb::multicore::mechanism* m = dynamic_cast<arb::multicore::mechanism*>(mptr);
+    return m && m->set_tiles(tile_cv_divs);
+}
+
+void backend::mechanism_select_tile(arb::mechanism* mptr, size_type tile) {
+    static_cast<arb::multicore::mechanism*>(mptr)->select_tile(tile);
+}
+
+void backend::mechanism_select_all(arb::mechanism* mptr) {
+    static_cast<arb::multicore::mechanism*>(mptr)->select_all();
+}
+
+backend::size_type backend::mechanism_set_blocks(arb::mechanism* mptr, size_type block_size) {
+    arb::multicore::mechanism* m = dynamic_cast<arb::multicore::mechanism*>(mptr);
+    return m? m->set_blocks(block_size): 0;
+}
+
+void backend::mechanism_select_block(arb::mechanism* mptr, size_type block) {
+    static_cast<arb::multicore::mechanism*>(mptr)->select_block(block);
+}
+
+static arb::multicore::mechanism* checkpoint_mechanism(arb::mechanism* mptr) {
+    arb::multicore::mechanism* m = dynamic_cast<arb::multicore::mechanism*>(mptr);
+    if (!m) throw bad_checkpoint("mechanism '"+mptr->internal_name()+"' does not support checkpoints");
+    return m;
+}
+
+void backend::mechanism_write_checkpoint(arb::mechanism* mptr, checkpoint_writer& w) {
+    checkpoint_mechanism(mptr)->write_checkpoint(w);
+}
+
+void backend::mechanism_read_checkpoint(arb::mechanism* mptr, checkpoint_reader& r) {
+    checkpoint_mechanism(mptr)->read_checkpoint(r);
+}
+
 } // namespace multicore
 } // namespace arb
@@ -6,7 +6,7 @@
 #include <arbor/mechanism.hpp>
 
 #include "backends/event.hpp"
-#include "backends/multicore/matrix_state.hpp"
+#include "backends/multicore/matrix_state_interleaved.hpp"
 #include "backends/multicore/multi_event_stream.hpp"
 #include "backends/multicore/multicore_common.hpp"
 #include "backends/multicore/shared_state.hpp"
@@ -38,7 +38,12 @@ struct backend {
         return util::range_pointer_view(v);
     }
 
-    using matrix_state = arb::multicore::matrix_state<value_type, index_type>;
+    using matrix_state = arb::multicore::matrix_state_interleaved<value_type, index_type>;
+
+    // The matrix solver runs the fine solver for large cells on the thread pool.
+    static void matrix_set_thread_pool(matrix_state& m, const execution_context& context) {
+        m.set_thread_pool(context.thread_pool);
+    }
     using threshold_watcher = arb::multicore::threshold_watcher;
 
     using deliverable_event_stream = arb::multicore::deliverable_event_stream;
@@ -65,6 +70,32 @@ struct backend {
     }
 
     static fvm_value_type* mechanism_field_data(arb::mechanism* mptr, const std::string& field);
+
+    // Point mechanism instances are reordered to improve the SIMD index
+    // constraints of mechanisms with a SIMD width greater than one.
+    static unsigned mechanism_simd_width(arb::mechanism* mptr);
+
+    // Tiled time stepping: see multicore::mechanism::set_tiles().
+    static constexpr bool supports_tiling = true;
+    static bool mechanism_set_tiles(arb::mechanism* mptr, const std::vector<index_type>& tile_cv_divs);
+    static void mechanism_select_tile(arb::mechanism* mptr, size_type tile);
+    static void mechanism_select_all(arb::mechanism* mptr);
+
+    // Fused density mechanisms: see multicore::mechanism::set_blocks().
+    static constexpr bool supports_fused_density = true;
+    static size_type mechanism_set_blocks(arb::mechanism* mptr, size_type block_size);
+    static void mechanism_select_block(arb::mechanism* mptr, size_type block);
+
+    // Adaptive time stepping: see multicore::shared_state::adaptive_dt_end().
+    static constexpr bool supports_adaptive_dt = true;
+
+    // Implicit gap junctions: see multicore::shared_state::gj_implicit_begin().
+    static constexpr bool supports_implicit_gj = true;
+
+    // Checkpoint and restore: see multicore::shared_state::write_checkpoint().
+    static constexpr bool supports_checkpoint = true;
+    static void mechanism_write_checkpoint(arb::mechanism* mptr, checkpoint_writer& w);
+    static void mechanism_read_checkpoint(arb::mechanism* mptr, checkpoint_reader& r);
 };
 
 } // namespace multicore
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+
 #include <util/partition.hpp>
 #include <util/span.hpp>
 
@@ -85,11 +87,15 @@ public:
     //   current density [A.m^-2]  (per control volume)
     //   conductivity    [kS.m^-2] (per control volume)
     void assemble(const_view dt_intdom, const_view voltage, const_view current, const_view conductivity) {
+        assemble(dt_intdom, voltage, current, conductivity, 0, util::partition_view(cell_cv_divs).size());
+    }
+
+    // Assemble the submatrices of cells [cell_begin, cell_end) only.
+    void assemble(const_view dt_intdom, const_view voltage, const_view current, const_view conductivity, index_type cell_begin, index_type cell_end) {
         auto cell_cv_part = util::partition_view(cell_cv_divs);
-        const index_type ncells = cell_cv_part.size();
 
         // loop over submatrices
-        for (auto m: util::make_span(0, ncells)) {
+        for (auto m: util::make_span(cell_begin, cell_end)) {
             auto dt = dt_intdom[cell_to_intdom[m]];
 
             if (dt>0) {
@@ -114,8 +120,16 @@ public:
     }
 
     void solve() {
+        solve(0, util::partition_view(cell_cv_divs).size());
+    }
+
+    // Solve the submatrices of cells [cell_begin, cell_end) only.
+    void solve(index_type cell_begin, index_type cell_end) {
+        auto cell_cv_part = util::partition_view(cell_cv_divs);
+
         // loop over submatrices
-        for (auto cv_span: util::partition_view(cell_cv_divs)) {
+        for (auto m: util::make_span(cell_begin, cell_end)) {
+            auto cv_span = cell_cv_part[m];
             auto first = cv_span.first;
             auto last = cv_span.second; // one past the end
             if (first >= last) continue; // skip cell with no CVs
@@ -143,6 +157,14 @@ public:
         memory::copy(rhs, to);
     }
 
+    template<typename VTo>
+    void solve(VTo& to, index_type cell_begin, index_type cell_end) {
+        solve(cell_begin, cell_end);
+        auto first = rhs.begin()+cell_cv_divs[cell_begin];
+        auto last = rhs.begin()+cell_cv_divs[cell_end];
+        std::copy(first, last, to.begin()+cell_cv_divs[cell_begin]);
+    }
+
 private:
 
     std::size_t size() const {
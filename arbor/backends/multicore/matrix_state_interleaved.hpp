@@ -0,0 +1,426 @@
+#pragma once
+
+// Hines matrix storage and solver with the submatrices of W consecutive cells
+// interleaved lane-wise, where W is the native SIMD width, so that assembly
+// and the backward and forward sweeps run in lock step over W cells.
+//
+// The cells of each block of W cells are padded to the CV count of the
+// largest cell in the block. The CVs i of the cells in block b occupy the W
+// consecutive entries starting at block_offset[b] + i*W; padding entries
+// have a unit diagonal and zero off-diagonal and right hand side, and are
+// children of the lane's root, so they leave the solution unchanged.
+//
+// Cells with at least `fine_min_cvs` CVs instead form a block of their own,
+// stored in the order of and solved by a branch-parallel `fine_solver` on
+// the thread pool, if one is provided with `set_thread_pool`.
+
+#include <algorithm>
+#include <vector>
+
+#include <arbor/assert.hpp>
+#include <arbor/fvm_types.hpp>
+#include <arbor/simd/simd.hpp>
+
+#include <util/partition.hpp>
+#include <util/span.hpp>
+
+#include "threading/threading.hpp"
+
+#include "fine_solver.hpp"
+#include "multicore_common.hpp"
+
+namespace arb {
+namespace multicore {
+
+template <typename T, typename I>
+struct matrix_state_interleaved {
+public:
+    using value_type = T;
+    using index_type = I;
+
+    using array = padded_vector<value_type>;
+    using const_view = const array&;
+
+    using iarray = padded_vector<index_type>;
+
+    static constexpr index_type width = simd::simd_abi::native_width<value_type>::value;
+    using simd_value = simd::simd<value_type, width, simd::simd_abi::default_abi>;
+    using simd_index = simd::simd<index_type, width, simd::simd_abi::default_abi>;
+    using simd_mask = typename simd_value::simd_mask;
+
+    // Default minimum CV count of cells solved by the fine solver.
+    static constexpr index_type default_fine_min_cvs = 10000;
+
+    iarray cell_cv_divs;
+    iarray cell_to_intdom;
+
+    // Partition of cells by block, with up to `width` cells per block.
+    iarray block_cell_divs;
+
+    // Start of each block in the interleaved storage.
+    iarray block_offset;
+
+    // Interleaved storage.
+    array d;                   // [μS]
+    array u;                   // [μS]
+    array rhs;                 // [nA]
+
+    array cv_capacitance;      // [pF]
+    array cv_area;             // [μm^2]
+
+    // the invariant part of the matrix diagonal
+    array invariant_d;         // [μS]
+
+    iarray parent_index;       // Interleaved index of parent.
+    iarray cv_index;           // Index of CV in flat (per CV) storage.
+    iarray lane_intdom;        // Integration domain of each lane of each block.
+
+    // Index into `fine` of the solver of each block, or -1 for interleaved blocks.
+    iarray block_fine;
+    std::vector<fine_solver<value_type, index_type>> fine;
+
+    matrix_state_interleaved() = default;
+
+    matrix_state_interleaved(const std::vector<index_type>& p,
+                 const std::vector<index_type>& cell_cv_divs,
+                 const std::vector<value_type>& cap,
+                 const std::vector<value_type>& cond,
+                 const std::vector<value_type>& area,
+                 const std::vector<index_type>& cell_to_intdom,
+                 index_type fine_min_cvs = default_fine_min_cvs):
+        cell_cv_divs(cell_cv_divs.begin(), cell_cv_divs.end()),
+        cell_to_intdom(cell_to_intdom.begin(), cell_to_intdom.end())
+    {
+        arb_assert(cap.size() == p.size());
+        arb_assert(cond.size() == p.size());
+        arb_assert(cell_cv_divs.back() == (index_type)p.size());
+
+        // Group consecutive cells into blocks of up to `width` cells, with
+        // large cells in blocks of their own.
+        block_cell_divs.push_back(0);
+        for (auto c: util::make_span(num_cells())) {
+            if (cell_size(c)>0 && cell_size(c)>=fine_min_cvs) {
+                if (block_cell_divs.back()<c) {
+                    block_cell_divs.push_back(c);
+                    block_fine.push_back(-1);
+                }
+                block_cell_divs.push_back(c+1);
+                block_fine.push_back(fine.size());
+                fine.emplace_back();
+            }
+            else if (c+1-block_cell_divs.back()==width) {
+                block_cell_divs.push_back(c+1);
+                block_fine.push_back(-1);
+            }
+        }
+        if (block_cell_divs.back()<num_cells()) {
+            block_cell_divs.push_back(num_cells());
+            block_fine.push_back(-1);
+        }
+
+        auto n_block = block_cell_divs.size()-1;
+        block_offset.assign(n_block+1, 0);
+        for (auto b: util::make_span(n_block)) {
+            index_type n_max = 0;
+            for (auto c: block_cells(b)) {
+                n_max = std::max(n_max, cell_size(c));
+            }
+            block_offset[b+1] = block_offset[b] + n_max*block_width(b);
+        }
+
+        auto n = block_offset.back();
+        d = array(n, 0);
+        u = array(n, 0);
+        rhs = array(n, 0);
+        cv_capacitance = array(n, 0);
+        cv_area = array(n, 0);
+        invariant_d = array(n, 1);
+        parent_index = iarray(n);
+        cv_index = iarray(n);
+        lane_intdom = iarray(n_block*width);
+
+        for (auto b: util::make_span(n_block)) {
+            auto cells = block_cells(b);
+            for (auto lane: util::make_span(width)) {
+                // Unused lanes mirror the first cell of the block.
+                auto c = lane<(index_type)cells.size()? cells[lane]: cells[0];
+                auto root = cell_cv_divs[c];
+                lane_intdom[b*width+lane] = cell_to_intdom[c];
+
+                if (block_fine[b]<0) {
+                    for (auto i = block_offset[b]+lane; i<block_offset[b+1]; i += width) {
+                        parent_index[i] = block_offset[b]+lane;
+                        cv_index[i] = root;
+                    }
+                }
+            }
+
+            for (auto lane: util::count_along(cells)) {
+                auto c = cells[lane];
+                auto first = cell_cv_divs[c];
+                auto n_cv = cell_size(c);
+
+                // Position in storage of each CV of the cell.
+                std::vector<index_type> pos(n_cv), p_local, perm;
+                if (block_fine[b]<0) {
+                    for (auto k: util::make_span(n_cv)) pos[k] = slot(b, k, lane);
+                }
+                else {
+                    for (auto j: util::make_span(cell_cv_part()[c])) {
+                        p_local.push_back(p[j]==-1? -1: p[j]-first);
+                    }
+                    fine[block_fine[b]] = fine_solver<value_type, index_type>(p_local, perm);
+                    for (auto k: util::make_span(n_cv)) pos[perm[k]] = block_offset[b]+k;
+                }
+
+                for (auto j: util::make_span(cell_cv_part()[c])) {
+                    auto i = pos[j-first];
+                    invariant_d[i] = 0;
+                    cv_index[i] = j;
+                    cv_capacitance[i] = cap[j];
+                    cv_area[i] = area[j];
+                }
+                for (auto j: util::make_span(cell_cv_part()[c])) {
+                    auto i = pos[j-first];
+                    if (p[j]!=-1) {
+                        parent_index[i] = pos[p[j]-first];
+                    }
+                    // As for the flat layout, the first CV overall has no face.
+                    if (j>0) {
+                        auto gij = cond[j];
+
+                        u[i] = -gij;
+                        invariant_d[i] += gij;
+                        if (p[j]!=-1) {
+                            invariant_d[parent_index[i]] += gij;
+                        }
+                    }
+                }
+
+                // The fine solver's root may differ: orient the off-diagonal
+                // entries by its parent index.
+                if (block_fine[b]>=0) {
+                    const auto& fine_p = fine[block_fine[b]].parent_index();
+                    for (auto k: util::make_span(1, n_cv)) {
+                        auto i = perm[k];
+                        auto q = perm[fine_p[k]];
+                        parent_index[block_offset[b]+k] = block_offset[b]+fine_p[k];
+                        u[block_offset[b]+k] = -cond[first + (p_local[i]==q? i: q)];
+                    }
+                }
+            }
+        }
+    }
+
+    // Use the thread pool for the fine solver.
+    void set_thread_pool(task_system_handle ts) {
+        threads_ = std::move(ts);
+    }
+
+    // Assemble the matrix
+    // Afterwards the diagonal and RHS will have been set given dt, voltage and current.
+    //   dt_intdom       [ms]      (per integration domain)
+    //   voltage         [mV]      (per control volume)
+    //   current density [A.m^-2]  (per control volume)
+    //   conductivity    [kS.m^-2] (per control volume)
+    void assemble(const_view dt_intdom, const_view voltage, const_view current, const_view conductivity) {
+        assemble(dt_intdom, voltage, current, conductivity, 0, num_cells());
+    }
+
+    // Assemble the submatrices of cells [cell_begin, cell_end) only.
+    void assemble(const_view dt_intdom, const_view voltage, const_view current, const_view conductivity, index_type cell_begin, index_type cell_end) {
+        for_each_block(cell_begin, cell_end,
+            [&](auto b, auto active) { assemble_block(b, active, dt_intdom, voltage, current, conductivity); });
+    }
+
+    void solve() {
+        solve(0, num_cells());
+    }
+
+    // Solve the submatrices of cells [cell_begin, cell_end) only.
+    void solve(index_type cell_begin, index_type cell_end) {
+        for_each_block(cell_begin, cell_end,
+            [&](auto b, auto active) { solve_block(b, active); });
+    }
+
+    template<typename VTo>
+    void solve(VTo& to) {
+        solve(to, 0, num_cells());
+    }
+
+    template<typename VTo>
+    void solve(VTo& to, index_type cell_begin, index_type cell_end) {
+        solve(cell_begin, cell_end);
+
+        // Copy solution from the interleaved rhs to flat storage.
+        for (auto c: util::make_span(cell_begin, cell_end)) {
+            auto b = block_of(c);
+            if (block_fine[b]<0) {
+                auto lane = c-block_cell_divs[b];
+                auto first = cell_cv_divs[c];
+                for (auto j: util::make_span(cell_cv_part()[c])) {
+                    to[j] = rhs[slot(b, j-first, lane)];
+                }
+            }
+            else {
+                for (auto i: util::make_span(block_offset[b], block_offset[b+1])) {
+                    to[cv_index[i]] = rhs[i];
+                }
+            }
+        }
+    }
+
+private:
+    index_type num_cells() const {
+        return cell_cv_divs.size()-1;
+    }
+
+    auto cell_cv_part() const {
+        return util::partition_view(cell_cv_divs);
+    }
+
+    index_type cell_size(index_type c) const {
+        return cell_cv_divs[c+1]-cell_cv_divs[c];
+    }
+
+    task_system_handle threads_;
+
+    auto block_cells(index_type b) const {
+        return util::make_span(block_cell_divs[b], block_cell_divs[b+1]);
+    }
+
+    index_type block_of(index_type c) const {
+        return std::upper_bound(block_cell_divs.begin(), block_cell_divs.end(), c)-block_cell_divs.begin()-1;
+    }
+
+    index_type block_width(index_type b) const {
+        return block_fine[b]<0? width: 1;
+    }
+
+    index_type slot(index_type b, index_type i, index_type lane) const {
+        return block_offset[b] + i*block_width(b) + lane;
+    }
+
+    // Apply `fn` to each block with cells in [cell_begin, cell_end), with a
+    // mask of the lanes of those cells. Blocks that straddle the range ends
+    // are processed with the same (masked) operations as any other, so that
+    // results do not depend upon the range partition.
+    template <typename Fn>
+    void for_each_block(index_type cell_begin, index_type cell_end, Fn&& fn) {
+        if (cell_begin>=cell_end) return;
+
+        for (auto b: util::make_span(block_of(cell_begin), block_of(cell_end-1)+1)) {
+            bool active[width];
+            for (auto lane: util::make_span(width)) {
+                auto c = block_cell_divs[b]+lane;
+                active[lane] = c>=cell_begin && c<cell_end && c<block_cell_divs[b+1];
+            }
+            fn(b, simd_mask(active));
+        }
+    }
+
+    static simd_value gather(const value_type* p, const simd_index& index) {
+        simd_value v;
+        simd::assign(v, simd::indirect(p, index, width));
+        return v;
+    }
+
+    void assemble_block(index_type b, const simd_mask& active, const_view dt_intdom, const_view voltage, const_view current, const_view conductivity) {
+        using simd::indirect;
+        using simd::where;
+
+        if (block_fine[b]>=0) {
+            assemble_fine_block(b, dt_intdom, voltage, current, conductivity);
+            return;
+        }
+
+        simd_value dt = gather(dt_intdom.data(), simd_index(lane_intdom.data()+b*width));
+        auto step = dt>simd_value(value_type(0));
+        simd_value oodt_factor = simd_value(1e-3)/dt; // [1/µs]
+
+        for (auto i = block_offset[b]; i<block_offset[b+1]; i += width) {
+            simd_index cv(cv_index.data()+i);
+            simd_value v = gather(voltage.data(), cv);
+            simd_value area_factor = simd_value(1e-3)*simd_value(cv_area.data()+i); // [1e-9·m²]
+
+            simd_value gi = oodt_factor*simd_value(cv_capacitance.data()+i)
+                          + area_factor*gather(conductivity.data(), cv); // [μS]
+
+            simd_value di = gi + simd_value(invariant_d.data()+i);
+            // convert current to units nA
+            simd_value ri = gi*v - area_factor*gather(current.data(), cv);
+
+            where(!step, di) = simd_value(value_type(0));
+            where(!step, ri) = v;
+
+            indirect(d.data()+i, width) = where(active, di);
+            indirect(rhs.data()+i, width) = where(active, ri);
+        }
+    }
+
+    void assemble_fine_block(index_type b, const_view dt_intdom, const_view voltage, const_view current, const_view conductivity) {
+        auto dt = dt_intdom[lane_intdom[b*width]];
+
+        if (dt>0) {
+            value_type oodt_factor = 1e-3/dt; // [1/µs]
+            for (auto i: util::make_span(block_offset[b], block_offset[b+1])) {
+                auto j = cv_index[i];
+                auto area_factor = 1e-3*cv_area[i]; // [1e-9·m²]
+
+                auto gi = oodt_factor*cv_capacitance[i] + area_factor*conductivity[j]; // [μS]
+
+                d[i] = gi + invariant_d[i];
+                // convert current to units nA
+                rhs[i] = gi*voltage[j] - area_factor*current[j];
+            }
+        }
+        else {
+            for (auto i: util::make_span(block_offset[b], block_offset[b+1])) {
+                d[i] = 0;
+                rhs[i] = voltage[cv_index[i]];
+            }
+        }
+    }
+
+    void solve_block(index_type b, const simd_mask& active) {
+        using simd::indirect;
+        using simd::where;
+
+        auto first = block_offset[b];
+        auto last = block_offset[b+1];
+        if (first>=last) return; // skip block of cells with no CVs
+
+        if (block_fine[b]>=0) {
+            fine[block_fine[b]].solve(d.data()+first, u.data()+first, rhs.data()+first, threads_.get());
+            return;
+        }
+
+        // Lanes with zero diagonal (zero dt) are left as-is.
+        simd_mask m = active && simd_value(d.data()+first)!=simd_value(value_type(0));
+
+        // backward sweep
+        for (auto i = last-width; i>first; i -= width) {
+            simd_index p(parent_index.data()+i);
+            simd_value ui(u.data()+i);
+            simd_value factor = ui/simd_value(d.data()+i);
+
+            simd_value dp = gather(d.data(), p) - factor*ui;
+            simd_value rp = gather(rhs.data(), p) - factor*simd_value(rhs.data()+i);
+            indirect(d.data(), p, width) = where(m, dp);
+            indirect(rhs.data(), p, width) = where(m, rp);
+        }
+        simd_value r0 = simd_value(rhs.data()+first)/simd_value(d.data()+first);
+        indirect(rhs.data()+first, width) = where(m, r0);
+
+        // forward sweep
+        for (auto i = first+width; i<last; i += width) {
+            simd_index p(parent_index.data()+i);
+            simd_value ri = simd_value(rhs.data()+i) - simd_value(u.data()+i)*gather(rhs.data(), p);
+            ri = ri/simd_value(d.data()+i);
+            indirect(rhs.data()+i, width) = where(m, ri);
+        }
+    }
+};
+
+} // namespace multicore
+} // namespace arb
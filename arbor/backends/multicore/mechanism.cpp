@@ -18,9 +18,11 @@
 #include "util/rangeutil.hpp"
 
 #include "backends/multicore/mechanism.hpp"
+#include "checkpoint.hpp"
 #include "backends/multicore/multicore_common.hpp"
 #include "backends/multicore/fvm.hpp"
 #include "backends/multicore/partition_by_constraint.hpp"
+#include "backends/multicore/tiles.hpp"
 
 namespace arb {
 namespace multicore {
@@ -68,6 +70,7 @@ void mechanism::instantiate(unsigned id, backend::shared_state& shared, const me
     pp->vec_ci_ = shared.cv_to_cell.data();
     pp->vec_di_ = shared.cv_to_intdom.data();
     pp->vec_dt_ = shared.dt_cv.data();
+    pp->dt_uniform_ = &shared.dt_uniform;
 
     pp->vec_v_  = shared.voltage.data();
     pp->vec_i_  = shared.current_density.data();
@@ -100,6 +103,12 @@ void mechanism::instantiate(unsigned id, backend::shared_state& shared, const me
     vec_t_ptr_        = &shared.time;
     event_stream_ptr_ = &shared.deliverable_events;
 
+    // Deliverable events are partitioned by mechanism id, so that each
+    // mechanism visits only its own events.
+    if (!event_stream_ptr_->keyed() || event_stream_ptr_->n_keys()<=id) {
+        *event_stream_ptr_ = deliverable_event_stream(event_stream_ptr_->n_streams(), id+1);
+    }
+
     // If there are no sites (is this ever meaningful?) there is nothing more to do.
     if (width_==0) {
         return;
@@ -125,6 +134,19 @@ void mechanism::instantiate(unsigned id, backend::shared_state& shared, const me
     }
     pp->weight_ = data_.data();
 
+    auto float_fields = float_field_table();
+    std::size_t n_float_field = float_fields.size();
+
+    float_data_ = padded_vector<float>(n_float_field*width_padded_, NAN, util::padded_allocator<float>(shared.alignment));
+    for (std::size_t i = 0; i<n_float_field; ++i) {
+        float*& field_ptr = *(float_fields[i].second);
+        field_ptr = float_data_.data()+i*width_padded_;
+        if (auto opt_value = value_by_key(field_default_table(), float_fields[i].first)) {
+            std::fill(field_ptr, field_ptr+width_padded_, *opt_value);
+        }
+    }
+    mirrors_.clear();
+
     // Allocate and copy local state: weight, node indices, ion indices.
     // The tail comprises those elements between width_ and width_padded_:
     //
@@ -175,10 +197,24 @@ void mechanism::instantiate(unsigned id, backend::shared_state& shared, const me
             append_chunk(pos_data.multiplicity, pp->multiplicity_, 0);
         }
     }
+
+    update_uniform_fields();
 }
 
 void mechanism::set_parameter(const std::string& key, const std::vector<fvm_value_type>& values) {
-    if (auto opt_ptr = value_by_key(field_table(), key)) {
+    if (auto opt_ptr = value_by_key(float_field_table(), key)) {
+        if (values.size()!=width_) {
+            throw arbor_internal_error("multicore/mechanism: mechanism parameter size mismatch");
+        }
+
+        if (width_>0) {
+            float* field_ptr = *opt_ptr.value();
+            util::range<float*> field(field_ptr, field_ptr+width_padded_);
+
+            copy_extend(values, field, values.back());
+        }
+    }
+    else if (auto opt_ptr = value_by_key(field_table(), key)) {
         if (values.size()!=width_) {
             throw arbor_internal_error("multicore/mechanism: mechanism parameter size mismatch");
         }
@@ -190,12 +226,26 @@ void mechanism::set_parameter(const std::string& key, const std::vector<fvm_valu
 
             copy_extend(values, field, values.back());
         }
+        update_uniform_fields();
     }
     else {
         throw arbor_internal_error("multicore/mechanism: no such mechanism parameter");
     }
 }
 
+// Point the uniform parameter pointers at the first value of each parameter
+// that is the same for all instances. NaN values, which are never equal, are
+// left to the per-instance path.
+
+void mechanism::update_uniform_fields() {
+    for (auto& [key, uniform]: uniform_field_table()) {
+        const fvm_value_type* field_ptr = *value_by_key(field_table(), key).value();
+        bool is_uniform = width_>0 &&
+            std::all_of(field_ptr, field_ptr+width_, [first = field_ptr[0]](auto x) { return x==first; });
+        *uniform = is_uniform? field_ptr: nullptr;
+    }
+}
+
 void mechanism::initialize() {
     auto pp_ptr = ppack_ptr();
     pp_ptr->vec_t_ = vec_t_ptr_->data();
@@ -209,7 +259,170 @@ void mechanism::initialize() {
                 (*state.second)[j] *= pp_ptr->multiplicity_[j];
             }
         }
+        for (auto& state: float_field_table()) {
+            for (std::size_t j = 0; j < width_; ++j) {
+                (*state.second)[j] *= pp_ptr->multiplicity_[j];
+            }
+        }
+    }
+
+    update_mirrors();
+}
+
+void mechanism::deliver_events() {
+    apply_events(event_stream_ptr_->marked_events(mechanism_id_));
+    update_mirrors();
+}
+
+void mechanism::update_state() {
+    concrete_mechanism::update_state();
+    update_mirrors();
+}
+
+// Copy the currently selected instances of each mirrored field.
+void mechanism::update_mirrors() {
+    auto n = ppack_ptr()->width_;
+    for (auto& m: mirrors_) {
+        const float* p = *m.field;
+        std::copy(p, p+n, m.data.begin()+(p-m.base));
+    }
+}
+
+std::size_t mechanism::memory() const {
+    std::size_t s = concrete_mechanism::memory();
+    s += sizeof(float_data_[0])*float_data_.size();
+    for (auto& m: mirrors_) {
+        s += sizeof(m.data[0])*m.data.size();
     }
+    return s;
+}
+
+void mechanism::write_checkpoint(checkpoint_writer& w) const {
+    w.write_seq(data_);
+    w.write_seq(float_data_);
+}
+
+void mechanism::read_checkpoint(checkpoint_reader& r) {
+    r.read_seq(data_);
+    r.read_seq(float_data_);
+    update_mirrors();
+    update_uniform_fields();
+}
+
+constraint_histogram mechanism::index_constraint_histogram() {
+    auto pp = (arb::multicore::mechanism_ppack*) ppack_ptr();
+    return make_constraint_histogram(pp->index_constraints_);
+}
+
+// Kernels index all per-instance data relative to the parameter pack pointers
+// over [0, width_), so that a tile or block of instances [b, e) is selected by
+// offsetting those pointers by b. SIMD kernels instead iterate over the index
+// constraint partition, which is only made relative to blocks: tiles are only
+// supported for scalar kernels.
+
+void mechanism::record_instance_bases() {
+    instance_fields_.clear();
+    instance_float_fields_.clear();
+    instance_indices_.clear();
+
+    auto pp = ppack_ptr();
+    for (auto& field: field_table()) {
+        instance_fields_.push_back({field.second, *field.second});
+    }
+    for (auto& field: float_field_table()) {
+        instance_float_fields_.push_back({field.second, *field.second});
+    }
+    for (auto& index: ion_index_table()) {
+        instance_indices_.push_back({index.second, *index.second});
+    }
+    node_index_base_ = pp->node_index_;
+    weight_base_ = pp->weight_;
+    multiplicity_base_ = pp->multiplicity_;
+}
+
+bool mechanism::set_tiles(const std::vector<fvm_index_type>& tile_cv_divs) {
+    tile_divs_.clear();
+
+    if (simd_width()!=1) return false;
+
+    auto pp = ppack_ptr();
+    if (!make_tile_divs(tile_divs_, pp->node_index_, width_, tile_cv_divs)) return false;
+
+    record_instance_bases();
+    return true;
+}
+
+void mechanism::select_tile(fvm_size_type tile) {
+    select_instances(tile_divs_[tile], tile_divs_[tile+1]);
+}
+
+fvm_size_type mechanism::set_blocks(fvm_size_type block_size) {
+    block_divs_.clear();
+    block_constraints_.clear();
+    selected_block_.reset();
+    if (!width_ || !block_size) return 0;
+
+    block_size = math::round_up(block_size, simd_width());
+    for (fvm_size_type b = 0; b<width_; b += block_size) {
+        block_divs_.push_back(b);
+    }
+    block_divs_.push_back(width_);
+    auto n_block = block_divs_.size()-1;
+
+    if (simd_width()>1) {
+        auto pp = (arb::multicore::mechanism_ppack*) ppack_ptr();
+        block_constraints_.resize(n_block);
+
+        auto split = [&](const iarray& chunks, iarray constraint_partition::* part) {
+            for (auto i: chunks) {
+                auto block = i/block_size;
+                (block_constraints_[block].*part).push_back(i-block_divs_[block]);
+            }
+        };
+        split(pp->index_constraints_.contiguous, &constraint_partition::contiguous);
+        split(pp->index_constraints_.constant, &constraint_partition::constant);
+        split(pp->index_constraints_.independent, &constraint_partition::independent);
+        split(pp->index_constraints_.none, &constraint_partition::none);
+    }
+
+    record_instance_bases();
+    return n_block;
+}
+
+void mechanism::select_block(fvm_size_type block) {
+    auto pp = (arb::multicore::mechanism_ppack*) ppack_ptr();
+    if (selected_block_) {
+        std::swap(pp->index_constraints_, block_constraints_[*selected_block_]);
+        selected_block_.reset();
+    }
+
+    select_instances(block_divs_[block], block_divs_[block+1]);
+    if (!block_constraints_.empty()) {
+        std::swap(pp->index_constraints_, block_constraints_[block]);
+        selected_block_ = block;
+    }
+}
+
+void mechanism::select_all() {
+    if (selected_block_) {
+        auto pp = (arb::multicore::mechanism_ppack*) ppack_ptr();
+        std::swap(pp->index_constraints_, block_constraints_[*selected_block_]);
+        selected_block_.reset();
+    }
+    select_instances(0, width_);
+}
+
+void mechanism::select_instances(fvm_size_type begin, fvm_size_type end) {
+    if (!node_index_base_) return;
+
+    auto pp = ppack_ptr();
+    for (auto& [ptr, base]: instance_fields_) *ptr = base+begin;
+    for (auto& [ptr, base]: instance_float_fields_) *ptr = base+begin;
+    for (auto& [ptr, base]: instance_indices_) *ptr = base+begin;
+    pp->node_index_ = node_index_base_+begin;
+    pp->weight_ = weight_base_+begin;
+    if (mult_in_place_) pp->multiplicity_ = multiplicity_base_+begin;
+    pp->width_ = end-begin;
 }
 
 fvm_value_type* mechanism::field_data(const std::string& field_var) {
@@ -217,6 +430,17 @@ fvm_value_type* mechanism::field_data(const std::string& field_var) {
         return *opt_ptr.value();
     }
 
+    if (auto opt_ptr = value_by_key(float_field_table(), field_var)) {
+        float** field = opt_ptr.value();
+        auto i = std::find_if(mirrors_.begin(), mirrors_.end(), [field](auto& m) { return m.field==field; });
+        if (i==mirrors_.end()) {
+            mirrors_.push_back({field, *field, array(width_padded_, NAN, data_.get_allocator())});
+            i = std::prev(mirrors_.end());
+            std::copy(*field, *field+width_, i->data.begin());
+        }
+        return i->data.data();
+    }
+
     return nullptr;
 }
 
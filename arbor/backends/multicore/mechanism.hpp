@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -17,11 +18,16 @@
 #include "backends/multicore/partition_by_constraint.hpp"
 
 namespace arb {
+
+class checkpoint_writer;
+class checkpoint_reader;
+
 namespace multicore {
 
 // Parameter pack extended for multicore.
 struct mechanism_ppack: arb::mechanism_ppack {
     constraint_partition index_constraints_;    // Per-mechanism index and weight data, excepting ion indices.
+    const fvm_value_type* dt_uniform_;          // Points to shared_state::dt_uniform.
 };
 
 // Base class for all generated mechanisms for multicore back-end.
@@ -31,10 +37,89 @@ public:
     void initialize() override;
     void set_parameter(const std::string& key, const std::vector<fvm_value_type>& values) override;
     fvm_value_type* field_data(const std::string& state_var) override;
+    void deliver_events() override;
+    void update_state() override;
+    std::size_t memory() const override;
 
-protected:
+    // Tiled time stepping: partition instances by the tiles with CV divisions
+    // `tile_cv_divs`, returning false if kernels can not be restricted to the
+    // instances of a tile. `select_tile` restricts subsequent kernel calls to
+    // one tile; `select_all` restores the full instance range, and must be in
+    // effect for event delivery.
+    bool set_tiles(const std::vector<fvm_index_type>& tile_cv_divs);
+    void select_tile(fvm_size_type tile);
+    void select_all();
+
+    // Blocked execution of fused density mechanisms: partition instances into
+    // blocks of `block_size` instances, rounded up to a multiple of the SIMD
+    // width, returning the number of blocks. `select_block` restricts
+    // subsequent kernel calls to one block, until `select_all`.
+    fvm_size_type set_blocks(fvm_size_type block_size);
+    void select_block(fvm_size_type block);
+
+    // Write or restore the per-instance parameter and state data.
+    void write_checkpoint(checkpoint_writer&) const;
+    void read_checkpoint(checkpoint_reader&);
+
+    // SIMD width of the kernels, and the number of chunks of instances of that
+    // width in each class of node index constraint.
     virtual unsigned simd_width() const { return 1; }
+    constraint_histogram index_constraint_histogram();
+
+protected:
     fvm_size_type width_padded_ = 0;            // Width rounded up to multiple of pad/alignment.
+
+    // State variables stored in single precision, generated by modcc with
+    // --single-precision-state. Kernels compute in fvm_value_type and round
+    // on store.
+    using float_field_table_entry = std::pair<const char*, float**>;
+    using mechanism_float_field_table = std::vector<float_field_table_entry>;
+
+    virtual mechanism_float_field_table float_field_table() { return {}; }
+
+    // RANGE parameters that kernels read as scalars when the parameter has the
+    // same value for all instances: the parameter pack pointer is set to the
+    // common value, or to null if the values differ.
+    using uniform_field_table_entry = std::pair<const char*, const fvm_value_type**>;
+    using mechanism_uniform_field_table = std::vector<uniform_field_table_entry>;
+
+    virtual mechanism_uniform_field_table uniform_field_table() { return {}; }
+
+private:
+    void record_instance_bases();
+    void select_instances(fvm_size_type begin, fvm_size_type end);
+    void update_uniform_fields();
+    void update_mirrors();
+
+    padded_vector<float> float_data_;
+
+    // Copies in fvm_value_type of single precision fields that have been
+    // requested by field_data(), for probes. These are updated after
+    // initialization, event delivery and state update.
+    struct mirror {
+        float** field;     // Parameter pack pointer to field.
+        const float* base; // Field data for the full instance range.
+        array data;
+    };
+    std::vector<mirror> mirrors_;
+
+    // Per-instance pointers in the parameter pack and their values for the
+    // full instance range, for restricting kernels to a tile or block.
+    std::vector<std::pair<fvm_value_type**, fvm_value_type*>> instance_fields_;
+    std::vector<std::pair<float**, float*>> instance_float_fields_;
+    std::vector<std::pair<fvm_index_type**, fvm_index_type*>> instance_indices_;
+    const fvm_index_type* node_index_base_ = nullptr;
+    const fvm_value_type* weight_base_ = nullptr;
+    const fvm_index_type* multiplicity_base_ = nullptr;
+    std::vector<fvm_index_type> tile_divs_;
+
+    // Instance divisions by block, and for SIMD kernels the index constraints
+    // of each block relative to its first instance. The constraints of the
+    // selected block are swapped with those of the full range in the
+    // parameter pack.
+    std::vector<fvm_size_type> block_divs_;
+    std::vector<constraint_partition> block_constraints_;
+    std::optional<fvm_size_type> selected_block_;
 };
 
 } // namespace multicore
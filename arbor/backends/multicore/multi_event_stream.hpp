@@ -1,6 +1,15 @@
 #pragma once
 
 // Indexed collection of pop-only event queues --- multicore back-end implementation.
+//
+// The events of each stream may be further partitioned by key (see
+// `event_key`) if the stream is constructed with a number of keys, so that
+// events with different keys, such as deliverable events for different
+// mechanisms, can be processed separately. The queue
+// for key k and stream i is addressed by k*n_streams()+i. Events with a key
+// outside [0, n_keys()) are kept in a trailing set of queues: they bound the
+// integration step times like any other event, but are never marked for
+// delivery by `marked_events`.
 
 #include <limits>
 #include <ostream>
@@ -16,6 +25,7 @@
 #include "util/range.hpp"
 #include "util/rangeutil.hpp"
 #include "util/strprintf.hpp"
+#include "util/transform.hpp"
 
 namespace arb {
 namespace multicore {
@@ -36,9 +46,19 @@ public:
     multi_event_stream() {}
 
     explicit multi_event_stream(size_type n_stream):
+       n_stream_(n_stream),
        span_begin_(n_stream), span_end_(n_stream), mark_(n_stream) {}
 
-    size_type n_streams() const { return span_begin_.size(); }
+    multi_event_stream(size_type n_stream, size_type n_key):
+       n_stream_(n_stream), n_key_(n_key), keyed_(true),
+       span_begin_(n_stream*(n_key+1)), span_end_(n_stream*(n_key+1)), mark_(n_stream*(n_key+1)),
+       key_divs_(n_key+2) {}
+
+    size_type n_streams() const { return n_stream_; }
+
+    size_type n_keys() const { return n_key_; }
+
+    bool keyed() const { return keyed_; }
 
     bool empty() const { return remaining_==0; }
 
@@ -52,10 +72,11 @@ public:
     }
 
     // Initialize event streams from a vector of events, sorted by time.
-    void init(std::vector<Event> staged) {
+    void init(const std::vector<Event>& staged) {
         using ::arb::event_time;
         using ::arb::event_index;
         using ::arb::event_data;
+        using ::arb::event_key;
 
         if (staged.size()>std::numeric_limits<size_type>::max()) {
             throw arbor_internal_error("multicore/multi_event_stream: too many events for size type");
@@ -65,18 +86,52 @@ public:
         arb_assert(util::is_sorted_by(staged, [](const Event& ev) { return event_index(ev); }));
 
         std::size_t n_ev = staged.size();
-        util::assign_by(ev_data_, staged, [](const Event& ev) { return event_data(ev); });
-        util::assign_by(ev_time_, staged, [](const Event& ev) { return event_time(ev); });
 
-        // Determine divisions by `event_index` in ev list.
-        arb_assert(n_streams() == span_begin_.size());
-        arb_assert(n_streams() == span_end_.size());
-        arb_assert(n_streams() == mark_.size());
+        // Order events by key with a counting sort, which is stable, so that
+        // the events of each key remain sorted by index.
+        auto bucket_of = [this](const Event& ev) -> size_type {
+            if (!keyed_) return 0;
+            auto k = event_key(ev);
+            return k<n_key_? k: n_key_;
+        };
+
+        util::fill(key_divs_, 0);
+        for (const auto& ev: staged) {
+            ++key_divs_[bucket_of(ev)+1];
+        }
+        for (size_type k = 1; k<key_divs_.size(); ++k) {
+            key_divs_[k] += key_divs_[k-1];
+        }
+
+        order_.resize(n_ev);
+        if (key_divs_[1]==n_ev) {
+            for (std::size_t i = 0; i<n_ev; ++i) {
+                order_[i] = i;
+            }
+        }
+        else {
+            for (std::size_t i = 0; i<n_ev; ++i) {
+                order_[key_divs_[bucket_of(staged[i])]++] = i;
+            }
+        }
+
+        auto ordered = util::transform_view(order_, [&staged](index_type i) -> const Event& { return staged[i]; });
+        util::assign_by(ev_data_, ordered, [](const Event& ev) { return event_data(ev); });
+        util::assign_by(ev_time_, ordered, [](const Event& ev) { return event_time(ev); });
+
+        auto queue_of = [this, &bucket_of](const Event& ev) -> size_type {
+            return bucket_of(ev)*n_stream_ + event_index(ev);
+        };
+
+        // Determine divisions by key and `event_index` in ev list.
+        arb_assert(n_queues() == span_begin_.size());
+        arb_assert(n_queues() == span_end_.size());
+        arb_assert(n_queues() == mark_.size());
 
         index_type ev_begin_i = 0;
         index_type ev_i = 0;
-        for (size_type s = 0; s<n_streams(); ++s) {
-            while ((size_type)ev_i<n_ev && (size_type)(event_index(staged[ev_i]))<s+1) ++ev_i;
+        for (size_type s = 0; s<n_queues(); ++s) {
+            while ((size_type)ev_i<n_ev && queue_of(ordered[ev_i])<s+1) ++ev_i;
 
             // Within a subrange of events with the same index, events should
             // be sorted by time.
@@ -98,16 +153,16 @@ public:
 
         arb_assert(n_streams()==std::size(t_until));
 
-        // note: operation on each `i` is independent.
-        for (size_type i = 0; i<n_streams(); ++i) {
-            auto end = span_end_[i];
-            auto t = t_until[i];
+        // note: operation on each `s` is independent.
+        for (size_type s = 0; s<n_queues(); ++s) {
+            auto end = span_end_[s];
+            auto t = t_until[s%n_stream_];
 
-            auto mark = span_begin_[i];
+            auto mark = span_begin_[s];
             while (mark!=end && !(ev_time_[mark]>t)) {
                 ++mark;
             }
-            mark_[i] = mark;
+            mark_[s] = mark;
         }
     }
 
@@ -119,31 +174,33 @@ public:
 
         arb_assert(n_streams()==std::size(t_until));
 
-        // note: operation on each `i` is independent.
-        for (size_type i = 0; i<n_streams(); ++i) {
-            auto end = span_end_[i];
-            auto t = t_until[i];
+        // note: operation on each `s` is independent.
+        for (size_type s = 0; s<n_queues(); ++s) {
+            auto end = span_end_[s];
+            auto t = t_until[s%n_stream_];
 
-            auto mark = span_begin_[i];
+            auto mark = span_begin_[s];
             while (mark!=end && t>ev_time_[mark]) {
                 ++mark;
             }
-            mark_[i] = mark;
+            mark_[s] = mark;
         }
     }
 
     // Remove marked events from front of each event stream.
     void drop_marked_events() {
-        // note: operation on each `i` is independent.
-        for (size_type i = 0; i<n_streams(); ++i) {
-            remaining_ -= (mark_[i]-span_begin_[i]);
-            span_begin_[i] = mark_[i];
+        // note: operation on each `s` is independent.
+        for (size_type s = 0; s<n_queues(); ++s) {
+            remaining_ -= (mark_[s]-span_begin_[s]);
+            span_begin_[s] = mark_[s];
         }
     }
 
-    // Interface for access to marked events by mechanisms/kernels:
-    state marked_events() const {
-        return {n_streams(), ev_data_.data(), span_begin_.data(), mark_.data()};
+    // Interface for access to marked events with key `key` by mechanisms/kernels:
+    state marked_events(size_type key = 0) const {
+        arb_assert(key<n_key_);
+        auto offset = key*n_stream_;
+        return {n_streams(), ev_data_.data(), span_begin_.data()+offset, mark_.data()+offset};
     }
 
     // If the head of `i`th event stream exists and has time less than `t_until[i]`, set
@@ -152,22 +209,23 @@ public:
     void event_time_if_before(TimeSeq& t_until) {
         using ::arb::event_time;
 
-        // note: operation on each `i` is independent.
-        for (size_type i = 0; i<n_streams(); ++i) {
-            if (span_begin_[i]==span_end_[i]) {
+        // note: queues with different keys may update the same `t_until[i]`.
+        for (size_type s = 0; s<n_queues(); ++s) {
+            if (span_begin_[s]==span_end_[s]) {
                continue;
             }
 
-            auto ev_t = ev_time_[span_begin_[i]];
-            if (t_until[i]>ev_t) {
-                t_until[i] = ev_t;
+            auto ev_t = ev_time_[span_begin_[s]];
+            auto& t = t_until[s%n_stream_];
+            if (t>ev_t) {
+                t = ev_t;
             }
         }
     }
 
     friend std::ostream& operator<<(std::ostream& out, const multi_event_stream<Event>& m) {
         auto n_ev = m.ev_data_.size();
-        auto n = m.n_streams();
+        auto n = m.n_queues();
 
         out << "\n[";
         unsigned i = 0;
@@ -196,12 +254,21 @@ public:
     }
 
 private:
+    size_type n_stream_ = 0;
+    size_type n_key_ = 1;
+    bool keyed_ = false;
     std::vector<event_time_type> ev_time_;
     std::vector<index_type> span_begin_;
     std::vector<index_type> span_end_;
     std::vector<index_type> mark_;
     std::vector<event_data_type> ev_data_;
     size_type remaining_ = 0;
+
+    // Scratch space for ordering staged events by key.
+    std::vector<size_type> key_divs_ = std::vector<size_type>(2);
+    std::vector<index_type> order_;
+
+    size_type n_queues() const { return n_stream_*(keyed_? n_key_+1: 1); }
 };
 
 } // namespace multicore
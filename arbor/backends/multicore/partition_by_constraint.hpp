@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <ostream>
 #include <vector>
 
 #include <arbor/simd/simd.hpp>
@@ -19,6 +21,23 @@ struct constraint_partition {
     iarray none;
 };
 
+// Number of SIMD chunks in each class of a constraint partition.
+struct constraint_histogram {
+    std::size_t contiguous = 0;
+    std::size_t constant = 0;
+    std::size_t independent = 0;
+    std::size_t none = 0;
+};
+
+inline constraint_histogram make_constraint_histogram(const constraint_partition& part) {
+    return {part.contiguous.size(), part.constant.size(), part.independent.size(), part.none.size()};
+}
+
+inline std::ostream& operator<<(std::ostream& o, const constraint_histogram& h) {
+    return o << "contiguous " << h.contiguous << ", constant " << h.constant
+             << ", independent " << h.independent << ", none " << h.none;
+}
+
 template <typename It>
 bool is_contiguous_n(It first, unsigned width) {
     while (--width) {
@@ -71,6 +90,24 @@ index_constraint idx_constraint(It it, unsigned simd_width) {
     }
 }
 
+// Constraint on the instance indices of `simd_width` events for vectorised
+// event delivery. Unlike node indices, these are not sorted, so the indices
+// are only independent if all are distinct; repeated indices give `none`.
+template <typename It>
+index_constraint event_index_constraint(It first, unsigned simd_width) {
+    if (is_contiguous_n(first, simd_width)) {
+        return index_constraint::contiguous;
+    }
+    for (unsigned i = 1; i<simd_width; ++i) {
+        for (unsigned j = 0; j<i; ++j) {
+            if (first[i]==first[j]) {
+                return index_constraint::none;
+            }
+        }
+    }
+    return index_constraint::independent;
+}
+
 template <typename T>
 constraint_partition make_constraint_partition(const T& node_index, unsigned width, unsigned simd_width) {
 
@@ -15,14 +15,19 @@
 #include <arbor/simd/simd.hpp>
 
 #include "backends/event.hpp"
+#include "checkpoint.hpp"
 #include "io/sepval.hpp"
 #include "util/index_into.hpp"
+#include "util/maputil.hpp"
 #include "util/padded_alloc.hpp"
 #include "util/rangeutil.hpp"
+#include "util/span.hpp"
+#include "util/transform.hpp"
 
 #include "multi_event_stream.hpp"
 #include "multicore_common.hpp"
 #include "shared_state.hpp"
+#include "tiles.hpp"
 
 namespace arb {
 namespace multicore {
@@ -45,6 +50,12 @@ inline unsigned min_alignment(unsigned align) {
 
 using pad = util::padded_allocator<>;
 
+// True if all elements of the non-empty sequence are equal.
+template <typename Seq>
+bool is_uniform(const Seq& seq) {
+    return std::all_of(seq.begin(), seq.end(), [x = seq.front()](auto y) { return y==x; });
+}
+
 // ion_state methods:
 
 ion_state::ion_state(
@@ -76,10 +87,20 @@ void ion_state::init_concentration() {
     std::copy(init_Xo_.begin(), init_Xo_.end(), Xo_.begin());
 }
 
+void ion_state::init_concentration(fvm_size_type tile) {
+    auto b = tile_divs_[tile], e = tile_divs_[tile+1];
+    std::copy(init_Xi_.begin()+b, init_Xi_.begin()+e, Xi_.begin()+b);
+    std::copy(init_Xo_.begin()+b, init_Xo_.begin()+e, Xo_.begin()+b);
+}
+
 void ion_state::zero_current() {
     util::fill(iX_, 0);
 }
 
+void ion_state::zero_current(fvm_size_type tile) {
+    std::fill(iX_.begin()+tile_divs_[tile], iX_.begin()+tile_divs_[tile+1], 0);
+}
+
 void ion_state::reset() {
     zero_current();
     std::copy(reset_Xi_.begin(), reset_Xi_.end(), Xi_.begin());
@@ -127,10 +148,20 @@ istim_state::istim_state(const fvm_stimulus_config& stim, unsigned align):
     envl_index_.assign(edivs.data(), edivs.data()+n);
 }
 
+bool istim_state::set_tiles(const std::vector<fvm_index_type>& tile_cv_divs) {
+    return make_tile_divs(accu_tile_divs_, accu_to_cv_, accu_to_cv_.size(), tile_cv_divs) &&
+           make_tile_divs(tile_divs_, util::transform_view(accu_index_, [this](auto i) { return accu_to_cv_[i]; }),
+                          accu_index_.size(), tile_cv_divs);
+}
+
 void istim_state::zero_current() {
     util::fill(accu_stim_, 0);
 }
 
+void istim_state::zero_current(fvm_size_type tile) {
+    std::fill(accu_stim_.begin()+accu_tile_divs_[tile], accu_stim_.begin()+accu_tile_divs_[tile+1], 0);
+}
+
 void istim_state::reset() {
     zero_current();
 
@@ -139,10 +170,18 @@ void istim_state::reset() {
 }
 
 void istim_state::add_current(const array& time, const iarray& cv_to_intdom, array& current_density) {
+    add_current(time, cv_to_intdom, current_density, 0, accu_index_.size());
+}
+
+void istim_state::add_current(const array& time, const iarray& cv_to_intdom, array& current_density, fvm_size_type tile) {
+    add_current(time, cv_to_intdom, current_density, tile_divs_[tile], tile_divs_[tile+1]);
+}
+
+void istim_state::add_current(const array& time, const iarray& cv_to_intdom, array& current_density, fvm_index_type begin, fvm_index_type end) {
     constexpr double two_pi = 2*math::pi<double>;
 
     // Consider vectorizing...
-    for (auto i: util::count_along(accu_index_)) {
+    for (auto i: util::make_span(begin, end)) {
         // Advance index into envelope until either
         // - the next envelope time is greater than simulation time, or
         // - it is the last valid index for the envelope.
@@ -256,6 +295,14 @@ void shared_state::reset() {
     util::fill(time, 0);
     util::fill(time_to, 0);
     util::fill(time_since_spike, -1.0);
+    dt_uniform = -1;
+
+    if (adaptive_dt()) {
+        util::fill(dt_next, adaptive_dt_min);
+        util::fill(dt_prev, 0);
+        util::fill(dt_error, 0);
+        util::fill(dv_prev, 0);
+    }
 
     for (auto& i: ion_data) {
         i.second.reset();
@@ -264,6 +311,82 @@ void shared_state::reset() {
     stim_data.reset();
 }
 
+void shared_state::write_checkpoint(checkpoint_writer& w) const {
+    w.write_seq(time);
+    w.write_seq(time_to);
+    w.write_seq(dt_intdom);
+    w.write_seq(dt_cv);
+    w.write(dt_uniform);
+    w.write_seq(voltage);
+    w.write_seq(time_since_spike);
+
+    w.write<std::uint64_t>(ion_data.size());
+    for (auto& [name, ion]: ion_data) {
+        w.write(name);
+        w.write_seq(ion.iX_);
+        w.write_seq(ion.eX_);
+        w.write_seq(ion.Xi_);
+        w.write_seq(ion.Xo_);
+    }
+
+    w.write_seq(stim_data.accu_stim_);
+    w.write_seq(stim_data.envl_index_);
+
+    w.write_seq(dt_next);
+    w.write_seq(dt_prev);
+    w.write_seq(dt_error);
+    w.write_seq(dv_prev);
+}
+
+void shared_state::read_checkpoint(checkpoint_reader& r) {
+    r.read_seq(time);
+    r.read_seq(time_to);
+    r.read_seq(dt_intdom);
+    r.read_seq(dt_cv);
+    r.read(dt_uniform);
+    r.read_seq(voltage);
+    r.read_seq(time_since_spike);
+
+    if (r.read<std::uint64_t>()!=ion_data.size()) {
+        throw bad_checkpoint("ion count mismatch");
+    }
+    for (auto i = ion_data.size(); i>0; --i) {
+        auto name = r.read<std::string>();
+        auto ion = util::ptr_by_key(ion_data, name);
+        if (!ion) throw bad_checkpoint("no such ion '"+name+"'");
+
+        r.read_seq(ion->iX_);
+        r.read_seq(ion->eX_);
+        r.read_seq(ion->Xi_);
+        r.read_seq(ion->Xo_);
+    }
+
+    r.read_seq(stim_data.accu_stim_);
+    r.read_seq(stim_data.envl_index_);
+
+    r.read_seq(dt_next);
+    r.read_seq(dt_prev);
+    r.read_seq(dt_error);
+    r.read_seq(dv_prev);
+}
+
+bool shared_state::configure_tiles(const std::vector<fvm_index_type>& cv_divs, const std::vector<fvm_index_type>& intdom_divs) {
+    tile_cv_divs = cv_divs;
+    tile_intdom_divs = intdom_divs;
+
+    bool ok = stim_data.set_tiles(tile_cv_divs);
+    for (auto& i: ion_data) {
+        ion_state& ion = i.second;
+        ok = ok && make_tile_divs(ion.tile_divs_, ion.node_index_, ion.node_index_.size(), tile_cv_divs);
+    }
+
+    if (!ok) {
+        tile_cv_divs.clear();
+        tile_intdom_divs.clear();
+    }
+    return ok;
+}
+
 void shared_state::zero_currents() {
     util::fill(current_density, 0);
     util::fill(conductivity, 0);
@@ -273,17 +396,144 @@ void shared_state::zero_currents() {
     stim_data.zero_current();
 }
 
+void shared_state::zero_currents(fvm_size_type tile) {
+    auto b = tile_cv_divs[tile], e = tile_cv_divs[tile+1];
+    std::fill(current_density.begin()+b, current_density.begin()+e, 0);
+    std::fill(conductivity.begin()+b, conductivity.begin()+e, 0);
+    for (auto& i: ion_data) {
+        i.second.zero_current(tile);
+    }
+    stim_data.zero_current(tile);
+}
+
 void shared_state::ions_init_concentration() {
     for (auto& i: ion_data) {
         i.second.init_concentration();
     }
 }
 
+void shared_state::ions_init_concentration(fvm_size_type tile) {
+    for (auto& i: ion_data) {
+        i.second.init_concentration(tile);
+    }
+}
+
+void shared_state::configure_adaptive_dt(fvm_value_type tolerance, fvm_value_type dt_min) {
+    if (tolerance<=0) {
+        adaptive_dt_tolerance = 0;
+        dt_next = dt_prev = dt_error = voltage_prev = dv_prev = array();
+        return;
+    }
+
+    adaptive_dt_tolerance = tolerance;
+    adaptive_dt_min = dt_min;
+    dt_next = array(n_intdom, adaptive_dt_min, pad(alignment));
+    dt_prev = array(n_intdom, 0, pad(alignment));
+    dt_error = array(n_intdom, 0, pad(alignment));
+    voltage_prev = array(n_cv, 0, pad(alignment));
+    dv_prev = array(n_cv, 0, pad(alignment));
+}
+
+void shared_state::configure_implicit_gj(fvm_value_type tolerance, unsigned max_iterations) {
+    if (!max_iterations || !n_gj) {
+        gj_max_iterations = 0;
+        gj_voltage = gj_voltage_next = array();
+        return;
+    }
+
+    gj_tolerance = tolerance;
+    gj_max_iterations = max_iterations;
+    gj_voltage = array(n_cv, 0, pad(alignment));
+    gj_voltage_next = array(n_cv, 0, pad(alignment));
+}
+
+void shared_state::gj_implicit_begin() {
+    for (unsigned i = 0; i < n_gj; i++) {
+        auto gj = gap_junctions[i];
+        conductivity[gj.loc.first] += gj.weight;
+    }
+    std::copy(voltage.begin(), voltage.begin()+n_cv, gj_voltage.begin());
+}
+
+fvm_value_type shared_state::gj_implicit_update() {
+    fvm_value_type delta = 0;
+    for (unsigned i = 0; i < n_gj; i++) {
+        auto gj = gap_junctions[i];
+        auto dv = gj_voltage_next[gj.loc.second] - gj_voltage[gj.loc.second];
+
+        current_density[gj.loc.first] -= gj.weight*dv;
+        delta = std::max(delta, std::abs(dv));
+    }
+    std::swap(gj_voltage, gj_voltage_next);
+    return delta;
+}
+
+void shared_state::gj_implicit_end() {
+    std::copy(gj_voltage.begin(), gj_voltage.begin()+n_cv, voltage.begin());
+}
+
+void shared_state::adaptive_dt_begin() {
+    std::copy(voltage.begin(), voltage.begin()+n_cv, voltage_prev.begin());
+}
+
+// The voltage change over a step is compared with that extrapolated linearly
+// from the previous step; for steps dt and dt_prev the difference is about
+// v''·dt·(dt+dt_prev)/2, or v''·h² for steps of equal length h. The next dt h
+// is chosen such that v''·h², which is proportional to the local error of the
+// implicit Euler step, is within tolerance. As it is derived from the estimate
+// of v'', it does not depend on the length of the last step, so that a step
+// truncated by an event or the end of the integration interval does not reduce
+// the next. Growth and shrinkage are limited relative to the proposed dt.
+// Steps are not rejected: the implicit method is stable for any dt, and the
+// error estimate of a step that was too long shortens the next.
+void shared_state::adaptive_dt_end() {
+    constexpr fvm_value_type safety = 0.9;
+    constexpr fvm_value_type max_shrink = 0.2;
+    constexpr fvm_value_type max_grow = 2;
+
+    util::fill(dt_error, 0);
+    for (fvm_size_type i = 0; i<n_cv; ++i) {
+        auto d = cv_to_intdom[i];
+        auto dv = voltage[i]-voltage_prev[i];
+        if (dt_prev[d]>0) {
+            auto err = std::abs(dv - dv_prev[i]*dt_intdom[d]/dt_prev[d]);
+            dt_error[d] = std::max(dt_error[d], err);
+        }
+        if (dt_intdom[d]>0) {
+            dv_prev[i] = dv;
+        }
+    }
+
+    for (fvm_size_type d = 0; d<n_intdom; ++d) {
+        auto dt = dt_intdom[d];
+        if (dt<=0) continue;
+
+        auto proposed = dt_next[d];
+        auto next = proposed*max_grow;
+        if (dt_prev[d]>0 && dt_error[d]>0) {
+            // Equal to safety·sqrt(tolerance/error)·dt for steps of equal length.
+            next = safety*std::sqrt(adaptive_dt_tolerance*dt*(dt+dt_prev[d])/(2*dt_error[d]));
+            next = std::min(proposed*max_grow, std::max(proposed*max_shrink, next));
+        }
+        dt_next[d] = std::max(adaptive_dt_min, next);
+        dt_prev[d] = dt;
+    }
+}
+
 void shared_state::update_time_to(fvm_value_type dt_step, fvm_value_type tmax) {
     using simd::assign;
     using simd::indirect;
     using simd::add;
     using simd::min;
+
+    if (adaptive_dt()) {
+        for (fvm_size_type i = 0; i<n_intdom; ++i) {
+            dt_next[i] = std::min(dt_next[i], dt_step);
+            time_to[i] = std::min(time[i]+dt_next[i], tmax);
+        }
+        return;
+    }
+
     for (fvm_size_type i = 0; i<n_intdom; i+=simd_width) {
         simd_value_type t;
         assign(t, indirect(time.data()+i, simd_width));
@@ -305,6 +555,15 @@ void shared_state::set_dt() {
         indirect(dt_intdom.data()+j, simd_width) = dt;
     }
 
+    // When all integration domains share the same time and time step, as is
+    // the case for steps not shortened by event delivery, mechanisms read
+    // time and dt as scalars, and the per-CV dt is not needed.
+    dt_uniform = -1;
+    if (n_intdom>0 && is_uniform(time) && is_uniform(time_to)) {
+        dt_uniform = dt_intdom[0];
+        return;
+    }
+
     for (fvm_size_type i = 0; i<n_cv; i+=simd_width) {
         simd_index_type intdom_idx;
         assign(intdom_idx, indirect(cv_to_intdom.data()+i, simd_width));
@@ -315,6 +574,16 @@ void shared_state::set_dt() {
     }
 }
 
+void shared_state::set_dt(fvm_size_type tile) {
+    dt_uniform = -1;
+    for (auto j: util::make_span(tile_intdom_divs[tile], tile_intdom_divs[tile+1])) {
+        dt_intdom[j] = time_to[j]-time[j];
+    }
+    for (auto i: util::make_span(tile_cv_divs[tile], tile_cv_divs[tile+1])) {
+        dt_cv[i] = dt_intdom[cv_to_intdom[i]];
+    }
+}
+
 void shared_state::add_gj_current() {
     for (unsigned i = 0; i < n_gj; i++) {
         auto gj = gap_junctions[i];
@@ -329,6 +598,10 @@ void shared_state::add_stimulus_current() {
      stim_data.add_current(time, cv_to_intdom, current_density);
 }
 
+void shared_state::add_stimulus_current(fvm_size_type tile) {
+    stim_data.add_current(time, cv_to_intdom, current_density, tile);
+}
+
 std::pair<fvm_value_type, fvm_value_type> shared_state::time_bounds() const {
     return util::minmax_value(time);
 }
@@ -355,6 +628,23 @@ void shared_state::take_samples(
     }
 }
 
+void shared_state::take_samples(
+    const sample_event_stream::state& s,
+    fvm_size_type tile,
+    array& sample_time,
+    array& sample_value)
+{
+    for (auto i: util::make_span(tile_intdom_divs[tile], tile_intdom_divs[tile+1])) {
+        auto begin = s.begin_marked(i);
+        auto end = s.end_marked(i);
+
+        for (auto p = begin; p<end; ++p) {
+            sample_time[p->offset] = time[i];
+            sample_value[p->offset] = p->handle? *p->handle: 0;
+        }
+    }
+}
+
 // (Debug interface only.)
 std::ostream& operator<<(std::ostream& out, const shared_state& s) {
     using io::csv;
@@ -24,6 +24,10 @@
 #include "multicore_common.hpp"
 
 namespace arb {
+
+class checkpoint_writer;
+class checkpoint_reader;
+
 namespace multicore {
 
 /*
@@ -55,6 +59,8 @@ struct ion_state {
 
     array charge;           // charge of ionic species (global value, length 1)
 
+    std::vector<fvm_index_type> tile_divs_; // Divisions of instances by tile, if tiled.
+
     ion_state() = default;
 
     ion_state(
@@ -65,9 +71,11 @@ struct ion_state {
 
     // Set ion concentrations to weighted proportion of default concentrations.
     void init_concentration();
+    void init_concentration(fvm_size_type tile);
 
     // Set ionic current density to zero.
     void zero_current();
+    void zero_current(fvm_size_type tile);
 
     // Zero currents, reset concentrations, and reset reversal potential from initial values.
     void reset();
@@ -90,19 +98,32 @@ struct istim_state {
     array accu_stim_;       // (A/m²) accumulated stim current / CV area, one per CV with a stimulus.
     iarray envl_index_;     // Per instance index into envl_ arrays, corresponding to last sample time.
 
+    // Divisions of instances and of accumulators by tile, if tiled.
+    std::vector<fvm_index_type> tile_divs_;
+    std::vector<fvm_index_type> accu_tile_divs_;
+
+    // Partition instances and accumulators by tile; returns false if the
+    // instances of a tile are not contiguous.
+    bool set_tiles(const std::vector<fvm_index_type>& tile_cv_divs);
+
     // Zero stim current.
     void zero_current();
+    void zero_current(fvm_size_type tile);
 
     // Zero stim current, reset indices.
     void reset();
 
     // Contribute to current density:
     void add_current(const array& time, const iarray& cv_to_intdom, array& current_density);
+    void add_current(const array& time, const iarray& cv_to_intdom, array& current_density, fvm_size_type tile);
 
     // Construct state from i_clamp data:
     istim_state(const fvm_stimulus_config& stim_data, unsigned align);
 
     istim_state() = default;
+
+private:
+    void add_current(const array& time, const iarray& cv_to_intdom, array& current_density, fvm_index_type begin, fvm_index_type end);
 };
 
 struct shared_state {
@@ -120,7 +141,8 @@ struct shared_state {
     array time;               // Maps intdom index to integration start time [ms].
     array time_to;            // Maps intdom index to integration stop time [ms].
     array dt_intdom;          // Maps  index to (stop time) - (start time) [ms].
-    array dt_cv;              // Maps CV index to dt [ms].
+    array dt_cv;              // Maps CV index to dt [ms]; not set if dt_uniform>=0.
+    fvm_value_type dt_uniform = -1; // dt of every intdom if time and dt are the same for all, else -1 [ms].
     array voltage;            // Maps CV index to membrane voltage [mV].
     array current_density;    // Maps CV index to membrane current density contributions [A/m²].
     array conductivity;       // Maps CV index to membrane conductivity [kS/m²].
@@ -136,6 +158,28 @@ struct shared_state {
     std::unordered_map<std::string, ion_state> ion_data;
     deliverable_event_stream deliverable_events;
 
+    // Tiled time stepping: divisions of CVs and integration domains by tile.
+    // Empty if not tiled.
+    std::vector<fvm_index_type> tile_cv_divs;
+    std::vector<fvm_index_type> tile_intdom_divs;
+
+    // Adaptive time stepping: tolerance is zero and arrays are empty if not
+    // enabled.
+    fvm_value_type adaptive_dt_tolerance = 0; // Target local voltage error per step [mV].
+    fvm_value_type adaptive_dt_min = 0;       // Minimum dt [ms].
+    array dt_next;            // Maps intdom index to proposed dt of next step [ms].
+    array dt_prev;            // Maps intdom index to dt of previous step [ms], or zero.
+    array dt_error;           // Maps intdom index to estimated error of last step [mV].
+    array voltage_prev;       // Maps CV index to voltage at start of step [mV].
+    array dv_prev;            // Maps CV index to voltage change over previous step [mV].
+
+    // Implicit gap junctions: max iterations is zero and arrays are empty if
+    // not enabled.
+    fvm_value_type gj_tolerance = 0;  // Largest change in voltage at convergence [mV].
+    unsigned gj_max_iterations = 0;   // Maximum number of linear solves per step.
+    array gj_voltage;         // Maps CV index to voltage of current iterate [mV].
+    array gj_voltage_next;    // Maps CV index to voltage of next iterate, as solved [mV].
+
     shared_state() = default;
 
     shared_state(
@@ -159,23 +203,70 @@ struct shared_state {
 
     void configure_stimulus(const fvm_stimulus_config&);
 
+    // Partition state by tiles of whole integration domains; returns false
+    // if the state can not be partitioned, in which case tiling is disabled.
+    bool configure_tiles(const std::vector<fvm_index_type>& cv_divs, const std::vector<fvm_index_type>& intdom_divs);
+
+    fvm_size_type n_tile() const { return tile_cv_divs.empty()? 0: tile_cv_divs.size()-1; }
+
+    // Enable adaptive time stepping with given tolerance [mV] and minimum
+    // dt [ms]; a non-positive tolerance disables it.
+    void configure_adaptive_dt(fvm_value_type tolerance, fvm_value_type dt_min);
+
+    bool adaptive_dt() const { return adaptive_dt_tolerance>0; }
+
+    // Record voltage at the start of a step, and after the step, estimate the
+    // local error and choose dt_next for each integration domain.
+    void adaptive_dt_begin();
+    void adaptive_dt_end();
+
+    // Enable implicit gap junctions, iterating until the voltage at each gap
+    // junction changes by at most tolerance [mV] or for at most max_iterations
+    // solves per step; zero max_iterations disables it.
+    void configure_implicit_gj(fvm_value_type tolerance, unsigned max_iterations);
+
+    bool implicit_gj() const { return gj_max_iterations>0; }
+
+    // Block Jacobi iteration for implicit gap junctions: each iteration solves
+    // the voltage of each cell with the voltage of its gap junction peers held
+    // at the current iterate, that is, with the gap junction conductance added
+    // to the membrane conductivity and the gap junction current evaluated at
+    // the voltage of the peer.
+    //
+    // gj_implicit_begin() adds the conductance to the gap junction current
+    // from add_gj_current() and starts from the voltage at the start of the
+    // step. After each solve into gj_voltage_next, gj_implicit_update()
+    // corrects the current for the new peer voltages, makes the new iterate
+    // current, and returns the largest change in voltage [mV] at a gap
+    // junction. gj_implicit_end() copies the last iterate into voltage.
+    void gj_implicit_begin();
+    fvm_value_type gj_implicit_update();
+    void gj_implicit_end();
+
+    // Methods taking a tile index operate only on the state of that tile.
+
     void zero_currents();
+    void zero_currents(fvm_size_type tile);
 
     void ions_init_concentration();
+    void ions_init_concentration(fvm_size_type tile);
 
     void ions_nernst_reversal_potential(fvm_value_type temperature_K);
 
-    // Set time_to to earliest of time+dt_step and tmax.
+    // Set time_to to earliest of time+dt_step and tmax; with adaptive time
+    // stepping, dt_next is first limited to dt_step.
     void update_time_to(fvm_value_type dt_step, fvm_value_type tmax);
 
     // Set the per-integration domain and per-compartment dt from time_to - time.
     void set_dt();
+    void set_dt(fvm_size_type tile);
 
     // Update gap_junction state
     void add_gj_current();
 
     // Update stimulus state and add current contributions.
     void add_stimulus_current();
+    void add_stimulus_current(fvm_size_type tile);
 
     // Return minimum and maximum time value [ms] across cells.
     std::pair<fvm_value_type, fvm_value_type> time_bounds() const;
@@ -190,7 +281,19 @@ struct shared_state {
         array& sample_time,
         array& sample_value);
 
+    void take_samples(
+        const sample_event_stream::state& s,
+        fvm_size_type tile,
+        array& sample_time,
+        array& sample_value);
+
     void reset();
+
+    // Write or restore the time, voltage, current, ion, stimulus and
+    // adaptive time step state. Constant state, and state that is recomputed
+    // at the start of each step, is not written.
+    void write_checkpoint(checkpoint_writer&) const;
+    void read_checkpoint(checkpoint_reader&);
 };
 
 // For debugging only:
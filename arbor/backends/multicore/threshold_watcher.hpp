@@ -1,18 +1,39 @@
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
 #include <arbor/assert.hpp>
 #include <arbor/fvm_types.hpp>
 #include <arbor/math.hpp>
+#include <arbor/simd/simd.hpp>
 
 #include "backends/threshold_crossing.hpp"
+#include "checkpoint.hpp"
 #include "execution_context.hpp"
 #include "multicore_common.hpp"
+#include "tiles.hpp"
 
 namespace arb {
 namespace multicore {
 
+// Detectors are tested in blocks of the native SIMD width. A detector is in
+// the crossed state if and only if its last tested value is at or above the
+// threshold, so the state is not stored separately, and a crossing is
+// recorded only for the lanes of a block where the value passes upwards
+// through the threshold. Blocks without any such lane are passed over after
+// a single test of the crossing mask.
+//
+// Entries of time_since_spike are only non-negative in the step following a
+// crossing, so instead of clearing every entry on each step, the watcher
+// clears just the entries it set on the previous step.
+
 class threshold_watcher {
 public:
+    static constexpr unsigned simd_width = simd::simd_abi::native_width<fvm_value_type>::value;
+    using simd_value = simd::simd<fvm_value_type, simd_width, simd::simd_abi::default_abi>;
+    using simd_index = simd::simd<fvm_index_type, simd_width, simd::simd_abi::default_abi>;
+
     threshold_watcher() = default;
 
     threshold_watcher(const execution_context& ctx) {}
@@ -34,9 +55,8 @@ public:
         t_after_ptr_(t_after),
         n_cv_(cv_index.size()),
         cv_index_(cv_index),
-        is_crossed_(n_cv_),
         thresholds_(thresholds),
-        v_prev_(values_, values_+n_cv_)
+        v_prev_(n_cv_)
     {
         arb_assert(n_cv_==thresholds.size());
         reset();
@@ -53,8 +73,9 @@ public:
     /// calling, because the values are used to determine the initial state
     void reset() {
         clear_crossings();
+        recorded_.clear();
         for (fvm_size_type i = 0; i<n_cv_; ++i) {
-            is_crossed_[i] = values_[cv_index_[i]]>=thresholds_[i];
+            v_prev_[i] = values_[cv_index_[i]];
         }
     }
 
@@ -66,49 +87,34 @@ public:
     /// Crossing events are recorded for each threshold that
     /// is crossed since the last call to test
     void test(array* time_since_spike) {
-        // Reset all spike times to -1.0 indicating no spike has been recorded on the detector
-        const fvm_value_type* t_before = t_before_ptr_->data();
-        const fvm_value_type* t_after  = t_after_ptr_->data();
-        for (fvm_size_type i = 0; i<n_cv_; ++i) {
-            auto cv     = cv_index_[i];
-            auto intdom = cv_to_intdom_[cv];
-            auto v_prev = v_prev_[i];
-            auto v      = values_[cv];
-            auto thresh = thresholds_[i];
-            fvm_index_type spike_idx = 0;
-
-            if (!time_since_spike->empty()) {
-                spike_idx = src_to_spike_[i];
-                (*time_since_spike)[spike_idx] = -1.0;
-            }
+        test(time_since_spike, 0, n_cv_);
+    }
 
-            if (!is_crossed_[i]) {
-                if (v>=thresh) {
-                    // The threshold has been passed, so estimate the time using
-                    // linear interpolation.
-                    auto pos = (thresh - v_prev)/(v - v_prev);
-                    auto crossing_time = math::lerp(t_before[intdom], t_after[intdom], pos);
-                    crossings_.push_back({i, crossing_time});
+    /// Partition targets by the tiles with CV divisions tile_cv_divs
+    /// for tiled time stepping; returns false if the targets of a tile
+    /// are not contiguous.
+    bool set_tiles(const std::vector<fvm_index_type>& tile_cv_divs) {
+        return make_tile_divs(tile_divs_, cv_index_, n_cv_, tile_cv_divs);
+    }
 
-                    if (!time_since_spike->empty()) {
-                        (*time_since_spike)[spike_idx] = t_after[intdom] - crossing_time;
-                    }
+    /// Test only the targets of one tile.
+    void test(array* time_since_spike, fvm_size_type tile) {
+        test(time_since_spike, tile_divs_[tile], tile_divs_[tile+1]);
+    }
 
-                    is_crossed_[i] = true;
-                }
-            }
-            else {
-                if (v<thresh) {
-                    is_crossed_[i] = false;
-                }
-            }
+    bool is_crossed(fvm_size_type i) const {
+        return v_prev_[i]>=thresholds_[i];
+    }
 
-            v_prev_[i] = v;
-        }
+    /// Write or restore the detector state; crossings are not included.
+    void write_checkpoint(checkpoint_writer& w) const {
+        w.write_seq(v_prev_);
+        w.write_seq(recorded_);
     }
 
-    bool is_crossed(fvm_size_type i) const {
-        return is_crossed_[i];
+    void read_checkpoint(checkpoint_reader& r) {
+        r.read_seq(v_prev_);
+        r.read_vector(recorded_);
     }
 
     /// The number of threshold values that are monitored.
@@ -117,6 +123,64 @@ public:
     }
 
 private:
+    void test(array* time_since_spike, fvm_size_type begin, fvm_size_type end) {
+        const bool record = !time_since_spike->empty();
+
+        // Reset the spike times recorded on the previous step to -1.0,
+        // indicating no spike has been recorded on the detector.
+        if (record && !recorded_.empty()) {
+            auto in_range = [begin, end](fvm_size_type i) { return i>=begin && i<end; };
+            for (auto i: recorded_) {
+                if (in_range(i)) (*time_since_spike)[src_to_spike_[i]] = -1.0;
+            }
+            recorded_.erase(std::remove_if(recorded_.begin(), recorded_.end(), in_range), recorded_.end());
+        }
+
+        fvm_size_type i = begin;
+        for (; i+simd_width<=end; i += simd_width) {
+            simd_value v;
+            simd::assign(v, simd::indirect(values_, simd_index(cv_index_.data()+i), simd_width));
+            simd_value v_prev(v_prev_.data()+i);
+            simd_value thresh(thresholds_.data()+i);
+
+            auto crossed = v_prev<thresh && v>=thresh;
+            v.copy_to(v_prev_.data()+i);
+            if (!crossed.any()) continue;
+
+            bool lane_crossed[simd_width];
+            crossed.copy_to(lane_crossed);
+            for (unsigned lane = 0; lane<simd_width; ++lane) {
+                if (lane_crossed[lane]) {
+                    record_crossing(time_since_spike, record, i+lane, v_prev[lane], v[lane]);
+                }
+            }
+        }
+        for (; i<end; ++i) {
+            auto v_prev = v_prev_[i];
+            auto v = values_[cv_index_[i]];
+            if (v_prev<thresholds_[i] && v>=thresholds_[i]) {
+                record_crossing(time_since_spike, record, i, v_prev, v);
+            }
+            v_prev_[i] = v;
+        }
+    }
+
+    void record_crossing(array* time_since_spike, bool record, fvm_size_type i, fvm_value_type v_prev, fvm_value_type v) {
+        // The threshold has been passed, so estimate the time using
+        // linear interpolation.
+        auto intdom = cv_to_intdom_[cv_index_[i]];
+        auto t_before = (*t_before_ptr_)[intdom];
+        auto t_after = (*t_after_ptr_)[intdom];
+        auto pos = (thresholds_[i] - v_prev)/(v - v_prev);
+        auto crossing_time = math::lerp(t_before, t_after, pos);
+        crossings_.push_back({i, crossing_time});
+
+        if (record) {
+            (*time_since_spike)[src_to_spike_[i]] = t_after - crossing_time;
+            recorded_.push_back(i);
+        }
+    }
+
     /// Non-owning pointers to cv-to-intdom map,
     /// the values for to test against thresholds,
     /// and pointers to the time arrays
@@ -129,10 +193,11 @@ private:
     /// Threshold watcher state.
     fvm_size_type n_cv_ = 0;
     std::vector<fvm_index_type> cv_index_;
-    std::vector<fvm_size_type> is_crossed_;
     std::vector<fvm_value_type> thresholds_;
     std::vector<fvm_value_type> v_prev_;
     std::vector<threshold_crossing> crossings_;
+    std::vector<fvm_size_type> recorded_;  // Detectors with time_since_spike set.
+    std::vector<fvm_index_type> tile_divs_;
 };
 
 } // namespace multicore
@@ -0,0 +1,44 @@
+#pragma once
+
+// Support for tiled time stepping in the multicore back end.
+//
+// A tile is a contiguous range of CVs comprising whole integration domains.
+// Per-instance data (mechanism instances, ion CVs, stimuli, detectors) is
+// partitioned by tile so that each stage of the time step can be restricted
+// to the instances of one tile.
+
+#include <algorithm>
+#include <vector>
+
+#include <arbor/fvm_types.hpp>
+
+namespace arb {
+namespace multicore {
+
+// Compute the divisions `divs` of the `n` instances with CV indices `cv` by
+// the tiles with CV divisions `tile_cv_divs`. Returns false if the instances
+// of each tile are not contiguous.
+template <typename CVs>
+bool make_tile_divs(std::vector<fvm_index_type>& divs, const CVs& cv, std::size_t n, const std::vector<fvm_index_type>& tile_cv_divs) {
+    divs.clear();
+    if (tile_cv_divs.empty()) return true;
+
+    const std::size_t n_tile = tile_cv_divs.size()-1;
+    divs.reserve(n_tile+1);
+    divs.push_back(0);
+
+    std::size_t tile = 0;
+    for (std::size_t i = 0; i<n; ++i) {
+        auto c = cv[i];
+        if (c<tile_cv_divs[tile]) return false;
+        while (c>=tile_cv_divs[tile+1]) {
+            if (++tile==n_tile) return false;
+            divs.push_back(i);
+        }
+    }
+    divs.resize(n_tile+1, n);
+    return true;
+}
+
+} // namespace multicore
+} // namespace arb
@@ -90,6 +90,14 @@ const std::vector<spike>& benchmark_cell_group::spikes() const {
     return spikes_;
 }
 
+// The only state is the position in each schedule.
+void benchmark_cell_group::read_checkpoint(checkpoint_reader&, time_type t) {
+    reset();
+    for (auto& c: cells_) {
+        c.time_sequence.events(0, t);
+    }
+}
+
 void benchmark_cell_group::clear_spikes() {
     spikes_.clear();
 }
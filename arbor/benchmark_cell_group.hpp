@@ -28,6 +28,9 @@ public:
 
     void clear_spikes() override;
 
+    void write_checkpoint(checkpoint_writer&) const override {}
+    void read_checkpoint(checkpoint_reader&, time_type t) override;
+
     void add_sampler(sampler_association_handle h, cell_member_predicate probe_ids, schedule sched, sampler_function fn, sampling_policy policy) override;
 
     void remove_sampler(sampler_association_handle h) override {}
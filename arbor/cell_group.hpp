@@ -22,6 +22,9 @@
 //   ranges are needed to map (gid, label) pairs to their corresponding lid sets.
 namespace arb {
 
+class checkpoint_writer;
+class checkpoint_reader;
+
 using event_lane_subrange = util::subrange_view_type<std::vector<pse_vector>>;
 
 class cell_group {
@@ -37,6 +40,14 @@ public:
     virtual const std::vector<spike>& spikes() const = 0;
     virtual void clear_spikes() = 0;
 
+    // Checkpoint and restore: write the dynamic state of the cells at the end
+    // of the last epoch, or restore it, at time t, into a group constructed
+    // from the same recipe. Generated spikes are not included, and schedules
+    // are restored by replaying them from time zero.
+
+    virtual void write_checkpoint(checkpoint_writer&) const = 0;
+    virtual void read_checkpoint(checkpoint_reader&, time_type t) = 0;
+
     // Sampler association methods below should be thread-safe, as they might be invoked
     // from a sampler call back called from a different cell group running on a different thread.
 
@@ -44,6 +55,11 @@ public:
     virtual void remove_sampler(sampler_association_handle) = 0;
     virtual void remove_all_samplers() = 0;
 
+    // Sample sinks are removed with `remove_sampler`. Cell groups that do not
+    // own the probe, or do not support sampling, ignore the request.
+
+    virtual void add_sample_sink(sampler_association_handle, cell_member_type, unsigned, schedule, sample_ring_buffer, sample_commit_function, sampling_policy) {}
+
     // Probe metadata queries might also be called while a simulation is running, and so should
     // also be thread-safe.
 
@@ -0,0 +1,135 @@
+#pragma once
+
+// Binary serialization of simulation state for checkpoint and restore.
+//
+// A checkpoint is a flat sequence of trivially copyable values and length
+// prefixed sequences of such values, in native byte order and without type
+// information: it can only be restored by the same build of arbor into a
+// simulation built from the same recipe and domain decomposition. Sequences
+// of fixed length, such as per-CV state, are checked against the length of
+// the object being restored, so that a mismatched checkpoint is detected in
+// most cases; on failure, `bad_checkpoint` is thrown.
+
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <arbor/arbexcept.hpp>
+
+namespace arb {
+
+class checkpoint_writer {
+public:
+    explicit checkpoint_writer(std::ostream& out): out_(out) {}
+
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint values must be trivially copyable");
+        write_bytes(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void write(const std::optional<T>& value) {
+        write<bool>(value.has_value());
+        if (value) write(*value);
+    }
+
+    // Write a contiguous sequence of values, prefixed by its length.
+    template <typename Seq>
+    void write_seq(const Seq& seq) {
+        using T = std::decay_t<decltype(*seq.data())>;
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint values must be trivially copyable");
+
+        write<std::uint64_t>(seq.size());
+        write_bytes(seq.data(), seq.size()*sizeof(T));
+    }
+
+    void write(const std::string& s) {
+        write_seq(s);
+    }
+
+private:
+    std::ostream& out_;
+
+    void write_bytes(const void* p, std::size_t n) {
+        out_.write(static_cast<const char*>(p), n);
+        if (!out_) throw bad_checkpoint("write failed");
+    }
+};
+
+class checkpoint_reader {
+public:
+    explicit checkpoint_reader(std::istream& in): in_(in) {}
+
+    template <typename T>
+    void read(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint values must be trivially copyable");
+        read_bytes(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void read(std::optional<T>& value) {
+        if (read<bool>()) {
+            value.emplace();
+            read(*value);
+        }
+        else {
+            value.reset();
+        }
+    }
+
+    template <typename T>
+    T read() {
+        T value;
+        read(value);
+        return value;
+    }
+
+    // Read a sequence into `seq`, which must have the length of the sequence.
+    template <typename Seq>
+    void read_seq(Seq& seq) {
+        using T = std::decay_t<decltype(*seq.data())>;
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint values must be trivially copyable");
+
+        if (read<std::uint64_t>()!=seq.size()) {
+            throw bad_checkpoint("size mismatch");
+        }
+        read_bytes(seq.data(), seq.size()*sizeof(T));
+    }
+
+    // Read a sequence into `v`, resizing it to the length of the sequence.
+    template <typename T, typename A>
+    void read_vector(std::vector<T, A>& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint values must be trivially copyable");
+
+        v.resize(read<std::uint64_t>());
+        read_bytes(v.data(), v.size()*sizeof(T));
+    }
+
+    void read(std::string& s) {
+        s.resize(read<std::uint64_t>());
+        read_bytes(s.data(), s.size());
+    }
+
+    // Read a string and check that it matches `expected`.
+    void expect(const std::string& expected) {
+        std::string s;
+        read(s);
+        if (s!=expected) {
+            throw bad_checkpoint("expected '"+expected+"', found '"+s+"'");
+        }
+    }
+
+private:
+    std::istream& in_;
+
+    void read_bytes(void* p, std::size_t n) {
+        in_.read(static_cast<char*>(p), n);
+        if (!in_) throw bad_checkpoint("unexpected end of data");
+    }
+};
+
+} // namespace arb
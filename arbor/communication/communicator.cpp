@@ -230,5 +230,9 @@ void communicator::reset() {
     num_spikes_ = 0;
 }
 
+void communicator::restore_num_spikes(std::uint64_t n) {
+    num_spikes_ = n;
+}
+
 } // namespace arb
 
@@ -68,6 +68,9 @@ public:
 
     void reset();
 
+    // Set the total number of spikes, when restoring from a checkpoint.
+    void restore_num_spikes(std::uint64_t n);
+
 private:
     cell_size_type num_local_cells_;
     cell_size_type num_local_groups_;
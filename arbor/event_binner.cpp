@@ -9,6 +9,7 @@
 #include <arbor/common_types.hpp>
 #include <arbor/spike.hpp>
 
+#include "checkpoint.hpp"
 #include "event_binner.hpp"
 
 namespace arb {
@@ -17,6 +18,14 @@ void event_binner::reset() {
     last_event_time_ = std::nullopt;
 }
 
+void event_binner::write_checkpoint(checkpoint_writer& w) const {
+    w.write(last_event_time_);
+}
+
+void event_binner::read_checkpoint(checkpoint_reader& r) {
+    r.read(last_event_time_);
+}
+
 time_type event_binner::bin(time_type t, time_type t_min) {
     time_type t_binned = t;
 
@@ -9,6 +9,9 @@
 
 namespace arb {
 
+class checkpoint_writer;
+class checkpoint_reader;
+
 class event_binner {
 public:
     event_binner(): policy_(binning_kind::none), bin_interval_(0) {}
@@ -26,6 +29,10 @@ public:
 
     time_type bin(time_type t, time_type t_min = std::numeric_limits<time_type>::lowest());
 
+    // Write or restore the time of the last binned event.
+    void write_checkpoint(checkpoint_writer&) const;
+    void read_checkpoint(checkpoint_reader&);
+
 private:
     binning_kind policy_;
 
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <numeric>
 #include <optional>
 #include <set>
 #include <stdexcept>
@@ -772,6 +773,132 @@ fvm_mechanism_data& append(fvm_mechanism_data& left, const fvm_mechanism_data& r
 fvm_mechanism_data fvm_build_mechanism_data(const cable_cell_global_properties& gprop,
     const cable_cell& cell, const fvm_cv_discretization& D, fvm_size_type cell_idx);
 
+// Chunks are built greedily from the CV-ordered instances, in order of
+// preference: repeated instances on one CV fill constant chunks, then runs of
+// consecutive CVs fill contiguous chunks, then distinct CVs fill independent
+// chunks. The remaining instances, which have at most simd_width-1 distinct
+// CVs, go last in CV order. Full chunks are ordered by their first CV to keep
+// gathers local.
+
+void fvm_reorder_point_instances(fvm_mechanism_config& config, unsigned simd_width) {
+    using index_type = fvm_mechanism_config::index_type;
+
+    arb_assert(config.kind==mechanismKind::point);
+    arb_assert(std::is_sorted(config.cv.begin(), config.cv.end()));
+
+    const std::size_t n = config.cv.size();
+    if (simd_width<2 || n<simd_width) return;
+
+    // Distinct CVs, and for each the range [next, end) of its unplaced instances.
+    std::vector<index_type> cvs;
+    std::vector<std::size_t> next, end;
+    for (auto i: make_span(n)) {
+        if (!i || config.cv[i]!=config.cv[i-1]) {
+            cvs.push_back(config.cv[i]);
+            next.push_back(i);
+            end.push_back(i);
+        }
+        ++end.back();
+    }
+    const std::size_t n_cv = cvs.size();
+
+    std::vector<std::vector<std::size_t>> chunks;
+    auto take_one_each = [&](const std::vector<std::size_t>& ks) {
+        std::vector<std::size_t> chunk;
+        for (auto k: ks) chunk.push_back(next[k]++);
+        chunks.push_back(std::move(chunk));
+    };
+
+    for (auto k: make_span(n_cv)) {
+        while (end[k]-next[k]>=simd_width) {
+            std::vector<std::size_t> chunk(simd_width);
+            std::iota(chunk.begin(), chunk.end(), next[k]);
+            next[k] += simd_width;
+            chunks.push_back(std::move(chunk));
+        }
+    }
+
+    // Each pass below places at most one instance per CV, and no CV has
+    // simd_width or more instances left, so there are fewer than simd_width
+    // passes of each kind.
+    for (bool placed = true; placed;) {
+        placed = false;
+        std::vector<std::size_t> run;
+        for (auto k: make_span(n_cv)) {
+            if (next[k]==end[k]) {
+                run.clear();
+                continue;
+            }
+            if (!run.empty() && cvs[k]!=cvs[run.back()]+1) run.clear();
+            run.push_back(k);
+            if (run.size()==simd_width) {
+                take_one_each(run);
+                run.clear();
+                placed = true;
+            }
+        }
+    }
+
+    for (bool placed = true; placed;) {
+        placed = false;
+        std::vector<std::size_t> distinct;
+        for (auto k: make_span(n_cv)) {
+            if (next[k]==end[k]) continue;
+            distinct.push_back(k);
+            if (distinct.size()==simd_width) {
+                take_one_each(distinct);
+                distinct.clear();
+                placed = true;
+            }
+        }
+    }
+
+    std::stable_sort(chunks.begin(), chunks.end(),
+        [&](const auto& a, const auto& b) { return config.cv[a.front()]<config.cv[b.front()]; });
+
+    std::vector<std::size_t> order;
+    order.reserve(n);
+    for (auto& chunk: chunks) {
+        util::append(order, chunk);
+    }
+    for (auto k: make_span(n_cv)) {
+        for (auto i: make_span(next[k], end[k])) order.push_back(i);
+    }
+    arb_assert(order.size()==n);
+
+    auto permute = [&order](auto& v) {
+        if (v.empty()) return;
+        std::remove_reference_t<decltype(v)> permuted;
+        permuted.reserve(v.size());
+        for (auto i: order) permuted.push_back(v[i]);
+        v = std::move(permuted);
+    };
+
+    // Targets are grouped by instance, multiplicity[i] consecutive entries each.
+    if (!config.target.empty() && !config.multiplicity.empty()) {
+        std::vector<std::size_t> divs;
+        auto target_part = util::make_partition(divs, config.multiplicity);
+
+        std::vector<index_type> target;
+        target.reserve(config.target.size());
+        for (auto i: order) {
+            auto [b, e] = target_part[i];
+            target.insert(target.end(), config.target.begin()+b, config.target.begin()+e);
+        }
+        config.target = std::move(target);
+    }
+    else {
+        permute(config.target);
+    }
+
+    permute(config.cv);
+    permute(config.multiplicity);
+    permute(config.norm_area);
+    for (auto& pv: config.param_values) {
+        permute(pv.second);
+    }
+}
+
 fvm_mechanism_data fvm_build_mechanism_data(const cable_cell_global_properties& gprop,
     const std::vector<cable_cell>& cells, const fvm_cv_discretization& D, const execution_context& ctx)
 {
@@ -783,6 +910,29 @@ fvm_mechanism_data fvm_build_mechanism_data(const cable_cell_global_properties&
     for (auto cell_idx: count_along(cells)) {
         append(combined, cell_mech[cell_idx]);
     }
+
+    if (gprop.fused_density_block_size) {
+        std::vector<std::string> density;
+        for (const auto& [name, config]: combined.mechanisms) {
+            if (config.kind==mechanismKind::density && !config.cv.empty()) density.push_back(name);
+        }
+        sort(density);
+
+        std::vector<bool> grouped(density.size());
+        for (auto i: count_along(density)) {
+            if (grouped[i]) continue;
+
+            const auto& cv = combined.mechanisms.at(density[i]).cv;
+            std::vector<std::string> group = {density[i]};
+            for (auto j: make_span(i+1, density.size())) {
+                if (!grouped[j] && combined.mechanisms.at(density[j]).cv==cv) {
+                    grouped[j] = true;
+                    group.push_back(density[j]);
+                }
+            }
+            if (group.size()>1) combined.fused_density.push_back(std::move(group));
+        }
+    }
     return combined;
 }
 
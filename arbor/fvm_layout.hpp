@@ -229,7 +229,8 @@ struct fvm_mechanism_config {
     mechanismKind kind;
 
     // Ordered CV indices where mechanism is present; may contain
-    // duplicates for point mechanisms.
+    // duplicates for point mechanisms. Point mechanism instances are
+    // only ordered by CV within SIMD chunks after fvm_reorder_point_instances.
     std::vector<index_type> cv;
 
     // Coalesced synapse multiplier (point mechanisms only).
@@ -303,8 +304,21 @@ struct fvm_mechanism_data {
 
     // Contains mechanisms with post_event
     bool post_events = false;
+
+    // Fused density mechanisms: names of each set of two or more density
+    // mechanisms with identical CVs, in name order.
+    std::vector<std::vector<std::string>> fused_density;
 };
 
 fvm_mechanism_data fvm_build_mechanism_data(const cable_cell_global_properties& gprop, const std::vector<cable_cell>& cells, const fvm_cv_discretization& D, const arb::execution_context& ctx={});
 
+// Reorder the instances of a point mechanism so that as many aligned chunks of
+// `simd_width` instances as possible have constant or contiguous CV indices,
+// and as few as possible have repeated CVs. The CV, multiplicity, target and
+// parameter data are permuted together; within each chunk, CVs are ascending.
+//
+// After reordering, `config.cv` is no longer monotonic across chunks.
+
+void fvm_reorder_point_instances(fvm_mechanism_config& config, unsigned simd_width);
+
 } // namespace arb
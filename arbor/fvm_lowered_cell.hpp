@@ -25,6 +25,9 @@
 
 namespace arb {
 
+class checkpoint_writer;
+class checkpoint_reader;
+
 struct fvm_integration_result {
     util::range<const threshold_crossing*> crossings;
     util::range<const fvm_value_type*> sample_time;
@@ -200,6 +203,10 @@ struct fvm_initialization_data {
     // Handles for accessing lowered cell.
     std::vector<target_handle> target_handles;
 
+    // Flags indexed by target_handle::mech_id: true if events for targets of
+    // the mechanism may be aggregated by summing weights.
+    std::vector<bool> aggregate_events;
+
     // Maps probe ids to probe handles and tags.
     probe_association_map probe_map;
 
@@ -225,11 +232,17 @@ struct fvm_lowered_cell {
     virtual fvm_integration_result integrate(
         fvm_value_type tfinal,
         fvm_value_type max_dt,
-        std::vector<deliverable_event> staged_events,
-        std::vector<sample_event> staged_samples) = 0;
+        const std::vector<deliverable_event>& staged_events,
+        const std::vector<sample_event>& staged_samples) = 0;
 
     virtual fvm_value_type time() const = 0;
 
+    // Write the dynamic state of the cells, or restore it into a lowered cell
+    // initialized from the same recipe; throws bad_checkpoint if the back end
+    // does not support checkpoints.
+    virtual void write_checkpoint(checkpoint_writer&) const = 0;
+    virtual void read_checkpoint(checkpoint_reader&) = 0;
+
     virtual ~fvm_lowered_cell() {}
 };
 
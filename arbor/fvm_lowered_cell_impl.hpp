@@ -7,9 +7,12 @@
 // implementation details may be tested in the unit tests.
 // It should otherwise only be used in `fvm_lowered_cell.cpp`.
 
+#include <algorithm>
 #include <cmath>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <queue>
 #include <stdexcept>
@@ -19,10 +22,12 @@
 
 #include <arbor/assert.hpp>
 #include <arbor/common_types.hpp>
+#include <arbor/math.hpp>
 #include <arbor/cable_cell_param.hpp>
 #include <arbor/recipe.hpp>
 #include <arbor/util/any_visitor.hpp>
 
+#include "checkpoint.hpp"
 #include "execution_context.hpp"
 #include "fvm_layout.hpp"
 #include "fvm_lowered_cell.hpp"
@@ -58,8 +63,8 @@ public:
     fvm_integration_result integrate(
         value_type tfinal,
         value_type max_dt,
-        std::vector<deliverable_event> staged_events,
-        std::vector<sample_event> staged_samples) override;
+        const std::vector<deliverable_event>& staged_events,
+        const std::vector<sample_event>& staged_samples) override;
 
     std::vector<fvm_gap_junction> fvm_gap_junctions(
         const std::vector<cable_cell>& cells,
@@ -77,6 +82,9 @@ public:
 
     value_type time() const override { return tmin_; }
 
+    void write_checkpoint(checkpoint_writer&) const override;
+    void read_checkpoint(checkpoint_reader&) override;
+
     //Exposed for testing purposes
     std::vector<mechanism_ptr>& mechanisms() {
         return mechanisms_;
@@ -110,12 +118,59 @@ private:
     // Flag indicating that at least one of the mechanisms implements the post_events procedure
     bool post_events_;
 
+    // Tiled time stepping: divisions of cells by tile; empty if not tiled.
+    std::vector<index_type> tile_cell_divs_;
+
+    // Fused density mechanisms: ranges [begin, end) of mechanisms_ that run
+    // one block of instances at a time, with their number of blocks.
+    struct fused_density_group {
+        std::size_t begin, end;
+        size_type n_block;
+    };
+    std::vector<fused_density_group> fused_density_;
+
+    // Steady-state initialization: maximum number of iterations, 0 => disabled;
+    // convergence tolerance [mV]; and an infinite time step per integration domain.
+    unsigned steady_state_max_iterations_ = 0;
+    value_type steady_state_tolerance_ = 0;
+    array steady_state_dt_;
+
     // Host-side views/copies and local state.
     decltype(backend::host_view(sample_time_)) sample_time_host_;
     decltype(backend::host_view(sample_value_)) sample_value_host_;
 
     void update_ion_state();
 
+    // Set mechanism and ion state from the INITIAL blocks at the current voltage.
+    void initialize_mechanism_state();
+
+    // Iterate membrane voltage and mechanism state to a fixed point.
+    void initialize_steady_state();
+
+    // Assemble and solve the voltage equation, iterating over cells coupled
+    // by gap junctions if these are implicit.
+    void integrate_voltage();
+
+    void configure_tiles(
+        std::size_t tile_size_bytes,
+        const fvm_cv_discretization& D,
+        const fvm_mechanism_data& mech_data,
+        const std::unordered_map<std::string, mechanism*>& mechptr_by_name,
+        const std::vector<index_type>& cell_to_intdom);
+
+    // Take one time step, running the step pipeline on each tile in turn.
+    void step_tiled(value_type tfinal, value_type dt_max);
+
+    void configure_fused_density(
+        std::size_t block_size,
+        const fvm_mechanism_data& mech_data,
+        const std::unordered_map<std::string, mechanism*>& mechptr_by_name);
+
+    // Call f(m) for each mechanism m in mechanisms_ in turn, except that the
+    // members of each fused density group are called in turn for each block.
+    template <typename F>
+    void run_mechanisms(F&& f);
+
     // Throw if absolute value of membrane voltage exceeds bounds.
     void assert_voltage_bounded(fvm_value_type bound);
 
@@ -164,30 +219,57 @@ void fvm_lowered_cell_impl<Backend>::assert_tmin() {
 }
 
 template <typename Backend>
-void fvm_lowered_cell_impl<Backend>::reset() {
-    state_->reset();
-    set_tmin(0);
-
-    for (auto& m: revpot_mechanisms_) {
-        m->initialize();
+void fvm_lowered_cell_impl<Backend>::write_checkpoint(checkpoint_writer& w) const {
+    if constexpr (backend::supports_checkpoint) {
+        w.write(tmin_);
+        state_->write_checkpoint(w);
+        threshold_watcher_.write_checkpoint(w);
+
+        for (auto* mechs: {&revpot_mechanisms_, &mechanisms_}) {
+            w.write<std::uint64_t>(mechs->size());
+            for (auto& m: *mechs) {
+                w.write(m->internal_name());
+                backend::mechanism_write_checkpoint(m.get(), w);
+            }
+        }
     }
-
-    for (auto& m: mechanisms_) {
-        m->initialize();
+    else {
+        throw bad_checkpoint("checkpoints are not supported by the "+backend::name()+" back end");
     }
+}
 
-    update_ion_state();
+template <typename Backend>
+void fvm_lowered_cell_impl<Backend>::read_checkpoint(checkpoint_reader& r) {
+    if constexpr (backend::supports_checkpoint) {
+        auto tmin = r.read<value_type>();
+        state_->read_checkpoint(r);
+        threshold_watcher_.read_checkpoint(r);
+        set_tmin(tmin);
+
+        for (auto* mechs: {&revpot_mechanisms_, &mechanisms_}) {
+            if (r.read<std::uint64_t>()!=mechs->size()) {
+                throw bad_checkpoint("mechanism count mismatch");
+            }
+            for (auto& m: *mechs) {
+                r.expect(m->internal_name());
+                backend::mechanism_read_checkpoint(m.get(), r);
+            }
+        }
+    }
+    else {
+        throw bad_checkpoint("checkpoints are not supported by the "+backend::name()+" back end");
+    }
+}
 
-    state_->zero_currents();
+template <typename Backend>
+void fvm_lowered_cell_impl<Backend>::reset() {
+    state_->reset();
+    set_tmin(0);
 
-    // Note: mechanisms must be initialized again after the ion state is updated,
-    // as mechanisms can read/write the ion_state within the initialize block
-    for (auto& m: revpot_mechanisms_) {
-        m->initialize();
-    }
+    initialize_mechanism_state();
 
-    for (auto& m: mechanisms_) {
-        m->initialize();
+    if (steady_state_max_iterations_) {
+        initialize_steady_state();
     }
 
     // NOTE: Threshold watcher reset must come after the voltage values are set,
@@ -199,8 +281,8 @@ template <typename Backend>
 fvm_integration_result fvm_lowered_cell_impl<Backend>::integrate(
     value_type tfinal,
     value_type dt_max,
-    std::vector<deliverable_event> staged_events,
-    std::vector<sample_event> staged_samples)
+    const std::vector<deliverable_event>& staged_events,
+    const std::vector<sample_event>& staged_samples)
 {
     set_gpu();
 
@@ -214,8 +296,8 @@ fvm_integration_result fvm_lowered_cell_impl<Backend>::integrate(
         sample_value_ = array(n_samples);
     }
 
-    state_->deliverable_events.init(std::move(staged_events));
-    sample_events_.init(std::move(staged_samples));
+    state_->deliverable_events.init(staged_events);
+    sample_events_.init(staged_samples);
 
     arb_assert((assert_tmin(), true));
     unsigned remaining_steps = dt_steps(tmin_, tfinal, dt_max);
@@ -226,90 +308,96 @@ fvm_integration_result fvm_lowered_cell_impl<Backend>::integrate(
     // complete fvm state into shared state object.
 
     while (remaining_steps) {
-        // Update any required reversal potentials based on ionic concs.
+        if constexpr (backend::supports_adaptive_dt) {
+            if (state_->adaptive_dt()) state_->adaptive_dt_begin();
+        }
 
-        for (auto& m: revpot_mechanisms_) {
-            m->update_current();
+        if (!tile_cell_divs_.empty()) {
+            step_tiled(tfinal, dt_max);
         }
+        else {
+            // Update any required reversal potentials based on ionic concs.
 
-        // Deliver events and accumulate mechanism current contributions.
+            for (auto& m: revpot_mechanisms_) {
+                m->update_current();
+            }
 
-        PE(advance_integrate_events);
-        state_->deliverable_events.mark_until_after(state_->time);
-        PL();
+            // Deliver events and accumulate mechanism current contributions.
 
-        PE(advance_integrate_current_zero);
-        state_->zero_currents();
-        PL();
-        for (auto& m: mechanisms_) {
-            m->deliver_events();
-            m->update_current();
-        }
+            PE(advance_integrate_events);
+            state_->deliverable_events.mark_until_after(state_->time);
+            PL();
 
-        // Add current contribution from gap_junctions
-        state_->add_gj_current();
+            PE(advance_integrate_current_zero);
+            state_->zero_currents();
+            PL();
+            for (auto& m: mechanisms_) {
+                m->deliver_events();
+            }
+            run_mechanisms([](mechanism* m) { m->update_current(); });
 
-        PE(advance_integrate_events);
-        state_->deliverable_events.drop_marked_events();
+            // Add current contribution from gap_junctions
+            state_->add_gj_current();
 
-        // Update event list and integration step times.
+            PE(advance_integrate_events);
+            state_->deliverable_events.drop_marked_events();
 
-        state_->update_time_to(dt_max, tfinal);
-        state_->deliverable_events.event_time_if_before(state_->time_to);
-        state_->set_dt();
-        PL();
+            // Update event list and integration step times.
+
+            state_->update_time_to(dt_max, tfinal);
+            state_->deliverable_events.event_time_if_before(state_->time_to);
+            state_->set_dt();
+            PL();
 
-        // Add stimulus current contributions.
-        // (Note: performed after dt, time_to calculation, in case we
-        // want to use mean current contributions as opposed to point
-        // sample.)
+            // Add stimulus current contributions.
+            // (Note: performed after dt, time_to calculation, in case we
+            // want to use mean current contributions as opposed to point
+            // sample.)
 
-        PE(advance_integrate_stimuli)
-        state_->add_stimulus_current();
-        PL();
+            PE(advance_integrate_stimuli)
+            state_->add_stimulus_current();
+            PL();
 
-        // Take samples at cell time if sample time in this step interval.
+            // Take samples at cell time if sample time in this step interval.
 
-        PE(advance_integrate_samples);
-        sample_events_.mark_until(state_->time_to);
-        state_->take_samples(sample_events_.marked_events(), sample_time_, sample_value_);
-        sample_events_.drop_marked_events();
-        PL();
+            PE(advance_integrate_samples);
+            sample_events_.mark_until(state_->time_to);
+            state_->take_samples(sample_events_.marked_events(), sample_time_, sample_value_);
+            sample_events_.drop_marked_events();
+            PL();
 
-        // Integrate voltage by matrix solve.
+            // Integrate voltage by matrix solve.
 
-        PE(advance_integrate_matrix_build);
-        matrix_.assemble(state_->dt_intdom, state_->voltage, state_->current_density, state_->conductivity);
-        PL();
-        PE(advance_integrate_matrix_solve);
-        matrix_.solve(state_->voltage);
-        PL();
+            integrate_voltage();
 
-        // Integrate mechanism state.
+            // Integrate mechanism state.
 
-        for (auto& m: mechanisms_) {
-            m->update_state();
-        }
+            run_mechanisms([](mechanism* m) { m->update_state(); });
 
-        // Update ion concentrations.
+            // Update ion concentrations.
 
-        PE(advance_integrate_ionupdate);
-        update_ion_state();
-        PL();
+            PE(advance_integrate_ionupdate);
+            update_ion_state();
+            PL();
 
-        // Update time and test for spike threshold crossings.
+            // Update time and test for spike threshold crossings.
 
-        PE(advance_integrate_threshold);
-        threshold_watcher_.test(&state_->time_since_spike);
-        PL();
+            PE(advance_integrate_threshold);
+            threshold_watcher_.test(&state_->time_since_spike);
+            PL();
 
-        PE(advance_integrate_post)
-        if (post_events_) {
-            for (auto& m: mechanisms_) {
-                m->post_event();
+            PE(advance_integrate_post)
+            if (post_events_) {
+                for (auto& m: mechanisms_) {
+                    m->post_event();
+                }
             }
+            PL();
+        }
+
+        if constexpr (backend::supports_adaptive_dt) {
+            if (state_->adaptive_dt()) state_->adaptive_dt_end();
         }
-        PL();
 
         std::swap(state_->time_to, state_->time);
 
@@ -344,6 +432,344 @@ fvm_integration_result fvm_lowered_cell_impl<Backend>::integrate(
     };
 }
 
+template <typename Backend>
+void fvm_lowered_cell_impl<Backend>::step_tiled(value_type tfinal, value_type dt_max) {
+    if constexpr (backend::supports_tiling) {
+        // Event delivery and the step end times are computed for all
+        // integration domains; the remainder of the step runs to completion
+        // on each tile before moving to the next, so that the tile's state
+        // stays in cache. Mechanism event delivery requires the full
+        // instance range to be selected.
+
+        PE(advance_integrate_events);
+        state_->deliverable_events.mark_until_after(state_->time);
+        PL();
+
+        for (auto& m: mechanisms_) {
+            m->deliver_events();
+        }
+
+        PE(advance_integrate_events);
+        state_->deliverable_events.drop_marked_events();
+        state_->update_time_to(dt_max, tfinal);
+        state_->deliverable_events.event_time_if_before(state_->time_to);
+        sample_events_.mark_until(state_->time_to);
+        PL();
+
+        auto marked_samples = sample_events_.marked_events();
+
+        for (auto tile: util::make_span(state_->n_tile())) {
+            index_type cell_begin = tile_cell_divs_[tile];
+            index_type cell_end = tile_cell_divs_[tile+1];
+
+            for (auto& m: revpot_mechanisms_) {
+                backend::mechanism_select_tile(m.get(), tile);
+                m->update_current();
+            }
+
+            PE(advance_integrate_current_zero);
+            state_->zero_currents(tile);
+            PL();
+            for (auto& m: mechanisms_) {
+                backend::mechanism_select_tile(m.get(), tile);
+                m->update_current();
+            }
+
+            state_->set_dt(tile);
+
+            PE(advance_integrate_stimuli)
+            state_->add_stimulus_current(tile);
+            PL();
+
+            PE(advance_integrate_samples);
+            state_->take_samples(marked_samples, tile, sample_time_, sample_value_);
+            PL();
+
+            PE(advance_integrate_matrix_build);
+            matrix_.assemble(state_->dt_intdom, state_->voltage, state_->current_density, state_->conductivity, cell_begin, cell_end);
+            PL();
+            PE(advance_integrate_matrix_solve);
+            matrix_.solve(state_->voltage, cell_begin, cell_end);
+            PL();
+
+            for (auto& m: mechanisms_) {
+                m->update_state();
+            }
+
+            PE(advance_integrate_ionupdate);
+            state_->ions_init_concentration(tile);
+            for (auto& m: mechanisms_) {
+                m->update_ions();
+            }
+            PL();
+
+            PE(advance_integrate_threshold);
+            threshold_watcher_.test(&state_->time_since_spike, tile);
+            PL();
+
+            PE(advance_integrate_post)
+            if (post_events_) {
+                for (auto& m: mechanisms_) {
+                    m->post_event();
+                }
+            }
+            PL();
+        }
+
+        for (auto& m: revpot_mechanisms_) {
+            backend::mechanism_select_all(m.get());
+        }
+        for (auto& m: mechanisms_) {
+            backend::mechanism_select_all(m.get());
+        }
+
+        sample_events_.drop_marked_events();
+    }
+}
+
+// Partition the cells into tiles of whole integration domains whose
+// estimated working set fits in tile_size_bytes, and partition the cell
+// state and mechanisms accordingly. Tiling is left disabled if there would
+// be only one tile, or if some part of the state can not be partitioned,
+// for example because of gap junctions or SIMD mechanism kernels.
+template <typename Backend>
+void fvm_lowered_cell_impl<Backend>::configure_tiles(
+    std::size_t tile_size_bytes,
+    const fvm_cv_discretization& D,
+    const fvm_mechanism_data& mech_data,
+    const std::unordered_map<std::string, mechanism*>& mechptr_by_name,
+    const std::vector<index_type>& cell_to_intdom)
+{
+    tile_cell_divs_.clear();
+
+    if constexpr (backend::supports_tiling) {
+        const index_type n_cell = D.n_cell();
+        if (!tile_size_bytes || state_->n_gj || n_cell<2) return;
+
+        // Integration domains must be contiguous ranges of cells.
+        if (!util::is_sorted(cell_to_intdom)) return;
+
+        // Estimate the working set per cell: shared state and matrix per CV,
+        // and mechanism and ion state per instance.
+        constexpr std::size_t cv_bytes = 16*sizeof(value_type) + 4*sizeof(index_type);
+        constexpr std::size_t ion_cv_bytes = 8*sizeof(value_type);
+
+        std::vector<std::size_t> cell_bytes(n_cell);
+        for (auto i: util::make_span(n_cell)) {
+            cell_bytes[i] = cv_bytes*(D.geometry.cell_cv_divs[i+1]-D.geometry.cell_cv_divs[i]);
+        }
+        for (const auto& [name, config]: mech_data.mechanisms) {
+            const mechanism* m = mechptr_by_name.at(name);
+            if (!m->size()) continue;
+
+            std::size_t instance_bytes = m->memory()/m->size();
+            for (auto cv: config.cv) {
+                cell_bytes[D.geometry.cv_to_cell[cv]] += instance_bytes;
+            }
+        }
+        for (const auto& [name, config]: mech_data.ions) {
+            for (auto cv: config.cv) {
+                cell_bytes[D.geometry.cv_to_cell[cv]] += ion_cv_bytes;
+            }
+        }
+
+        std::vector<index_type> cell_divs = {0};
+        std::size_t bytes = 0;
+        for (auto i: util::make_span(n_cell)) {
+            bool intdom_boundary = i>0 && cell_to_intdom[i]!=cell_to_intdom[i-1];
+            if (intdom_boundary && bytes+cell_bytes[i]>tile_size_bytes) {
+                cell_divs.push_back(i);
+                bytes = 0;
+            }
+            bytes += cell_bytes[i];
+        }
+        cell_divs.push_back(n_cell);
+        if (cell_divs.size()<3) return;
+
+        std::vector<index_type> cv_divs, intdom_divs;
+        for (auto i: cell_divs) {
+            cv_divs.push_back(D.geometry.cell_cv_divs[i]);
+            intdom_divs.push_back(i<n_cell? cell_to_intdom[i]: index_type(state_->n_intdom));
+        }
+
+        bool ok = state_->configure_tiles(cv_divs, intdom_divs) && threshold_watcher_.set_tiles(cv_divs);
+        for (auto& m: revpot_mechanisms_) {
+            ok = ok && backend::mechanism_set_tiles(m.get(), cv_divs);
+        }
+        for (auto& m: mechanisms_) {
+            ok = ok && backend::mechanism_set_tiles(m.get(), cv_divs);
+        }
+
+        if (ok) {
+            tile_cell_divs_ = std::move(cell_divs);
+        }
+        else {
+            state_->configure_tiles({}, {});
+        }
+    }
+}
+
+// Partition the members of each fused density group into blocks, and make the
+// members of each group that runs by blocks adjacent in mechanisms_. The block
+// size is rounded up to a common multiple of the SIMD widths of the members,
+// so that the blocks of each member cover the same instances. Blocks are not
+// used with tiled time stepping, which already keeps the state of a tile in
+// cache, if there would be only one block, or if the members do not have the
+// same number of blocks; the order of mechanisms, and so the order in which
+// currents are summed, is then unchanged.
+template <typename Backend>
+void fvm_lowered_cell_impl<Backend>::configure_fused_density(
+    std::size_t block_size,
+    const fvm_mechanism_data& mech_data,
+    const std::unordered_map<std::string, mechanism*>& mechptr_by_name)
+{
+    fused_density_.clear();
+
+    if constexpr (backend::supports_fused_density) {
+        if (!tile_cell_divs_.empty()) return;
+
+        std::vector<std::pair<mechanism*, fused_density_group>> blocked;
+        for (auto& group: mech_data.fused_density) {
+            std::vector<mechanism*> members;
+            for (auto& name: group) {
+                members.push_back(mechptr_by_name.at(name));
+            }
+
+            std::size_t simd_multiple = 1;
+            for (auto m: members) {
+                simd_multiple = std::lcm(simd_multiple, std::size_t(backend::mechanism_simd_width(m)));
+            }
+            auto group_block_size = math::round_up(block_size, simd_multiple);
+
+            bool same_blocks = true;
+            std::size_t n_block = 0;
+            for (auto m: members) {
+                auto n = backend::mechanism_set_blocks(m, group_block_size);
+                same_blocks &= m==members.front() || n==n_block;
+                n_block = n;
+            }
+            if (!same_blocks || n_block<=1) {
+                for (auto m: members) {
+                    backend::mechanism_set_blocks(m, 0);
+                }
+                continue;
+            }
+
+            auto is_member = [&members](const mechanism_ptr& m) { return std::find(members.begin(), members.end(), m.get())!=members.end(); };
+            auto first = std::find_if(mechanisms_.begin(), mechanisms_.end(), is_member);
+            std::stable_partition(std::next(first), mechanisms_.end(), is_member);
+            blocked.push_back({first->get(), fused_density_group{0, members.size(), size_type(n_block)}});
+        }
+
+        // Partitioning keeps the members of other groups adjacent: find the
+        // position of each group once all are in place.
+        for (auto& [first, g]: blocked) {
+            g.begin = std::find_if(mechanisms_.begin(), mechanisms_.end(),
+                [first = first](auto& m) { return m.get()==first; })-mechanisms_.begin();
+            g.end += g.begin;
+            fused_density_.push_back(g);
+        }
+        util::sort_by(fused_density_, [](auto& g) { return g.begin; });
+    }
+}
+
+template <typename Backend>
+template <typename F>
+void fvm_lowered_cell_impl<Backend>::run_mechanisms(F&& f) {
+    std::size_t i = 0;
+    if constexpr (backend::supports_fused_density) {
+        for (auto& g: fused_density_) {
+            for (; i<g.begin; ++i) {
+                f(mechanisms_[i].get());
+            }
+            for (auto block: util::make_span(g.n_block)) {
+                for (auto j: util::make_span(g.begin, g.end)) {
+                    backend::mechanism_select_block(mechanisms_[j].get(), block);
+                    f(mechanisms_[j].get());
+                }
+            }
+            for (auto j: util::make_span(g.begin, g.end)) {
+                backend::mechanism_select_all(mechanisms_[j].get());
+            }
+            i = g.end;
+        }
+    }
+    for (; i<mechanisms_.size(); ++i) {
+        f(mechanisms_[i].get());
+    }
+}
+
+template <typename Backend>
+void fvm_lowered_cell_impl<Backend>::initialize_mechanism_state() {
+    for (auto& m: revpot_mechanisms_) {
+        m->initialize();
+    }
+
+    for (auto& m: mechanisms_) {
+        m->initialize();
+    }
+
+    update_ion_state();
+
+    state_->zero_currents();
+
+    // Note: mechanisms must be initialized again after the ion state is updated,
+    // as mechanisms can read/write the ion_state within the initialize block
+    for (auto& m: revpot_mechanisms_) {
+        m->initialize();
+    }
+
+    for (auto& m: mechanisms_) {
+        m->initialize();
+    }
+}
+
+// With an infinite time step the capacitive term drops out of the voltage
+// equation, and each assemble and solve is a Newton step towards the voltage
+// at which the linearized membrane and axial currents balance. Mechanism state
+// is then reset from the INITIAL blocks at the new voltage, and the two are
+// iterated until the voltage changes by at most steady_state_tolerance_ in
+// every CV. Stimuli are not included. It is an error if the voltage has not
+// converged after steady_state_max_iterations_ iterations.
+template <typename Backend>
+void fvm_lowered_cell_impl<Backend>::initialize_steady_state() {
+    std::vector<value_type> v_prev;
+    value_type delta = 0;
+
+    for (unsigned k = 0; k<steady_state_max_iterations_; ++k) {
+        util::assign(v_prev, backend::host_view(state_->voltage));
+
+        for (auto& m: revpot_mechanisms_) {
+            m->update_current();
+        }
+
+        state_->zero_currents();
+        for (auto& m: mechanisms_) {
+            m->update_current();
+        }
+        state_->add_gj_current();
+
+        matrix_.assemble(steady_state_dt_, state_->voltage, state_->current_density, state_->conductivity);
+        matrix_.solve(state_->voltage);
+
+        initialize_mechanism_state();
+
+        delta = 0;
+        auto v = backend::host_view(state_->voltage);
+        for (auto i: util::count_along(v_prev)) {
+            auto d = std::abs(v[i]-v_prev[i]);
+            if (!(d<=delta)) delta = d; // propagate NaN
+        }
+
+        if (!std::isfinite(delta)) {
+            throw range_check_failure("steady-state voltage solution is not finite", delta);
+        }
+        if (delta<=steady_state_tolerance_) return;
+    }
+
+    throw range_check_failure("steady-state voltage did not converge", delta);
+}
+
 template <typename Backend>
 void fvm_lowered_cell_impl<Backend>::update_ion_state() {
     state_->ions_init_concentration();
@@ -352,6 +778,34 @@ void fvm_lowered_cell_impl<Backend>::update_ion_state() {
     }
 }
 
+template <typename Backend>
+void fvm_lowered_cell_impl<Backend>::integrate_voltage() {
+    if constexpr (backend::supports_implicit_gj) {
+        if (state_->implicit_gj()) {
+            state_->gj_implicit_begin();
+            for (unsigned k = 1; ; ++k) {
+                PE(advance_integrate_matrix_build);
+                matrix_.assemble(state_->dt_intdom, state_->voltage, state_->current_density, state_->conductivity);
+                PL();
+                PE(advance_integrate_matrix_solve);
+                matrix_.solve(state_->gj_voltage_next);
+                PL();
+                auto delta = state_->gj_implicit_update();
+                if (delta<=state_->gj_tolerance || k==state_->gj_max_iterations) break;
+            }
+            state_->gj_implicit_end();
+            return;
+        }
+    }
+
+    PE(advance_integrate_matrix_build);
+    matrix_.assemble(state_->dt_intdom, state_->voltage, state_->current_density, state_->conductivity);
+    PL();
+    PE(advance_integrate_matrix_solve);
+    matrix_.solve(state_->voltage);
+    PL();
+}
+
 template <typename Backend>
 void fvm_lowered_cell_impl<Backend>::assert_voltage_bounded(fvm_value_type bound) {
     auto v_minmax = state_->voltage_bounds();
@@ -462,6 +916,7 @@ fvm_initialization_data fvm_lowered_cell_impl<Backend>::initialize(
     arb_assert(D.n_cell() == ncell);
     matrix_ = matrix<backend>(D.geometry.cv_parent, D.geometry.cell_cv_divs,
                               D.cv_capacitance, D.face_conductance, D.cv_area, fvm_info.cell_to_intdom);
+    backend::matrix_set_thread_pool(matrix_.state_, context_);
     sample_events_ = sample_event_stream(nintdom);
 
     // Discretize mechanism data.
@@ -520,6 +975,42 @@ fvm_initialization_data fvm_lowered_cell_impl<Backend>::initialize(
         state_->configure_stimulus(mech_data.stimuli);
     }
 
+    if (global_props.implicit_gap_junctions) {
+        if (!global_props.gap_junction_max_iterations) {
+            throw cable_cell_error("gap_junction_max_iterations must be positive");
+        }
+        if (!(global_props.gap_junction_tolerance>=0)) {
+            throw cable_cell_error("gap_junction_tolerance must be non-negative");
+        }
+        if constexpr (backend::supports_implicit_gj) {
+            state_->configure_implicit_gj(global_props.gap_junction_tolerance, global_props.gap_junction_max_iterations);
+        }
+    }
+
+    if (global_props.steady_state_initialization) {
+        if (!global_props.steady_state_max_iterations) {
+            throw cable_cell_error("steady_state_max_iterations must be positive");
+        }
+        if (!(global_props.steady_state_tolerance>=0)) {
+            throw cable_cell_error("steady_state_tolerance must be non-negative");
+        }
+        steady_state_max_iterations_ = global_props.steady_state_max_iterations;
+        steady_state_tolerance_ = global_props.steady_state_tolerance;
+        steady_state_dt_ = array(nintdom, std::numeric_limits<value_type>::infinity());
+    }
+    else {
+        steady_state_max_iterations_ = 0;
+    }
+
+    if (global_props.adaptive_dt_tolerance>0) {
+        if (!(global_props.adaptive_dt_min>0)) {
+            throw cable_cell_error("adaptive_dt_min must be positive");
+        }
+        if constexpr (backend::supports_adaptive_dt) {
+            state_->configure_adaptive_dt(global_props.adaptive_dt_tolerance, global_props.adaptive_dt_min);
+        }
+    }
+
     fvm_info.target_handles.resize(mech_data.n_target);
 
     // Keep track of mechanisms by name for probe lookup.
@@ -529,6 +1020,11 @@ fvm_initialization_data fvm_lowered_cell_impl<Backend>::initialize(
     for (auto& m: mech_data.mechanisms) {
         auto& name = m.first;
         auto& config = m.second;
+        auto minst = mech_instance(name);
+
+        if (config.kind==mechanismKind::point) {
+            fvm_reorder_point_instances(config, backend::mechanism_simd_width(minst.mech.get()));
+        }
 
         mechanism_layout layout;
         layout.cv = config.cv;
@@ -577,7 +1073,7 @@ fvm_initialization_data fvm_lowered_cell_impl<Backend>::initialize(
             break;
         }
 
-        auto minst = mech_instance(name);
+        fvm_info.aggregate_events.push_back(global_props.aggregate_events && (*catalogue)[name].linear_net_receive);
         minst.mech->instantiate(mech_id++, *state_, minst.overrides, layout);
         mechptr_by_name[name] = minst.mech.get();
 
@@ -626,6 +1122,9 @@ fvm_initialization_data fvm_lowered_cell_impl<Backend>::initialize(
 
     threshold_watcher_ = backend::voltage_watcher(*state_, detector_cv, detector_threshold, context_);
 
+    configure_tiles(global_props.tile_size_bytes, D, mech_data, mechptr_by_name, fvm_info.cell_to_intdom);
+    configure_fused_density(global_props.fused_density_block_size, mech_data, mechptr_by_name);
+
     reset();
 
     return fvm_info;
@@ -0,0 +1,102 @@
+#include <cstdint>
+
+#include "perf_counters.hpp"
+
+#ifdef __linux__
+extern "C" {
+    #include <linux/perf_event.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+}
+#include <cstring>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <cpuid.h>
+#endif
+
+namespace arb {
+namespace hw {
+
+#if defined(__linux__)
+namespace {
+    int open_counter(std::uint32_t type, std::uint64_t config, int group_fd) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.read_format = PERF_FORMAT_GROUP|PERF_FORMAT_TOTAL_TIME_ENABLED|PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        // Count on the calling thread, on any cpu.
+        return syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+    }
+
+    // Floating point events are model specific: only Intel is supported.
+    bool is_intel() {
+#if defined(__x86_64__) || defined(__i386__)
+        unsigned a, b, c, d;
+        if (!__get_cpuid(0, &a, &b, &c, &d)) return false;
+        return b==0x756e6547 && d==0x49656e69 && c==0x6c65746e; // "GenuineIntel"
+#else
+        return false;
+#endif
+    }
+
+    // FP_ARITH_INST_RETIRED with all scalar and packed variants selected,
+    // on Intel processors from Broadwell.
+    constexpr std::uint64_t intel_fp_arith_inst_retired = 0xffc7;
+}
+
+perf_counter_group::perf_counter_group() {
+    fd_[0] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (fd_[0]<0) return;
+
+    fd_[1] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, fd_[0]);
+    fd_[2] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, fd_[0]);
+    if (is_intel()) {
+        fd_[3] = open_counter(PERF_TYPE_RAW, intel_fp_arith_inst_retired, fd_[0]);
+    }
+}
+
+perf_counter_group::~perf_counter_group() {
+    for (int fd: fd_) {
+        if (fd>=0) close(fd);
+    }
+}
+
+perf_counts perf_counter_group::read() const {
+    perf_counts result;
+    if (!available()) return result;
+
+    // With PERF_FORMAT_GROUP, reading the group leader gives the number of
+    // counters, the times for which the group was enabled and running,
+    // and the counter values in the order they were opened.
+    std::uint64_t buf[3+4] = {0};
+    if (::read(fd_[0], buf, sizeof(buf))<=0) return result;
+
+    const std::uint64_t enabled = buf[1], running = buf[2];
+    std::uint64_t* fields[4] = {&result.cycles, &result.instructions, &result.llc_misses, &result.fp_ops};
+    std::uint64_t* value = buf+3;
+    for (unsigned i=0; i<4; ++i) {
+        if (fd_[i]>=0 && value<buf+3+buf[0]) {
+            *fields[i] = scale_count(*value++, enabled, running);
+        }
+    }
+    return result;
+}
+#else
+perf_counter_group::perf_counter_group() {}
+perf_counter_group::~perf_counter_group() {}
+perf_counts perf_counter_group::read() const { return {}; }
+#endif
+
+bool has_perf_counters() {
+    return perf_counter_group().available();
+}
+
+} // namespace hw
+} // namespace arb
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+
+namespace arb {
+namespace hw {
+
+// Hardware event counts, as read from the Linux perf_event interface.
+// Counts are for user space execution only.
+struct perf_counts {
+    std::uint64_t cycles = 0;
+    std::uint64_t instructions = 0;
+
+    // Last level cache misses; each miss transfers one cache line from memory.
+    std::uint64_t llc_misses = 0;
+
+    // Retired floating point arithmetic instructions, scalar or vector.
+    // There is no generic perf event for floating point operations: this
+    // is only counted on Intel processors.
+    std::uint64_t fp_ops = 0;
+
+    perf_counts& operator+=(const perf_counts& x) {
+        cycles += x.cycles;
+        instructions += x.instructions;
+        llc_misses += x.llc_misses;
+        fp_ops += x.fp_ops;
+        return *this;
+    }
+
+    friend perf_counts operator-(perf_counts a, const perf_counts& b) {
+        a.cycles -= b.cycles;
+        a.instructions -= b.instructions;
+        a.llc_misses -= b.llc_misses;
+        a.fp_ops -= b.fp_ops;
+        return a;
+    }
+};
+
+// When more counters are open than the PMU has, the kernel multiplexes them,
+// and each group counts only for part of the time it is enabled. Estimate
+// the count over the enabled time from the count over the running time.
+inline std::uint64_t scale_count(std::uint64_t count, std::uint64_t enabled, std::uint64_t running) {
+    if (running==0 || running>=enabled) return count;
+    return static_cast<std::uint64_t>(static_cast<double>(count)*enabled/running);
+}
+
+// Size in bytes of the cache line transferred on a last level cache miss.
+constexpr unsigned cache_line_bytes = 64;
+
+// A group of hardware counters that count events on the thread that
+// constructed it, scheduled together on the PMU so that the counts are
+// comparable.
+//
+// Opening the counters fails if the platform is not Linux, if the kernel
+// does not expose the hardware events (e.g. in a virtual machine), or if
+// perf_event_paranoid forbids it. In that case available() is false and
+// read() returns zero counts. Counts of a multiplexed group are scaled
+// with scale_count, and so are estimates.
+class perf_counter_group {
+public:
+    perf_counter_group();
+    ~perf_counter_group();
+
+    perf_counter_group(const perf_counter_group&) = delete;
+    perf_counter_group& operator=(const perf_counter_group&) = delete;
+
+    // Counters that could be opened.
+    bool available() const { return fd_[0]>=0; }
+    bool has_fp_ops() const { return fd_[3]>=0; }
+
+    // Event counts since construction.
+    perf_counts read() const;
+
+private:
+    // File descriptors for cycles (the group leader), instructions,
+    // LLC misses and FP ops; -1 if not open.
+    int fd_[4] = {-1, -1, -1, -1};
+};
+
+// Test whether hardware counters can be opened on the calling thread.
+bool has_perf_counters();
+
+} // namespace hw
+} // namespace arb
@@ -64,6 +64,12 @@ struct bad_probe_id: arbor_exception {
     cell_member_type probe_id;
 };
 
+struct bad_sample_sink: arbor_exception {
+    bad_sample_sink(cell_member_type id, std::size_t width);
+    cell_member_type probe_id;
+    std::size_t width;
+};
+
 struct gj_kind_mismatch: arbor_exception {
     gj_kind_mismatch(cell_gid_type gid_0, cell_gid_type gid_1);
     cell_gid_type gid_0, gid_1;
@@ -146,6 +152,12 @@ struct file_not_found_error: arbor_exception {
     std::string filename;
 };
 
+// Checkpoint errors:
+
+struct bad_checkpoint: arbor_exception {
+    explicit bad_checkpoint(const std::string& msg);
+};
+
 struct bad_catalogue_error: arbor_exception {
     bad_catalogue_error(const std::string& fn, const std::string& call);
     std::string filename;
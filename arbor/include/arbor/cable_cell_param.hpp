@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <unordered_map>
@@ -274,6 +275,47 @@ struct cable_cell_global_properties {
     // True => combine linear synapses for performance.
     bool coalesce_synapses = true;
 
+    // True => sum the weights of events delivered at the same (binned) time
+    // to the same target, for synapses with a NET_RECEIVE linear in the weight.
+    bool aggregate_events = false;
+
+    // Approximate working set size in bytes of a tile of cells in tiled time
+    // stepping, which runs each time step for one tile before the next;
+    // typically the size of the L2 cache. Zero => no tiling.
+    std::size_t tile_size_bytes = 0;
+
+    // Fused density mechanisms: density mechanisms with exactly the same CVs
+    // in a cell group run together, a block of this many CVs at a time, so
+    // that the voltage, current and ion data of a block stay in cache from
+    // one mechanism to the next. Zero => each mechanism runs over all of its
+    // CVs in turn. Not used with tiled time stepping.
+    std::size_t fused_density_block_size = 256;
+
+    // Adaptive time stepping: if positive, the time step of each integration
+    // domain is chosen between adaptive_dt_min and the simulation dt so that
+    // the estimated local error in membrane voltage per step is about this
+    // value [mV]. Zero => fixed time steps.
+    double adaptive_dt_tolerance = 0;
+    double adaptive_dt_min = 1e-3; // [ms]
+
+    // Implicit gap junctions: true => gap junction currents are integrated
+    // implicitly with the membrane voltage, by iterating the voltage solve
+    // over cells coupled by gap junctions until the voltage at each gap
+    // junction changes by at most gap_junction_tolerance [mV], or for at most
+    // gap_junction_max_iterations solves per time step.
+    bool implicit_gap_junctions = false;
+    double gap_junction_tolerance = 1e-6; // [mV]
+    unsigned gap_junction_max_iterations = 100;
+
+    // Steady-state initialization: true => on reset, the membrane voltage and
+    // mechanism state are iterated to a fixed point of the voltage equation
+    // without stimuli, starting from the initial membrane potential, until the
+    // voltage changes by at most steady_state_tolerance [mV]; it is an error if
+    // this takes more than steady_state_max_iterations iterations.
+    bool steady_state_initialization = false;
+    double steady_state_tolerance = 1e-6; // [mV]
+    unsigned steady_state_max_iterations = 100;
+
     // Available ion species, together with charge.
     std::unordered_map<std::string, int> ion_species = {
         {"na", 1},
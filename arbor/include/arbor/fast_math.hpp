@@ -0,0 +1,130 @@
+#pragma once
+
+// Fast approximations of exp, expm1, log, exprelr and pow.
+//
+// The accuracy level L selects the polynomial approximations in
+// arbor/simd/approx.hpp:
+//
+//     L=1: maximum error of 3 ulp, comparable to the C library;
+//     L=2: maximum relative error of 1e-6, about single precision.
+//
+// The error of pow(x, y) = exp(y·log(x)) grows with |y·log(x)|.
+//
+// Arguments outside the domain of the approximations (zero, negative,
+// subnormal, infinite or NaN arguments to log and pow) are handed to the
+// C library. These functions are used in place of their std counterparts
+// in CPU mechanism kernels generated by modcc with --fast-math-level L.
+
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <arbor/simd/approx.hpp>
+
+namespace arb {
+namespace math {
+
+namespace impl {
+    template <std::size_t N>
+    double horner(double x, const double (&a)[N]) {
+        double r = a[N-1];
+        for (std::size_t i = N-1; i>0; --i) {
+            r = r*x+a[i-1];
+        }
+        return r;
+    }
+
+    // 2^n for -1022 ≤ n ≤ 1023.
+    inline double exp2int(int n) {
+        std::uint64_t bits = std::uint64_t(n+1023)<<52;
+        double r;
+        std::memcpy(&r, &bits, sizeof r);
+        return r;
+    }
+}
+
+// exp(x) = 2^n·exp(g), with g = x - n·ln(2) and |g| ≤ ln(2)/2. The scaling
+// by 2^n is split in two so that each factor is a normal double.
+
+template <unsigned L>
+double fast_exp(double x) {
+    namespace A = ::arb::simd::detail;
+
+    if (!(x<=A::exp_maxarg)) return x+HUGE_VAL; // +inf or NaN
+    if (x<A::exp_minarg) return 0;
+
+    double n = std::floor(A::ln2inv*x+0.5);
+    double g = x-n*A::ln2C1-n*A::ln2C2;
+    int k = n;
+
+    double expg = 1+g*impl::horner(g, A::fast_approx<L>::Pexp);
+    return expg*impl::exp2int(k/2)*impl::exp2int(k-k/2);
+}
+
+// expm1(x) = 2^n·(exp(g)-1) + 2^n-1, evaluated as s·((t-1/s) + t·(exp(g)-1))
+// with 2^n = s·t. For |x| < ln(2)/2, n is zero and the result is g·Pexp(g)
+// without cancellation.
+
+template <unsigned L>
+double fast_expm1(double x) {
+    namespace A = ::arb::simd::detail;
+
+    if (!(x<=A::exp_maxarg)) return x+HUGE_VAL; // +inf or NaN
+    if (x<A::expm1_minarg) return -1;
+
+    double n = std::floor(A::ln2inv*x+0.5);
+    double g = x-n*A::ln2C1-n*A::ln2C2;
+    int k = n;
+
+    double expgm1 = g*impl::horner(g, A::fast_approx<L>::Pexp);
+    double s = impl::exp2int(k/2), t = impl::exp2int(k-k/2);
+    return s*((t-impl::exp2int(-k/2))+t*expgm1);
+}
+
+// log(x) = e·ln(2) + log(c) + log(1+r), with x = 2^e·u, √½ ≤ u < √2, and
+// u = c·(1+r) for the tabulated c nearest to u. Both u-c and the leading
+// term e·ln2C3 + log(c) are exact.
+
+template <unsigned L>
+double fast_log(double x) {
+    namespace A = ::arb::simd::detail;
+
+    if (!(x>=A::log_minarg && x<HUGE_VAL)) return std::log(x);
+
+    // Subtracting the representation of √½ leaves e in the exponent field;
+    // subtracting e from the exponent of x gives u.
+    std::uint64_t bits;
+    std::memcpy(&bits, &x, sizeof bits);
+    std::uint64_t t = bits-0x3fe6a09e667f3bcdull;
+    int e = int(std::int64_t(t)>>52);
+    bits -= t&0xfff0000000000000ull;
+    double u;
+    std::memcpy(&u, &bits, sizeof u);
+
+    // Round (u-1)·128 to an integer by adding and subtracting 1.5·2^52.
+    constexpr double round_int = 0x1.8p52;
+    double j = ((u-1)*128+round_int)-round_int;
+    int i = int(j)-A::log_table_jmin;
+    double r = (u-(1+j*(1./128)))*A::log_invc[i];
+
+    double w = e*A::ln2C3+A::log_logc[i];
+    return w+(r+((e*A::ln2C4+A::log_logc_lo[i])+r*r*impl::horner(r, A::fast_approx<L>::Plog)));
+}
+
+// Value of x/(exp(x)-1); see arb::math::exprelr.
+
+template <unsigned L>
+double fast_exprelr(double x) {
+    return (1.==1.+x)? 1.: x/fast_expm1<L>(x);
+}
+
+template <unsigned L>
+double fast_pow(double x, double y) {
+    if (!(x>0 && x<HUGE_VAL)) return std::pow(x, y);
+    return fast_exp<L>(y*fast_log<L>(x));
+}
+
+} // namespace math
+} // namespace arb
@@ -25,6 +25,12 @@
 //    is used with `multi_event_stream`.
 //    Default implementation returns `e.data` for an event `e`.
 //
+// 4. event_key(const Event&):
+//
+//    Returns a key (an unsigned index type) by which the events
+//    of each stream may be further partitioned, for use with
+//    `multi_event_stream`. Default implementation returns zero.
+//
 // The type aliases event_time_type<Event> and event_index_type<Event>
 // give the corresponding return types.
 //
@@ -58,6 +64,11 @@ auto event_data(const Event& ev) {
     return ev.data;
 }
 
+template <typename Event>
+unsigned event_key(const Event&) {
+    return 0;
+}
+
 struct event_time_less {
     template <typename T, typename Event, typename = std::enable_if_t<std::is_floating_point<T>::value>>
     bool operator() (T l, const Event& r) {
@@ -71,6 +71,11 @@ struct mechanism_info {
     bool linear = false;
 
     bool post_events = false;
+
+    // True if the effect of an event on the mechanism state is linear in the
+    // event weight, so that events delivered to the same target at the same
+    // time can be aggregated by summing their weights.
+    bool linear_net_receive = false;
 };
 
 } // namespace arb
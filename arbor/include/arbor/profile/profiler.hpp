@@ -26,6 +26,14 @@ struct profile {
     // the accumulated time spent in each region.
     std::vector<double> times;
 
+    // the accumulated hardware event counts in each region, if arbor was
+    // built with ARB_WITH_PERF_COUNTERS and the counters could be opened.
+    // Each vector is empty if the corresponding counter is not available.
+    std::vector<std::uint64_t> cycles;
+    std::vector<std::uint64_t> instructions;
+    std::vector<std::uint64_t> llc_misses;
+    std::vector<std::uint64_t> fp_ops;
+
     // the number of threads for which profiling information was recorded.
     std::size_t num_threads;
 
@@ -42,6 +42,28 @@ using sampler_function = std::function<
 
 using sampler_association_handle = std::size_t;
 
+// Sample sinks are an alternative to sampler functions for a single probe:
+// sample values are written by the cell group directly into a user-supplied
+// ring buffer, as one contiguous row of `width` values per sample time.
+//
+// The buffers must remain valid while the sink is registered.
+
+struct sample_ring_buffer {
+    time_type* times = nullptr; // `capacity` sample times
+    double* values = nullptr;   // `capacity*width` sample values, row-major
+    std::size_t width = 0;      // number of values per sample
+    std::size_t capacity = 0;   // number of rows
+};
+
+// Called after samples have been written, with the newly written rows
+// [first, first+count), taken modulo the ring capacity.
+using sample_commit_function = std::function<
+    void (probe_metadata,
+          const sample_ring_buffer&,
+          std::size_t,          // index of first new row
+          std::size_t           // number of new rows
+         )>;
+
 enum class sampling_policy {
     lax,
     exact
@@ -81,6 +81,192 @@ constexpr double Q2log = 8.29875266912776603211e1;
 constexpr double Q3log = 4.52279145837532221105e1;
 constexpr double Q4log = 1.12873587189167450590e1;
 
+// Fast approximations (see arbor/fast_math.hpp):
+//
+// Polynomial approximations at accuracy level L:
+//
+//     exp(g) ≈ 1 + g·Pexp(g)           for |g| ≤ ln(2)/2,
+//     log(1+r) ≈ r + r²·Plog(r)        for |r| < 1/180,
+//     log(u) ≈ 2z + 2z³·Patanh(z²)     for z = (u-1)/(u+1), √½ ≤ u < √2.
+//
+// The exp and Patanh coefficients are by Chebyshev interpolation; level 1
+// has truncation errors below 1e-16 (exp, degree 11) and 1e-17 (log,
+// degree 15), and level 2 below 2.1e-7 (exp, degree 5) and 2.8e-9 (log,
+// degree 7). The Plog coefficients are those of the Taylor series, with
+// truncation errors below 2e-19 (degree 7) and 3e-10 (degree 3).
+//
+// The scalar log uses Plog after a table reduction; the SIMD
+// implementations use Patanh, with z computed without division by
+// Newton iteration for 1/(u+1).
+//
+// The logarithm of u in [√½, √2) is reduced to log(1+r) with
+// u = c·(1+r), where c = 1 + j/128 is the nearest multiple of 1/128
+// to u, for j = log_table_jmin, ..., log_table_jmax. The tables, indexed by
+// j-log_table_jmin, hold 1/c, and log(c) as a multiple of 2^-43 and a
+// correction; e·ln2C3 + log(c) is then exact for any exponent e.
+
+constexpr int log_table_jmin = -37;
+constexpr int log_table_jmax = 53;
+
+inline constexpr double log_invc[] = {
+    1.4065934065934067, 1.391304347826087, 1.3763440860215055,
+    1.3617021276595744, 1.3473684210526315, 1.3333333333333333,
+    1.3195876288659794, 1.3061224489795917, 1.292929292929293, 1.28,
+    1.2673267326732673, 1.2549019607843137, 1.2427184466019416,
+    1.2307692307692308, 1.2190476190476192, 1.2075471698113207,
+    1.1962616822429906, 1.1851851851851851, 1.1743119266055047,
+    1.1636363636363636, 1.1531531531531531, 1.1428571428571428,
+    1.1327433628318584, 1.1228070175438596, 1.1130434782608696,
+    1.103448275862069, 1.0940170940170941, 1.0847457627118644,
+    1.0756302521008403, 1.0666666666666667, 1.0578512396694215,
+    1.0491803278688525, 1.0406504065040652, 1.032258064516129, 1.024,
+    1.0158730158730158, 1.0078740157480315, 1.0, 0.9922480620155039,
+    0.9846153846153847, 0.9770992366412213, 0.9696969696969697,
+    0.9624060150375939, 0.9552238805970149, 0.9481481481481482,
+    0.9411764705882353, 0.9343065693430657, 0.927536231884058,
+    0.920863309352518, 0.9142857142857143, 0.9078014184397163,
+    0.9014084507042254, 0.8951048951048951, 0.8888888888888888,
+    0.8827586206896552, 0.8767123287671232, 0.8707482993197279,
+    0.8648648648648649, 0.8590604026845637, 0.8533333333333334,
+    0.847682119205298, 0.8421052631578947, 0.8366013071895425,
+    0.8311688311688312, 0.8258064516129032, 0.8205128205128205,
+    0.8152866242038217, 0.810126582278481, 0.8050314465408805, 0.8,
+    0.7950310559006211, 0.7901234567901234, 0.7852760736196319,
+    0.7804878048780488, 0.7757575757575758, 0.7710843373493976,
+    0.7664670658682635, 0.7619047619047619, 0.757396449704142,
+    0.7529411764705882, 0.7485380116959064, 0.7441860465116279,
+    0.7398843930635838, 0.735632183908046, 0.7314285714285714,
+    0.7272727272727273, 0.7231638418079096, 0.7191011235955056,
+    0.7150837988826816, 0.7111111111111111, 0.7071823204419889
+};
+
+inline constexpr double log_logc[] = {
+    -0.3411707574027787, -0.33024168687052224, -0.31943077076641657,
+    -0.30873548164959175, -0.29815337231912054, -0.28768207245173016,
+    -0.27731928541618345, -0.2670627852490952, -0.2569104137850218,
+    -0.2468600779315011, -0.2369097470783572, -0.22705745063535687,
+    -0.21730127569003344, -0.20763936477828793, -0.19806991376208316,
+    -0.18859116980752333, -0.17920142945774842, -0.16989903679541385,
+    -0.16068238169043525, -0.15154989812720032, -0.14250006260726877,
+    -0.13353139262449076, -0.12464244520731427, -0.11583181552509814,
+    -0.10709813555638448, -0.09844007281321865, -0.08985632912185793,
+    -0.08134563945395712, -0.07290677080811747, -0.0645385211375924,
+    -0.056239718322899535, -0.048009219186383234, -0.039845908547249564,
+    -0.03174869831457272, -0.023716526617363343, -0.01574835696817445,
+    -0.007843177461040796, 0.0, 0.0077821404420319595, 0.015504186535963527,
+    0.023167059281490765, 0.03077165866670839, 0.038318864302141264,
+    0.045809536031242715, 0.053244514518837605, 0.06062462181648698,
+    0.06795066190852594, 0.07522342123763792, 0.08244366921110213,
+    0.089612158689647, 0.09672962645856842, 0.10379679368168127,
+    0.11081436634026431, 0.11778303565643, 0.12470347850091912,
+    0.131576357788731, 0.13840232285906495, 0.1451820098444614,
+    0.15191604202584585, 0.15860503017665906, 0.1652495728952772,
+    0.17185025692663203, 0.1784076574728033, 0.18492233849406148,
+    0.19139485299967873, 0.19782574332987224, 0.2042155414286526,
+    0.21056476910735, 0.21687393830063684, 0.22314355131425145,
+    0.22937410106487732, 0.23556607131274632, 0.2417199368871934,
+    0.2478361639045943, 0.25391520998095984, 0.25995752443691345,
+    0.2659635484970977, 0.2719337154836694, 0.27786845100342816,
+    0.28376817313062475, 0.28963329258306203, 0.2954642128938758,
+    0.3012613305781997, 0.3070250352949415, 0.31275571000389846,
+    0.31845373111855224, 0.32411946865420305, 0.3297532863724655,
+    0.3353555419211034, 0.34092658697056777, 0.3464667673462145
+};
+
+inline constexpr double log_logc_lo[] = {
+    1.156568624616423e-14, -5.4612144489920215e-14, 5.534326352070679e-14,
+    -2.1522127491642888e-14, 4.4204083338755686e-14, -5.076326383153408e-14,
+    -5.089628039500759e-14, 4.996736502345936e-14, -5.465121253624792e-15,
+    -2.4688324156011588e-14, -5.015686013791602e-16, 1.078736749871691e-14,
+    5.204008743405884e-14, 4.3425422595242564e-14, -1.0634128304268335e-14,
+    -2.6693431578015818e-14, 3.742530094732263e-14, 1.6376276414097503e-14,
+    -3.821577743916796e-14, -6.157896229122976e-16, -1.4256439478199035e-14,
+    -3.1859736349078334e-14, 3.767012502308738e-14, -2.3568822182038756e-14,
+    1.7376727386423858e-14, -3.3871241029241416e-14, -3.1218748807418837e-15,
+    4.713370778300984e-15, 2.9690894981172655e-14, 2.1225608044809997e-14,
+    2.345674491018699e-14, 2.262629393030674e-14, 4.9893776716773285e-14,
+    -7.580310369375161e-15, 4.730054772033249e-14, 3.527980389655325e-14,
+    1.4902732911301337e-14, 0.0, 2.298941004620351e-14, 1.7274567499706107e-15,
+    4.361324067851568e-14, 4.529814257790929e-14, -4.6652946995830086e-15,
+    5.148849572685811e-14, -2.532168943117445e-14, -5.213620639136504e-14,
+    -1.8195060030168815e-14, -5.0396178134370583e-14, -2.7541708360737882e-14,
+    4.012913552726574e-14, -1.7306161136093256e-14, -3.7700471749674615e-14,
+    2.5799991283069902e-14, -4.654729747598445e-14, 3.811763084710266e-14,
+    -1.1729485484531301e-14, 5.4183331379008994e-14, 3.6506824353335045e-14,
+    -3.879296723063646e-15, -2.0472357800461955e-14, 2.99659267292569e-14,
+    2.7194441649495324e-14, 1.5003333854266542e-14, -4.9485167661250996e-14,
+    -4.9278276214647115e-14, 4.7641388950792196e-14, 3.827767260205414e-14,
+    -3.6507188831790577e-16, -2.2477465222466186e-14, -4.169796584527195e-14,
+    -3.149265065191484e-14, 2.0592242769647135e-14, -4.8230289429940886e-14,
+    -1.3029797173308663e-14, 3.600176732637335e-15, 1.2621729398885316e-14,
+    4.025092402293806e-14, -2.7643769993528702e-14, 2.814323765595281e-14,
+    1.9852665484979036e-14, -1.9352855826489123e-14, -3.993416384387844e-14,
+    -3.7923164802093147e-14, -2.9655274673691784e-14, -1.5688303180062087e-15,
+    -1.7625431312172662e-14, 8.929337133850617e-15, 2.500123826022799e-15,
+    3.443525940775045e-14, 2.544157440035963e-14, -5.929407345889625e-15
+};
+
+template <unsigned L>
+struct fast_approx;
+
+template <>
+struct fast_approx<1> {
+    static constexpr double Pexp[] = {
+        1.0,
+        0.5000000000000006,
+        0.1666666666666667,
+        0.04166666666657314,
+        0.008333333333326141,
+        0.0013888888932488599,
+        0.00019841269874800493,
+        2.4801504346997686e-05,
+        2.7557255425746435e-06,
+        2.7626357241447223e-07,
+        2.510520637395701e-08
+    };
+
+    static constexpr double Plog[] = {
+        -1./2,
+        1./3,
+        -1./4,
+        1./5,
+        -1./6,
+        1./7
+    };
+
+    static constexpr double Patanh[] = {
+        0.3333333333333335,
+        0.19999999999949752,
+        0.14285714312987743,
+        0.1111110556739754,
+        0.09091444562630861,
+        0.07665860800278021,
+        0.07308224842521703
+    };
+};
+
+template <>
+struct fast_approx<2> {
+    static constexpr double Pexp[] = {
+        1.0,
+        0.4999937213862548,
+        0.1666657702559799,
+        0.04187564445233737,
+        0.008363173074513711
+    };
+
+    static constexpr double Plog[] = {
+        -1./2,
+        1./3
+    };
+
+    static constexpr double Patanh[] = {
+        0.3333334251978793,
+        0.1999439028301099,
+        0.14789974695986394
+    };
+};
+
 } // namespace detail
 } // namespace simd
 } // namespace arb
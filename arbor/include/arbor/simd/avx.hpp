@@ -5,6 +5,7 @@
 #ifdef __AVX__
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <immintrin.h>
 
@@ -167,6 +168,10 @@ struct avx_int4: implbase<avx_int4> {
         std::memcpy(y, &p, 4);
     }
 
+    static bool mask_any(const __m128i& m) {
+        return _mm_movemask_epi8(m);
+    }
+
     static __m128i mask_copy_from(const bool* w) {
         __m128i r;
         std::memcpy(&r, w, 4);
@@ -342,6 +347,10 @@ struct avx_double4: implbase<avx_double4> {
         avx_int4::mask_copy_to(lo_epi32(_mm256_castpd_si256(m)), y);
     }
 
+    static bool mask_any(const __m256d& m) {
+        return _mm256_movemask_pd(m);
+    }
+
     static __m256d mask_copy_from(const bool* w) {
         __m128i zero = _mm_setzero_si128();
 
@@ -893,7 +902,124 @@ struct avx2_double4: avx_double4 {
                 r)));
     }
 
+    // Fast approximations at accuracy level L; refer to arbor/fast_math.hpp
+    // for the scalar implementations. Scaling by 2^n is split into two
+    // factors 2^h·2^(n-h) so that each is a normal double.
+
+    template <unsigned L>
+    static __m256d fast_exp(const __m256d& x) {
+        auto is_large = cmp_gt(x, broadcast(exp_maxarg));
+        auto is_small = cmp_lt(x, broadcast(exp_minarg));
+        auto is_nan = _mm256_cmp_pd(x, x, cmp_unord_q);
+
+        auto n = _mm256_floor_pd(fma(broadcast(ln2inv), x, broadcast(0.5)));
+
+        auto g = fma(n, broadcast(-ln2C1), x);
+        g = fma(n, broadcast(-ln2C2), g);
+
+        auto expg = fma(g, horner(g, fast_approx<L>::Pexp), broadcast(1));
+
+        auto k = _mm256_cvtpd_epi32(n);
+        auto h = _mm_srai_epi32(k, 1);
+        auto result = mul(mul(expg, exp2int(h)), exp2int(_mm_sub_epi32(k, h)));
+
+        return
+            ifelse(is_large, broadcast(HUGE_VAL),
+            ifelse(is_small, broadcast(0),
+            ifelse(is_nan, broadcast(NAN),
+                   result)));
+    }
+
+    template <unsigned L>
+    static __m256d fast_expm1(const __m256d& x) {
+        auto is_large = cmp_gt(x, broadcast(exp_maxarg));
+        auto is_small = cmp_lt(x, broadcast(expm1_minarg));
+        auto is_nan = _mm256_cmp_pd(x, x, cmp_unord_q);
+
+        auto n = _mm256_floor_pd(fma(broadcast(ln2inv), x, broadcast(0.5)));
+
+        auto g = fma(n, broadcast(-ln2C1), x);
+        g = fma(n, broadcast(-ln2C2), g);
+
+        auto expgm1 = mul(g, horner(g, fast_approx<L>::Pexp));
+
+        // result = 2^h·((2^(n-h) - 2^-h) + 2^(n-h)·expgm1), which is
+        // exactly expgm1 when n is zero.
+
+        auto k = _mm256_cvtpd_epi32(n);
+        auto h = _mm_srai_epi32(k, 1);
+        auto s = exp2int(h);
+        auto t = exp2int(_mm_sub_epi32(k, h));
+        auto sinv = exp2int(_mm_sub_epi32(_mm_setzero_si128(), h));
+        auto result = mul(s, fma(t, expgm1, sub(t, sinv)));
+
+        return
+            ifelse(is_large, broadcast(HUGE_VAL),
+            ifelse(is_small, broadcast(-1),
+            ifelse(is_nan, broadcast(NAN),
+                   result)));
+    }
+
+    template <unsigned L>
+    static __m256d fast_log(const __m256d& x) {
+        auto is_large = cmp_geq(x, broadcast(HUGE_VAL));
+        auto is_small = cmp_lt(x, broadcast(log_minarg));
+        auto is_domainerr = _mm256_cmp_pd(x, broadcast(0), cmp_nge_uq);
+
+        __m256d g = _mm256_cvtepi32_pd(logb_normal(x));
+        __m256d u = fraction_normal(x);
+
+        __m256d one = broadcast(1.);
+        __m256d half = broadcast(0.5);
+        auto gtsqrt2 = cmp_geq(u, broadcast(sqrt2));
+        g = ifelse(gtsqrt2, add(g, one), g);
+        u = ifelse(gtsqrt2, mul(u, half), u);
+
+        // z = (u-1)/(u+1) from a linear estimate of 1/(u+1) with relative
+        // error below 0.015, refined by a third order step, a Newton step
+        // at level 1, and a correction of the quotient.
+        auto n = sub(u, one);
+        auto d = add(u, one);
+        auto y = _mm256_fnmadd_pd(d, broadcast(0.23901599922648414), broadcast(0.9850615000483447));
+        auto e = _mm256_fnmadd_pd(d, y, one);
+        y = fma(y, fma(e, e, e), y);
+        if (L==1) y = fma(y, _mm256_fnmadd_pd(d, y, one), y);
+        auto z = mul(n, y);
+        z = fma(_mm256_fnmadd_pd(d, z, n), y, z);
+        auto zz = mul(z, z);
+
+        auto r = mul(add(z, z), fma(zz, horner(zz, fast_approx<L>::Patanh), one));
+        r = fma(g, broadcast(ln2C4), r);
+        r = fma(g, broadcast(ln2C3), r);
+
+        return
+            ifelse(is_domainerr, broadcast(NAN),
+            ifelse(is_large, broadcast(HUGE_VAL),
+            ifelse(is_small, broadcast(-HUGE_VAL),
+                r)));
+    }
+
+    // Lanes with x not positive and finite are computed with pow.
+
+    template <unsigned L>
+    static __m256d fast_pow(const __m256d& x, const __m256d& y) {
+        auto is_pos_finite = logical_and(
+            cmp_gt(x, zero()), cmp_lt(x, broadcast(HUGE_VAL)));
+
+        auto r = fast_exp<L>(mul(y, fast_log<L>(x)));
+        return _mm256_movemask_pd(is_pos_finite)==0xf? r: ifelse(is_pos_finite, r, pow(x, y));
+    }
+
 protected:
+    template <std::size_t N>
+    static __m256d horner(__m256d x, const double (&a)[N]) {
+        __m256d r = broadcast(a[N-1]);
+        for (std::size_t i = N-1; i>0; --i) {
+            r = fma(x, r, broadcast(a[i-1]));
+        }
+        return r;
+    }
+
     static __m128i lo_epi32(__m256i a) {
         a = _mm256_shuffle_epi32(a, 0x08);
         a = _mm256_permute4x64_epi64(a, 0x08);
@@ -5,6 +5,7 @@
 #ifdef __AVX512F__
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <immintrin.h>
 
@@ -197,6 +198,10 @@ struct avx512_mask8: implbase<avx512_mask8> {
         copy_to(m, y);
     }
 
+    static bool mask_any(const __mmask8& m) {
+        return m;
+    }
+
     static __mmask8 mask_copy_from(const bool* y) {
         return copy_from(y);
     }
@@ -718,7 +723,115 @@ auto odd = mul(g, horner(gg, P0exp, P1exp, P2exp));
     }
 #endif
 
+    // Fast approximations at accuracy level L; refer to arbor/fast_math.hpp
+    // for the scalar implementations.
+
+    template <unsigned L>
+    static __m512d fast_exp(const __m512d& x) {
+        auto is_large = cmp_gt(x, broadcast(exp_maxarg));
+        auto is_small = cmp_lt(x, broadcast(exp_minarg));
+
+        auto n = _mm512_floor_pd(add(mul(broadcast(ln2inv), x), broadcast(0.5)));
+
+        auto g = fma(n, broadcast(-ln2C1), x);
+        g = fma(n, broadcast(-ln2C2), g);
+
+        auto expg = fma(g, horner(g, fast_approx<L>::Pexp), broadcast(1));
+
+        return
+            ifelse(is_large, broadcast(HUGE_VAL),
+            ifelse(is_small, broadcast(0),
+                   _mm512_scalef_pd(expg, n)));
+    }
+
+    template <unsigned L>
+    static __m512d fast_expm1(const __m512d& x) {
+        auto is_large = cmp_gt(x, broadcast(exp_maxarg));
+        auto is_small = cmp_lt(x, broadcast(expm1_minarg));
+
+        auto half = broadcast(0.5);
+        auto one = broadcast(1.);
+
+        auto n = _mm512_floor_pd(add(mul(broadcast(ln2inv), x), half));
+        auto nz = cmp_eq(n, broadcast(0));
+
+        auto g = fma(n, broadcast(-ln2C1), x);
+        g = fma(n, broadcast(-ln2C2), g);
+
+        auto expgm1 = mul(g, horner(g, fast_approx<L>::Pexp));
+
+        // As for expm1: result = 2 * ( 2^(n-1)*expgm1 + (2^(n-1)-0.5) ).
+
+        auto nm1 = sub(n, one);
+
+        auto result =
+            _mm512_scalef_pd(
+                add(sub(_mm512_scalef_pd(one, nm1), half),
+                    _mm512_scalef_pd(expgm1, nm1)),
+                one);
+
+        return
+            ifelse(is_large, broadcast(HUGE_VAL),
+            ifelse(is_small, broadcast(-1),
+            ifelse(nz, expgm1, result)));
+    }
+
+    template <unsigned L>
+    static __m512d fast_log(const __m512d& x) {
+        auto is_large = cmp_geq(x, broadcast(HUGE_VAL));
+        auto is_small = cmp_lt(x, broadcast(log_minarg));
+        is_small = avx512_mask8::logical_and(is_small, cmp_geq(x, broadcast(0)));
+
+        __m512d g = _mm512_getexp_pd(x);
+        __m512d u = _mm512_getmant_pd(x, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_nan);
+
+        __m512d one = broadcast(1.);
+        __m512d half = broadcast(0.5);
+        auto gtsqrt2 = cmp_geq(u, broadcast(sqrt2));
+        g = ifelse(gtsqrt2, add(g, one), g);
+        u = ifelse(gtsqrt2, mul(u, half), u);
+
+        // z = (u-1)/(u+1) from a 14-bit estimate of 1/(u+1), refined
+        // by a Newton step and a correction of the quotient.
+        auto n = sub(u, one);
+        auto d = add(u, one);
+        auto y = _mm512_rcp14_pd(d);
+        y = fma(y, _mm512_fnmadd_pd(d, y, one), y);
+        auto z = mul(n, y);
+        z = fma(_mm512_fnmadd_pd(d, z, n), y, z);
+        auto zz = mul(z, z);
+
+        auto r = mul(add(z, z), fma(zz, horner(zz, fast_approx<L>::Patanh), one));
+        r = fma(g, broadcast(ln2C4), r);
+        r = fma(g, broadcast(ln2C3), r);
+
+        return
+            ifelse(is_large, broadcast(HUGE_VAL),
+            ifelse(is_small, broadcast(-HUGE_VAL),
+                r));
+    }
+
+    // Lanes with x not positive and finite are computed with pow.
+
+    template <unsigned L>
+    static __m512d fast_pow(const __m512d& x, const __m512d& y) {
+        auto is_pos_finite = avx512_mask8::logical_and(
+            cmp_gt(x, broadcast(0)), cmp_lt(x, broadcast(HUGE_VAL)));
+
+        auto r = fast_exp<L>(mul(y, fast_log<L>(x)));
+        return is_pos_finite==0xff? r: ifelse(is_pos_finite, r, pow(x, y));
+    }
+
 protected:
+    template <std::size_t N>
+    static __m512d horner(__m512d x, const double (&a)[N]) {
+        __m512d r = broadcast(a[N-1]);
+        for (std::size_t i = N-1; i>0; --i) {
+            r = fma(x, r, broadcast(a[i-1]));
+        }
+        return r;
+    }
+
     static inline __m512d horner1(__m512d x, double a0) {
         return add(x, broadcast(a0));
     }
@@ -26,6 +26,10 @@
 // exprelr  | expm1, div, add, cmp_eq, ifelse
 //
 // 'exprelr' is the function x ↦ x/(exp(x)-1).
+//
+// The fast approximations fast_exp<L>, fast_expm1<L>, fast_log<L> and
+// fast_pow<L> default to lane-wise arb::math::fast_exp<L> etc.; fast_exprelr<L>
+// is implemented with fast_expm1<L> as for exprelr.
 
 #include <cstring>
 #include <cmath>
@@ -33,6 +37,7 @@
 #include <iterator>
 #include <type_traits>
 
+#include <arbor/fast_math.hpp>
 #include <arbor/util/compat.hpp>
 
 // Derived class I must at minimum provide:
@@ -379,6 +384,12 @@ struct implbase {
         return I::mask_copy_from(m);
     }
 
+    static bool mask_any(const vector_type& v) {
+        mask_store m;
+        I::mask_copy_to(v, m);
+        return std::any_of(std::begin(m), std::end(m), [](bool b) { return b; });
+    }
+
     template <typename ImplIndex>
     static vector_type gather(tag<ImplIndex>, const scalar_type* p, const typename ImplIndex::vector_type& index) {
         typename ImplIndex::scalar_type o[width];
@@ -532,6 +543,57 @@ struct implbase {
         }
         return I::copy_from(r);
     }
+
+    template <unsigned L>
+    static vector_type fast_exp(const vector_type& s) {
+        store a, r;
+        I::copy_to(s, a);
+
+        for (unsigned i = 0; i<width; ++i) {
+            r[i] = math::fast_exp<L>(a[i]);
+        }
+        return I::copy_from(r);
+    }
+
+    template <unsigned L>
+    static vector_type fast_expm1(const vector_type& s) {
+        store a, r;
+        I::copy_to(s, a);
+
+        for (unsigned i = 0; i<width; ++i) {
+            r[i] = math::fast_expm1<L>(a[i]);
+        }
+        return I::copy_from(r);
+    }
+
+    template <unsigned L>
+    static vector_type fast_log(const vector_type& s) {
+        store a, r;
+        I::copy_to(s, a);
+
+        for (unsigned i = 0; i<width; ++i) {
+            r[i] = math::fast_log<L>(a[i]);
+        }
+        return I::copy_from(r);
+    }
+
+    template <unsigned L>
+    static vector_type fast_exprelr(const vector_type& s) {
+        vector_type ones = I::broadcast(1);
+        return I::ifelse(I::cmp_eq(ones, I::add(ones, s)), ones, I::div(s, I::template fast_expm1<L>(s)));
+    }
+
+    template <unsigned L>
+    static vector_type fast_pow(const vector_type& s, const vector_type &t) {
+        store a, b, r;
+        I::copy_to(s, a);
+        I::copy_to(t, b);
+
+        for (unsigned i = 0; i<width; ++i) {
+            r[i] = math::fast_pow<L>(a[i], b[i]);
+        }
+        return I::copy_from(r);
+    }
 };
 
 } // namespace detail
@@ -88,6 +88,34 @@ ARB_PP_FOREACH(ARB_UNARY_ARITHMETIC_,  neg, abs, sin, cos, exp, log, expm1, expr
 #undef ARB_BINARY_COMPARISON__
 #undef ARB_UNARY_ARITHMETIC_
 
+// Fast approximations with accuracy level L; see arbor/fast_math.hpp.
+
+#define ARB_UNARY_FAST_ARITHMETIC_(name)\
+template <unsigned L, typename Impl>\
+detail::simd_impl<Impl> name(const detail::simd_impl<Impl>& a) {\
+    return detail::simd_impl<Impl>::wrap(Impl::template name<L>(a.value_));\
+};
+
+#define ARB_BINARY_FAST_ARITHMETIC_(name)\
+template <unsigned L, typename Impl>\
+detail::simd_impl<Impl> name(const detail::simd_impl<Impl>& a, detail::simd_impl<Impl> b) {\
+    return detail::simd_impl<Impl>::wrap(Impl::template name<L>(a.value_, b.value_));\
+};\
+template <unsigned L, typename Impl>\
+detail::simd_impl<Impl> name(const detail::simd_impl<Impl>& a, typename detail::simd_impl<Impl>::scalar_type b) {\
+    return detail::simd_impl<Impl>::wrap(Impl::template name<L>(a.value_, Impl::broadcast(b)));\
+};\
+template <unsigned L, typename Impl>\
+detail::simd_impl<Impl> name(const typename detail::simd_impl<Impl>::scalar_type a, detail::simd_impl<Impl> b) {\
+    return detail::simd_impl<Impl>::wrap(Impl::template name<L>(Impl::broadcast(a), b.value_));\
+};
+
+ARB_PP_FOREACH(ARB_BINARY_FAST_ARITHMETIC_, fast_pow)
+ARB_PP_FOREACH(ARB_UNARY_FAST_ARITHMETIC_,  fast_exp, fast_log, fast_expm1, fast_exprelr)
+
+#undef ARB_BINARY_FAST_ARITHMETIC_
+#undef ARB_UNARY_FAST_ARITHMETIC_
+
 template <typename T>
 detail::simd_mask_impl<T> logical_and(const detail::simd_mask_impl<T>& a, detail::simd_mask_impl<T> b) {
     return a && b;
@@ -682,9 +710,26 @@ namespace detail {
         ARB_PP_FOREACH(ARB_DECLARE_BINARY_COMPARISON_, cmp_eq, cmp_neq, cmp_lt, cmp_leq, cmp_gt, cmp_geq)
         ARB_PP_FOREACH(ARB_DECLARE_UNARY_ARITHMETIC_,  neg, abs, sin, cos, exp, log, expm1, exprelr)
 
+        #define ARB_DECLARE_UNARY_FAST_ARITHMETIC_(name)\
+        template <unsigned L, typename T>\
+        friend simd_impl<T> arb::simd::name(const simd_impl<T>& a);
+
+        #define ARB_DECLARE_BINARY_FAST_ARITHMETIC_(name)\
+        template <unsigned L, typename T>\
+        friend simd_impl<T> arb::simd::name(const simd_impl<T>& a, simd_impl<T> b);\
+        template <unsigned L, typename T>\
+        friend simd_impl<T> arb::simd::name(const simd_impl<T>& a, typename simd_impl<T>::scalar_type b);\
+        template <unsigned L, typename T>\
+        friend simd_impl<T> arb::simd::name(const typename simd_impl<T>::scalar_type a, simd_impl<T> b);
+
+        ARB_PP_FOREACH(ARB_DECLARE_BINARY_FAST_ARITHMETIC_, fast_pow)
+        ARB_PP_FOREACH(ARB_DECLARE_UNARY_FAST_ARITHMETIC_,  fast_exp, fast_log, fast_expm1, fast_exprelr)
+
         #undef ARB_DECLARE_UNARY_ARITHMETIC_
         #undef ARB_DECLARE_BINARY_ARITHMETIC_
         #undef ARB_DECLARE_BINARY_COMPARISON_
+        #undef ARB_DECLARE_UNARY_FAST_ARITHMETIC_
+        #undef ARB_DECLARE_BINARY_FAST_ARITHMETIC_
 
         template <typename T>
         friend simd_impl<T> arb::simd::fma(const simd_impl<T> a, simd_impl<T> b, simd_impl<T> c);
@@ -789,6 +834,12 @@ namespace detail {
             value_ = Impl::mask_copy_from(pi.p);
         }
 
+        // Reductions (horizontal operations).
+
+        bool any() const {
+            return Impl::mask_any(value_);
+        }
+
         // Array subscript operations.
 
         struct reference {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <iosfwd>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -29,12 +30,29 @@ public:
 
     time_type run(time_type tfinal, time_type dt);
 
+    // Write the state of the simulation at the end of the last call to `run`
+    // in a compact binary format, or restore it from such a checkpoint. The
+    // simulation restored into must be built from the same recipe and domain
+    // decomposition as the simulation that wrote the checkpoint; samplers and
+    // spike callbacks are not included. With a distributed context, each rank
+    // writes and restores the state of its own cell groups.
+    void checkpoint(std::ostream& out) const;
+    void restore(std::istream& in);
+
     // Note: sampler functions may be invoked from a different thread than that
     // which called the `run` method.
 
     sampler_association_handle add_sampler(cell_member_predicate probe_ids,
         schedule sched, sampler_function f, sampling_policy policy = sampling_policy::lax);
 
+    // Write samples of the probe with the given id and index directly into the
+    // ring buffer, invoking `commit` after new rows have been written. The
+    // association is removed with `remove_sampler`.
+
+    sampler_association_handle add_sample_sink(cell_member_type probe_id, unsigned index,
+        schedule sched, sample_ring_buffer ring, sample_commit_function commit,
+        sampling_policy policy = sampling_policy::lax);
+
     void remove_sampler(sampler_association_handle);
 
     void remove_all_samplers();
@@ -1,5 +1,6 @@
 #include <arbor/arbexcept.hpp>
 
+#include "checkpoint.hpp"
 #include "label_resolution.hpp"
 #include "lif_cell_group.hpp"
 #include "profile/profiler_macro.hpp"
@@ -58,19 +59,49 @@ void lif_cell_group::clear_spikes() {
     spikes_.clear();
 }
 
+void lif_cell_group::write_checkpoint(checkpoint_writer& w) const {
+    w.write_seq(last_time_updated_);
+    for (auto& cell: cells_) {
+        w.write(cell.V_m);
+    }
+    w.write<std::uint64_t>(binners_.size());
+    for (auto& b: binners_) {
+        b.write_checkpoint(w);
+    }
+}
+
+void lif_cell_group::read_checkpoint(checkpoint_reader& r, time_type) {
+    reset();
+
+    r.read_seq(last_time_updated_);
+    for (auto& cell: cells_) {
+        r.read(cell.V_m);
+    }
+    if (r.read<std::uint64_t>()!=binners_.size()) {
+        throw bad_checkpoint("cell count mismatch");
+    }
+    for (auto& b: binners_) {
+        b.read_checkpoint(r);
+    }
+}
+
 // TODO: implement sampler
 void lif_cell_group::add_sampler(sampler_association_handle h, cell_member_predicate probe_ids,
                                     schedule sched, sampler_function fn, sampling_policy policy) {}
 void lif_cell_group::remove_sampler(sampler_association_handle h) {}
 void lif_cell_group::remove_all_samplers() {}
 
-// TODO: implement binner_
 void lif_cell_group::set_binning_policy(binning_kind policy, time_type bin_interval) {
+    binners_.clear();
+    binners_.resize(gids_.size(), event_binner(policy, bin_interval));
 }
 
 void lif_cell_group::reset() {
     spikes_.clear();
     util::fill(last_time_updated_, 0.);
+    for (auto& b: binners_) {
+        b.reset();
+    }
 }
 
 // Advances a single cell (lid) with the exact solution (jumps can be arbitrary).
@@ -79,19 +110,24 @@ void lif_cell_group::advance_cell(time_type tfinal, time_type dt, cell_gid_type
     // Current time of last update.
     auto t = last_time_updated_[lid];
     auto& cell = cells_[lid];
+    auto& binner = binners_[lid];
     const auto n_events = event_lane.size();
 
     // Integrate until tfinal using the exact solution of membrane voltage differential equation.
     for (unsigned i=0; i<n_events; ++i ) {
         auto& ev = event_lane[i];
-        const auto time = ev.time;
-        auto weight = ev.weight;
 
-        if (time < t) continue;        // skip event if a neuron is in refactory period
-        if (time >= tfinal) break;     // end of integration interval
+        if (ev.time < t) continue;        // skip event if a neuron is in refactory period
+        if (ev.time >= tfinal) break;     // end of integration interval
+
+        // Events are applied at their binned time, which is no earlier than
+        // the time of the last update. Binning an event time twice yields the
+        // same result, so the look-ahead below does not disturb the binner.
+        const auto time = binner.bin(ev.time, t);
+        auto weight = ev.weight;
 
-        // if there are events that happened at the same time as this event, process them as well
-        while (i + 1 < n_events && event_lane[i+1].time <= time) {
+        // if there are events that fall in the same bin as this event, process them as well
+        while (i + 1 < n_events && event_lane[i+1].time < tfinal && binner.bin(event_lane[i+1].time, t) <= time) {
             weight += event_lane[i+1].weight;
             i++;
         }
@@ -9,6 +9,7 @@
 #include <arbor/spike.hpp>
 
 #include "cell_group.hpp"
+#include "event_binner.hpp"
 #include "label_resolution.hpp"
 
 namespace arb {
@@ -30,6 +31,9 @@ public:
     virtual const std::vector<spike>& spikes() const override;
     virtual void clear_spikes() override;
 
+    virtual void write_checkpoint(checkpoint_writer&) const override;
+    virtual void read_checkpoint(checkpoint_reader&, time_type t) override;
+
     // Sampler association methods below should be thread-safe, as they might be invoked
     // from a sampler call back called from a different cell group running on a different thread.
     virtual void add_sampler(sampler_association_handle, cell_member_predicate, schedule, sampler_function, sampling_policy) override;
@@ -52,6 +56,9 @@ private:
 
     // Time when the cell was last updated.
     std::vector<time_type> last_time_updated_;
+
+    // Event time binning manager.
+    std::vector<event_binner> binners_;
 };
 
 } // namespace arb
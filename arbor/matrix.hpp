@@ -71,6 +71,16 @@ public:
         state_.assemble(dt_cell, voltage, current, conductivity);
     }
 
+    /// Assemble and solve the matrices of the cells [cell_begin, cell_end) only,
+    /// for back ends that support tiled time stepping.
+    void assemble(const array& dt_cell, const array& voltage, const array& current, const array& conductivity, index_type cell_begin, index_type cell_end) {
+        state_.assemble(dt_cell, voltage, current, conductivity, cell_begin, cell_end);
+    }
+
+    void solve(array& to, index_type cell_begin, index_type cell_end) {
+        state_.solve(to, cell_begin, cell_end);
+    }
+
 private:
     /// the parent indice that describe matrix structure
     iarray parent_index_;
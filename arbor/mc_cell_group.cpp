@@ -1,9 +1,13 @@
+#include <algorithm>
 #include <functional>
+#include <iterator>
+#include <numeric>
 #include <optional>
 #include <unordered_set>
 #include <variant>
 #include <vector>
 
+#include <arbor/arbexcept.hpp>
 #include <arbor/assert.hpp>
 #include <arbor/common_types.hpp>
 #include <arbor/cable_cell.hpp>
@@ -13,6 +17,7 @@
 
 #include "backends/event.hpp"
 #include "cell_group.hpp"
+#include "checkpoint.hpp"
 #include "event_binner.hpp"
 #include "fvm_lowered_cell.hpp"
 #include "label_resolution.hpp"
@@ -23,6 +28,7 @@
 #include "util/maputil.hpp"
 #include "util/partition.hpp"
 #include "util/range.hpp"
+#include "util/rangeutil.hpp"
 #include "util/span.hpp"
 
 namespace arb {
@@ -54,6 +60,9 @@ mc_cell_group::mc_cell_group(const std::vector<cell_gid_type>& gids,
 
     // Store consistent data from fvm_lowered_cell
     target_handles_ = std::move(fvm_info.target_handles);
+    if (util::any_of(fvm_info.aggregate_events, [](bool b) { return b; })) {
+        aggregate_events_ = std::move(fvm_info.aggregate_events);
+    }
     cell_to_intdom_ = std::move(fvm_info.cell_to_intdom);
     probe_map_ = std::move(fvm_info.probe_map);
 
@@ -77,6 +86,10 @@ void mc_cell_group::reset() {
     for (auto &entry: sampler_map_) {
         entry.second.sched.reset();
     }
+    for (auto &entry: sink_map_) {
+        entry.second->sched.reset();
+        entry.second->n_written = 0;
+    }
 
     for (auto& b: binners_) {
         b.reset();
@@ -85,6 +98,33 @@ void mc_cell_group::reset() {
     lowered_->reset();
 }
 
+void mc_cell_group::write_checkpoint(checkpoint_writer& w) const {
+    w.write<std::uint64_t>(binners_.size());
+    for (auto& b: binners_) {
+        b.write_checkpoint(w);
+    }
+    lowered_->write_checkpoint(w);
+}
+
+void mc_cell_group::read_checkpoint(checkpoint_reader& r, time_type t) {
+    reset();
+
+    for (auto &entry: sampler_map_) {
+        entry.second.sched.events(0, t);
+    }
+    for (auto &entry: sink_map_) {
+        entry.second->sched.events(0, t);
+    }
+
+    if (r.read<std::uint64_t>()!=binners_.size()) {
+        throw bad_checkpoint("cell count mismatch");
+    }
+    for (auto& b: binners_) {
+        b.read_checkpoint(r);
+    }
+    lowered_->read_checkpoint(r);
+}
+
 void mc_cell_group::set_binning_policy(binning_kind policy, time_type bin_interval) {
     binners_.clear();
     binners_.resize(gids_.size(), event_binner(policy, bin_interval));
@@ -93,7 +133,7 @@ void mc_cell_group::set_binning_policy(binning_kind policy, time_type bin_interv
 // Probe-type specific sample data marshalling.
 
 struct sampler_call_info {
-    sampler_function sampler;
+    const sampler_function* sampler;
     cell_member_type probe_id;
     probe_tag tag;
     unsigned index;
@@ -145,7 +185,7 @@ void run_samples(
        sample_records.push_back(sample_record{time_type(raw_times[i]), &raw_samples[i]});
     }
 
-    sc.sampler({sc.probe_id, sc.tag, sc.index, p.get_metadata_ptr()}, n_sample, sample_records.data());
+    (*sc.sampler)({sc.probe_id, sc.tag, sc.index, p.get_metadata_ptr()}, n_sample, sample_records.data());
 }
 
 void run_samples(
@@ -175,7 +215,7 @@ void run_samples(
         sample_records.push_back(sample_record{time_type(raw_times[offset]), &ctmp[j]});
     }
 
-    sc.sampler({sc.probe_id, sc.tag, sc.index, p.get_metadata_ptr()}, n_sample, sample_records.data());
+    (*sc.sampler)({sc.probe_id, sc.tag, sc.index, p.get_metadata_ptr()}, n_sample, sample_records.data());
 }
 
 void run_samples(
@@ -205,7 +245,7 @@ void run_samples(
         sample_records.push_back(sample_record{time_type(raw_times[offset]), &csample_ranges[j]});
     }
 
-    sc.sampler({sc.probe_id, sc.tag, sc.index, p.get_metadata_ptr()}, n_sample, sample_records.data());
+    (*sc.sampler)({sc.probe_id, sc.tag, sc.index, p.get_metadata_ptr()}, n_sample, sample_records.data());
 }
 
 void run_samples(
@@ -248,7 +288,7 @@ void run_samples(
         sample_records.push_back(sample_record{time_type(raw_times[offset]), &csample_ranges[j]});
     }
 
-    sc.sampler({sc.probe_id, sc.tag, sc.index, p.get_metadata_ptr()}, n_sample, sample_records.data());
+    (*sc.sampler)({sc.probe_id, sc.tag, sc.index, p.get_metadata_ptr()}, n_sample, sample_records.data());
 }
 
 void run_samples(
@@ -295,7 +335,50 @@ void run_samples(
         sample_records.push_back(sample_record{time_type(raw_times[offset]), &csample_ranges[j]});
     }
 
-    sc.sampler({sc.probe_id, sc.tag, sc.index, p.get_metadata_ptr()}, n_sample, sample_records.data());
+    (*sc.sampler)({sc.probe_id, sc.tag, sc.index, p.get_metadata_ptr()}, n_sample, sample_records.data());
+}
+
+// Compute the per-cable membrane currents for one sample from the raw CV
+// voltages and stimulus currents, writing p.metadata.size() values to out.
+void membrane_currents_sample(const fvm_probe_membrane_currents& p, const fvm_value_type* raw, double* out) {
+    const auto n_cv = p.cv_parent_cond.size();
+    const auto cables_by_cv = util::partition_view(p.cv_cables_divs);
+    const auto n_stim = p.stim_scale.size();
+
+    std::fill(out, out+p.metadata.size(), 0.);
+
+    // Each CV voltage contributes to the current sum of its parent's cables
+    // and its own cables.
+
+    const double* v = raw;
+    for (auto cv: util::make_span(n_cv)) {
+        fvm_index_type parent_cv = p.cv_parent[cv];
+        if (parent_cv+1==0) continue;
+
+        double cond = p.cv_parent_cond[cv];
+
+        double cv_I = v[cv]*cond;
+        double parent_cv_I = v[parent_cv]*cond;
+
+        for (auto cable_i: util::make_span(cables_by_cv[cv])) {
+            out[cable_i] -= (cv_I-parent_cv_I)*p.weight[cable_i];
+        }
+
+        for (auto cable_i: util::make_span(cables_by_cv[parent_cv])) {
+            out[cable_i] += (cv_I-parent_cv_I)*p.weight[cable_i];
+        }
+    }
+
+    const double* stim = raw+n_cv;
+    for (auto i: util::make_span(n_stim)) {
+        double cv_stim_I = stim[i]*p.stim_scale[i];
+        unsigned cv = p.stim_cv[i];
+        arb_assert(cv<n_cv);
+
+        for (auto cable_i: util::make_span(cables_by_cv[cv])) {
+            out[cable_i] -= cv_stim_I*p.weight[cable_i];
+        }
+    }
 }
 
 void run_samples(
@@ -311,16 +394,13 @@ void run_samples(
     arb_assert((sc.end_offset-sc.begin_offset)==n_sample*n_raw_per_sample);
 
     const auto n_cable = p.metadata.size();
-    const auto n_cv = p.cv_parent_cond.size();
-    const auto cables_by_cv = util::partition_view(p.cv_cables_divs);
-    const auto n_stim = p.stim_scale.size();
-    arb_assert(n_stim+n_cv==(unsigned)n_raw_per_sample);
+    arb_assert(p.stim_scale.size()+p.cv_parent_cond.size()==(unsigned)n_raw_per_sample);
 
     auto& sample_ranges = std::get<std::vector<cable_sample_range>>(scratch);
     sample_ranges.clear();
 
     auto& tmp = std::get<std::vector<double>>(scratch);
-    tmp.assign(n_cable*n_sample, 0.);
+    tmp.resize(n_cable*n_sample);
 
     sample_records.clear();
 
@@ -328,38 +408,7 @@ void run_samples(
         auto offset = j*n_raw_per_sample+sc.begin_offset;
         auto tmp_base = tmp.data()+j*n_cable;
 
-        // Each CV voltage contributes to the current sum of its parent's cables
-        // and its own cables.
-
-        const double* v = raw_samples+offset;
-        for (auto cv: util::make_span(n_cv)) {
-            fvm_index_type parent_cv = p.cv_parent[cv];
-            if (parent_cv+1==0) continue;
-
-            double cond = p.cv_parent_cond[cv];
-
-            double cv_I = v[cv]*cond;
-            double parent_cv_I = v[parent_cv]*cond;
-
-            for (auto cable_i: util::make_span(cables_by_cv[cv])) {
-                tmp_base[cable_i] -= (cv_I-parent_cv_I)*p.weight[cable_i];
-            }
-
-            for (auto cable_i: util::make_span(cables_by_cv[parent_cv])) {
-                tmp_base[cable_i] += (cv_I-parent_cv_I)*p.weight[cable_i];
-            }
-        }
-
-        const double* stim = raw_samples+offset+n_cv;
-        for (auto i: util::make_span(n_stim)) {
-            double cv_stim_I = stim[i]*p.stim_scale[i];
-            unsigned cv = p.stim_cv[i];
-            arb_assert(cv<n_cv);
-
-            for (auto cable_i: util::make_span(cables_by_cv[cv])) {
-                tmp_base[cable_i] -= cv_stim_I*p.weight[cable_i];
-            }
-        }
+        membrane_currents_sample(p, raw_samples+offset, tmp_base);
         sample_ranges.push_back({tmp_base, tmp_base+n_cable});
     }
 
@@ -369,7 +418,7 @@ void run_samples(
         sample_records.push_back(sample_record{time_type(raw_times[offset]), &csample_ranges[j]});
     }
 
-    sc.sampler({sc.probe_id, sc.tag, sc.index, p.get_metadata_ptr()}, n_sample, sample_records.data());
+    (*sc.sampler)({sc.probe_id, sc.tag, sc.index, p.get_metadata_ptr()}, n_sample, sample_records.data());
 }
 
 // Generic run_samples dispatches on probe info variant type.
@@ -383,6 +432,126 @@ void run_samples(
     std::visit([&](auto& x) {run_samples(x, sc, raw_times, raw_samples, sample_records, scratch); }, sc.pdata_ptr->info);
 }
 
+// Sample sink marshalling: each sample time of a probe is written as one row
+// of `sample_width(p)` values, computed from the raw values of that time.
+
+// The sink association is shared with the sink map, and is kept alive by the
+// call if the sink is removed while the samples are delivered.
+struct sink_call_info {
+    std::shared_ptr<sample_sink_association> sink;
+    probe_tag tag;
+    const fvm_probe_data* pdata_ptr;
+
+    // Offset into lowered cell sample time and event arrays.
+    sample_size_type begin_offset;
+    std::size_t n_sample;
+};
+
+std::size_t sample_width(const missing_probe_info&) { return 0; }
+std::size_t sample_width(const fvm_probe_scalar&) { return 1; }
+std::size_t sample_width(const fvm_probe_interpolated&) { return 1; }
+std::size_t sample_width(const fvm_probe_multi& p) { return p.raw_handles.size(); }
+std::size_t sample_width(const fvm_probe_weighted_multi& p) { return p.raw_handles.size(); }
+std::size_t sample_width(const fvm_probe_interpolated_multi& p) { return p.raw_handles.size()/2; }
+std::size_t sample_width(const fvm_probe_membrane_currents& p) { return p.metadata.size(); }
+
+std::size_t sample_width(const fvm_probe_data& pdata) {
+    return std::visit([](auto& x) { return sample_width(x); }, pdata.info);
+}
+
+void write_sample_row(const missing_probe_info&, const fvm_value_type*, double*) {
+    throw arbor_internal_error("invalid fvm_probe_data in sample sink");
+}
+
+void write_sample_row(const fvm_probe_scalar&, const fvm_value_type* raw, double* out) {
+    out[0] = raw[0];
+}
+
+void write_sample_row(const fvm_probe_interpolated& p, const fvm_value_type* raw, double* out) {
+    out[0] = p.coef[0]*raw[0] + p.coef[1]*raw[1];
+}
+
+void write_sample_row(const fvm_probe_multi& p, const fvm_value_type* raw, double* out) {
+    std::copy(raw, raw+p.raw_handles.size(), out);
+}
+
+void write_sample_row(const fvm_probe_weighted_multi& p, const fvm_value_type* raw, double* out) {
+    for (auto i: util::count_along(p.weight)) {
+        out[i] = raw[i]*p.weight[i];
+    }
+}
+
+void write_sample_row(const fvm_probe_interpolated_multi& p, const fvm_value_type* raw, double* out) {
+    const auto n = p.raw_handles.size()/2;
+    const auto* raw_b = raw + n;
+    for (std::size_t i = 0; i<n; ++i) {
+        out[i] = raw[i]*p.coef[0][i] + raw_b[i]*p.coef[1][i];
+    }
+}
+
+void write_sample_row(const fvm_probe_membrane_currents& p, const fvm_value_type* raw, double* out) {
+    membrane_currents_sample(p, raw, out);
+}
+
+// Write the samples of one sink call into the ring buffer, overwriting the
+// oldest rows, and report the new rows to the commit callback.
+void run_sink(const sink_call_info& sc, const fvm_value_type* raw_times, const fvm_value_type* raw_samples) {
+    auto& sink = *sc.sink;
+    const auto& ring = sink.ring;
+    const auto& pdata = *sc.pdata_ptr;
+    const sample_size_type n_raw = pdata.n_raw();
+
+    // Only the most recent `capacity` samples are retained.
+    std::size_t n_skip = sc.n_sample>ring.capacity? sc.n_sample-ring.capacity: 0;
+    std::size_t first = (sink.n_written+n_skip)%ring.capacity;
+
+    std::visit(
+        [&](auto& p) {
+            std::size_t row = first;
+            for (auto j: util::make_span(n_skip, sc.n_sample)) {
+                auto offset = sc.begin_offset + j*n_raw;
+                ring.times[row] = raw_times[offset];
+                write_sample_row(p, raw_samples+offset, ring.values+row*ring.width);
+                if (++row==ring.capacity) row = 0;
+            }
+        },
+        pdata.info);
+
+    sink.n_written += sc.n_sample;
+    if (sink.commit) {
+        sink.commit({sink.probe_id, sc.tag, sink.index, pdata.get_metadata_ptr()}, ring, first, sc.n_sample-n_skip);
+    }
+}
+
+// Aggregate events in the time-sorted range [b, e) that share delivery time and
+// target handle by summing their weights, for targets whose mechanism id is
+// flagged in `aggregate`. Returns the end of the aggregated range.
+template <typename Iter>
+Iter aggregate_events(Iter b, Iter e, const std::vector<bool>& aggregate) {
+    Iter out = b;
+    while (b!=e) {
+        // Sort each run of events with the same delivery time by target, so
+        // that events on the same target are adjacent. The sort is stable, so
+        // that events on each target keep their delivery order.
+        auto t = b->time;
+        Iter run_end = std::find_if(b, e, [t](const deliverable_event& ev) { return ev.time!=t; });
+        std::stable_sort(b, run_end,
+            [](const deliverable_event& l, const deliverable_event& r) { return l.handle<r.handle; });
+
+        Iter run_out = out;
+        for (; b!=run_end; ++b) {
+            const auto& h = b->handle;
+            if (out!=run_out && (out-1)->handle==h && h.mech_id<aggregate.size() && aggregate[h.mech_id]) {
+                (out-1)->weight += b->weight;
+            }
+            else {
+                *out++ = *b;
+            }
+        }
+    }
+    return out;
+}
+
 void mc_cell_group::advance(epoch ep, time_type dt, const event_lane_subrange& event_lanes) {
     time_type tstart = lowered_->time();
 
@@ -416,6 +585,13 @@ void mc_cell_group::advance(epoch ep, time_type dt, const event_lane_subrange& e
                 count_staged++;
             }
 
+            if (!aggregate_events_.empty() && count_staged>1) {
+                auto b = staged_events_.end()-count_staged;
+                auto e = aggregate_events(b, staged_events_.end(), aggregate_events_);
+                count_staged = e-b;
+                staged_events_.erase(e, staged_events_.end());
+            }
+
             ev_end += count_staged;
 
             if (curr_intdom != prev_intdom) {
@@ -435,8 +611,8 @@ void mc_cell_group::advance(epoch ep, time_type dt, const event_lane_subrange& e
 
     // Create sample events and delivery information.
     //
-    // For each (schedule, sampler, probe set) in the sampler association
-    // map that will be triggered in this integration interval, create
+    // For each (schedule, sampler, probe set) in the sample plan
+    // that will be triggered in this integration interval, create
     // sample events for the lowered cell, one or more for each scheduled
     // sample time and probe in the probe set.
     //
@@ -444,88 +620,129 @@ void mc_cell_group::advance(epoch ep, time_type dt, const event_lane_subrange& e
     // time buffers; these are assigned contiguously such that one call to
     // a sampler callback can be represented by a `sampler_call_info`
     // value as defined below, grouping together all the samples of the
-    // same probe for this callback in this association.
+    // same probe for this callback in this association. Sample sinks are
+    // treated in the same way, with a `sink_call_info` value per sink.
 
     PE(advance_samplesetup);
     std::vector<sampler_call_info> call_info;
+    std::vector<sink_call_info> sink_calls;
+    std::vector<sampler_function> samplers;
 
-    std::vector<sample_event> sample_events;
+    sample_events_.clear();
+    exact_sampling_events_.clear();
     sample_size_type n_samples = 0;
     sample_size_type max_samples_per_call = 0;
 
-    std::vector<deliverable_event> exact_sampling_events;
+    // Divisions of sample_events_ by sampler association; events within each
+    // division are sorted by integration domain and then time.
+    std::vector<std::size_t> sample_event_divs = {0};
 
     {
         std::lock_guard<std::mutex> guard(sampler_mex_);
 
-        for (auto& sm_entry: sampler_map_) {
-            // Ignore sampler_association_handle, just need the association itself.
-            sampler_association& sa = sm_entry.second;
+        call_info.reserve(sample_plan_n_probes_);
+        samplers.reserve(sample_plan_.size());
+
+        std::vector<sample_size_type> probe_offsets;
 
-            auto sample_times = util::make_range(sa.sched.events(tstart, ep.t1));
+        for (auto& plan: sample_plan_) {
+            auto sample_times = util::make_range(plan.sched->events(tstart, ep.t1));
             if (sample_times.empty()) {
                 continue;
             }
 
             sample_size_type n_times = sample_times.size();
-            max_samples_per_call = std::max(max_samples_per_call, n_times);
 
-            for (cell_member_type pid: sa.probe_ids) {
-                auto cell_index = gid_index_map_.at(pid.gid);
+            // Assign sample offsets in probe order, which determines the order
+            // of sampler callbacks.
+            probe_offsets.clear();
+            for (const sample_plan_probe& pp: plan.probes) {
+                probe_offsets.push_back(n_samples);
+                n_samples += n_times*pp.pdata_ptr->n_raw();
+            }
 
-                probe_tag tag = probe_map_.tag.at(pid);
-                unsigned index = 0;
-                for (const fvm_probe_data& pdata: probe_map_.data_on(pid)) {
-                    call_info.push_back({sa.sampler, pid, tag, index++, &pdata, n_samples, n_samples + n_times*pdata.n_raw()});
-                    auto intdom = cell_to_intdom_[cell_index];
+            if (plan.sink) {
+                const sample_plan_probe& pp = plan.probes.front();
+                sink_calls.push_back({plan.sink, pp.tag, pp.pdata_ptr, probe_offsets.front(), std::size_t(n_times)});
+            }
+            else {
+                max_samples_per_call = std::max(max_samples_per_call, n_times);
+
+                // One copy of the sampler per association and epoch, shared by all calls.
+                samplers.push_back(plan.assoc->sampler);
+                const sampler_function* sampler = &samplers.back();
+
+                for (auto i: util::count_along(plan.probes)) {
+                    const sample_plan_probe& pp = plan.probes[i];
+                    sample_size_type n_raw = pp.pdata_ptr->n_raw();
+                    call_info.push_back({sampler, pp.probe_id, pp.tag, pp.index, pp.pdata_ptr, probe_offsets[i], probe_offsets[i] + n_times*n_raw});
+                }
+            }
+
+            // Generate sample events for the probes of each integration domain
+            // in time order.
+            for (auto intdom_probes: util::partition_view(plan.intdom_divs)) {
+                auto intdom = plan.probes[plan.probes_by_intdom[intdom_probes.first]].intdom;
+
+                sample_size_type j = 0;
+                for (auto t: sample_times) {
+                    for (auto k: util::make_span(intdom_probes)) {
+                        auto i = plan.probes_by_intdom[k];
+                        const auto& pdata = *plan.probes[i].pdata_ptr;
+                        sample_size_type offset = probe_offsets[i] + j*pdata.n_raw();
 
-                    for (auto t: sample_times) {
                         for (probe_handle h: pdata.raw_handle_range()) {
-                            sample_event ev{t, (cell_gid_type)intdom, {h, n_samples++}};
-                            sample_events.push_back(ev);
-                        }
-                        if (sa.policy==sampling_policy::exact) {
-                            target_handle h(-1, 0, intdom);
-                            exact_sampling_events.push_back({t, h, 0.f});
+                            sample_events_.push_back(sample_event{t, (cell_gid_type)intdom, {h, offset++}});
                         }
                     }
+                    if (plan.policy==sampling_policy::exact) {
+                        target_handle h(-1, 0, intdom);
+                        exact_sampling_events_.push_back({t, h, 0.f});
+                    }
+                    ++j;
                 }
             }
-            arb_assert(n_samples==call_info.back().end_offset);
+            sample_event_divs.push_back(sample_events_.size());
         }
     }
 
-    // Sort exact sampling events into staged events for delivery.
-    if (exact_sampling_events.size()) {
-        auto event_less =
-            [](const auto& a, const auto& b) {
-                 auto ai = event_index(a);
-                 auto bi = event_index(b);
-                 return ai<bi || (ai==bi && event_time(a)<event_time(b));
-            };
+    auto event_less =
+        [](const auto& a, const auto& b) {
+             auto ai = event_index(a);
+             auto bi = event_index(b);
+             return ai<bi || (ai==bi && event_time(a)<event_time(b));
+        };
 
-        util::sort(exact_sampling_events, event_less);
+    // Sort exact sampling events into staged events for delivery.
+    if (exact_sampling_events_.size()) {
+        util::sort(exact_sampling_events_, event_less);
 
         std::vector<deliverable_event> merged;
-        merged.reserve(staged_events_.size()+exact_sampling_events.size());
+        merged.reserve(staged_events_.size()+exact_sampling_events_.size());
 
         std::merge(staged_events_.begin(), staged_events_.end(),
-                   exact_sampling_events.begin(), exact_sampling_events.end(),
+                   exact_sampling_events_.begin(), exact_sampling_events_.end(),
                    std::back_inserter(merged), event_less);
         std::swap(merged, staged_events_);
     }
 
-    // Sample events must be ordered by time for the lowered cell.
-    util::sort_by(sample_events, [](const sample_event& ev) { return event_time(ev); });
-    util::stable_sort_by(sample_events, [](const sample_event& ev) { return event_index(ev); });
+    // Sample events must be ordered by integration domain and then time for
+    // the lowered cell: merge the sorted per-association divisions.
+    for (std::size_t i = 2; i<sample_event_divs.size(); ++i) {
+        std::inplace_merge(sample_events_.begin(),
+                           sample_events_.begin()+sample_event_divs[i-1],
+                           sample_events_.begin()+sample_event_divs[i],
+                           event_less);
+    }
     PL();
 
     // Run integration and collect samples, spikes.
-    auto result = lowered_->integrate(ep.t1, dt, staged_events_, std::move(sample_events));
+    auto result = lowered_->integrate(ep.t1, dt, staged_events_, sample_events_);
 
     // For each sampler callback registered in `call_info`, construct the
     // vector of sample entries from the lowered cell sample times and values
-    // and then call the callback.
+    // and then call the callback. Sample sinks receive their values directly
+    // in their ring buffers.
 
     PE(advance_sampledeliver);
     std::vector<sample_record> sample_records;
@@ -537,6 +754,10 @@ void mc_cell_group::advance(epoch ep, time_type dt, const event_lane_subrange& e
     for (auto& sc: call_info) {
         run_samples(sc, result.sample_time.data(), result.sample_value.data(), sample_records, scratch);
     }
+
+    for (auto& sc: sink_calls) {
+        run_sink(sc, result.sample_time.data(), result.sample_value.data());
+    }
     PL();
 
     // Copy out spike voltage threshold crossings from the back end, then
@@ -560,17 +781,96 @@ void mc_cell_group::add_sampler(sampler_association_handle h, cell_member_predic
     if (!probeset.empty()) {
         auto result = sampler_map_.insert({h, sampler_association{std::move(sched), std::move(fn), std::move(probeset), policy}});
         arb_assert(result.second);
+        build_sample_plan();
     }
 }
 
+void mc_cell_group::add_sample_sink(sampler_association_handle h, cell_member_type probe_id, unsigned index,
+                                    schedule sched, sample_ring_buffer ring, sample_commit_function commit,
+                                    sampling_policy policy)
+{
+    if (!probe_map_.tag.count(probe_id)) return;
+
+    auto data = probe_map_.data_on(probe_id);
+    if (index>=data.size()) return;
+
+    std::size_t width = sample_width(*std::next(data.begin(), index));
+    if (ring.width!=width || !ring.capacity || !ring.times || !ring.values) {
+        throw bad_sample_sink(probe_id, width);
+    }
+
+    std::lock_guard<std::mutex> guard(sampler_mex_);
+    auto sink = std::make_shared<sample_sink_association>(sample_sink_association{std::move(sched), probe_id, index, ring, std::move(commit), policy});
+    auto result = sink_map_.insert({h, std::move(sink)});
+    arb_assert(result.second);
+    build_sample_plan();
+}
+
 void mc_cell_group::remove_sampler(sampler_association_handle h) {
     std::lock_guard<std::mutex> guard(sampler_mex_);
     sampler_map_.erase(h);
+    sink_map_.erase(h);
+    build_sample_plan();
 }
 
 void mc_cell_group::remove_all_samplers() {
     std::lock_guard<std::mutex> guard(sampler_mex_);
     sampler_map_.clear();
+    sink_map_.clear();
+    build_sample_plan();
+}
+
+void mc_cell_group::add_sample_plan_probe(sample_plan_association& plan, cell_member_type probe_id, const fvm_probe_data& pdata, unsigned index) {
+    auto intdom = cell_to_intdom_[gid_index_map_.at(probe_id.gid)];
+    plan.probes.push_back({probe_id, probe_map_.tag.at(probe_id), index, &pdata, intdom});
+}
+
+// Resolve the probe data and integration domain of each probe of each sampler
+// association and sample sink. Must be called with sampler_mex_ held.
+void mc_cell_group::build_sample_plan() {
+    sample_plan_.clear();
+    sample_plan_n_probes_ = 0;
+
+    std::vector<sample_plan_association> plans;
+
+    for (auto& sm_entry: sampler_map_) {
+        sampler_association& sa = sm_entry.second;
+
+        sample_plan_association plan{&sa.sched, sa.policy, &sa, nullptr};
+        for (cell_member_type pid: sa.probe_ids) {
+            unsigned index = 0;
+            for (const fvm_probe_data& pdata: probe_map_.data_on(pid)) {
+                add_sample_plan_probe(plan, pid, pdata, index++);
+            }
+        }
+        plans.push_back(std::move(plan));
+    }
+
+    for (auto& sink_entry: sink_map_) {
+        sample_sink_association& sink = *sink_entry.second;
+
+        sample_plan_association plan{&sink.sched, sink.policy, nullptr, sink_entry.second};
+        add_sample_plan_probe(plan, sink.probe_id, *std::next(probe_map_.data_on(sink.probe_id).begin(), sink.index), sink.index);
+        plans.push_back(std::move(plan));
+    }
+
+    for (auto& plan: plans) {
+        // Group probes by integration domain, preserving probe order within each.
+        plan.probes_by_intdom.resize(plan.probes.size());
+        std::iota(plan.probes_by_intdom.begin(), plan.probes_by_intdom.end(), 0u);
+        util::stable_sort_by(plan.probes_by_intdom, [&](unsigned i) { return plan.probes[i].intdom; });
+
+        plan.intdom_divs.push_back(0);
+        for (auto i: util::count_along(plan.probes_by_intdom)) {
+            auto intdom = plan.probes[plan.probes_by_intdom[i]].intdom;
+            if (i+1==plan.probes_by_intdom.size() || plan.probes[plan.probes_by_intdom[i+1]].intdom!=intdom) {
+                plan.intdom_divs.push_back(i+1);
+            }
+        }
+
+        sample_plan_n_probes_ += plan.probes.size();
+        sample_plan_.push_back(std::move(plan));
+    }
 }
 
 std::vector<probe_metadata> mc_cell_group::get_probe_metadata(cell_member_type probe_id) const {
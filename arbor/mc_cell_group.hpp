@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <functional>
 #include <iterator>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -51,9 +52,16 @@ public:
         spikes_.clear();
     }
 
+    void write_checkpoint(checkpoint_writer&) const override;
+    void read_checkpoint(checkpoint_reader&, time_type t) override;
+
     void add_sampler(sampler_association_handle h, cell_member_predicate probe_ids,
                      schedule sched, sampler_function fn, sampling_policy policy) override;
 
+    void add_sample_sink(sampler_association_handle h, cell_member_type probe_id, unsigned index,
+                         schedule sched, sample_ring_buffer ring, sample_commit_function commit,
+                         sampling_policy policy) override;
+
     void remove_sampler(sampler_association_handle h) override;
 
     void remove_all_samplers() override;
@@ -61,6 +69,33 @@ public:
     std::vector<probe_metadata> get_probe_metadata(cell_member_type probe_id) const override;
 
 private:
+    // A probe of a sampler association, with its probe data and integration
+    // domain resolved.
+    struct sample_plan_probe {
+        cell_member_type probe_id;
+        probe_tag tag;
+        unsigned index;
+        const fvm_probe_data* pdata_ptr;
+        fvm_index_type intdom;
+    };
+
+    // Sample plan for one sampler association or sample sink: the probes in
+    // order of sampler invocation, and their indices grouped by integration
+    // domain with divisions intdom_divs. Exactly one of assoc and sink is
+    // non-null; a sink has a single probe.
+    struct sample_plan_association {
+        schedule* sched;
+        sampling_policy policy;
+        sampler_association* assoc;
+        std::shared_ptr<sample_sink_association> sink;
+        std::vector<sample_plan_probe> probes;
+        std::vector<unsigned> probes_by_intdom;
+        std::vector<unsigned> intdom_divs;
+    };
+
+    void build_sample_plan();
+    void add_sample_plan_probe(sample_plan_association& plan, cell_member_type probe_id, const fvm_probe_data& pdata, unsigned index);
+
     // List of the gids of the cells in the group.
     std::vector<cell_gid_type> gids_;
 
@@ -85,18 +120,33 @@ private:
     // List of events to deliver
     std::vector<deliverable_event> staged_events_;
 
-    // Pending samples to be taken.
-    event_queue<sample_event> sample_events_;
+    // Sample events for the current epoch.
+    std::vector<sample_event> sample_events_;
+
+    // Events that force integration steps to end at exact sample times.
+    std::vector<deliverable_event> exact_sampling_events_;
 
     // Handles for accessing lowered cell.
     std::vector<target_handle> target_handles_;
 
+    // Mechanism ids for which simultaneous events on the same target are
+    // aggregated; empty if aggregation is disabled for all mechanisms.
+    std::vector<bool> aggregate_events_;
+
     // Maps probe ids to probe handles (from lowered cell) and tags (from probe descriptions).
     probe_association_map probe_map_;
 
     // Collection of samplers to be run against probes in this group.
     sampler_association_map sampler_map_;
 
+    // Sample sinks attached to probes in this group.
+    sample_sink_association_map sink_map_;
+
+    // Sampler associations with probe lookups resolved, rebuilt whenever
+    // samplers are added or removed.
+    std::vector<sample_plan_association> sample_plan_;
+    std::size_t sample_plan_n_probes_ = 0;
+
     // Mutex for thread-safe access to sampler associations.
     std::mutex sampler_mex_;
 
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <set>
 #include <vector>
@@ -23,12 +24,19 @@ static constexpr spike_event terminal_pse{0, terminal_time, 0};
 // The tournament tree data structure is used to merge k sorted lists of events.
 // See online for high-level information about tournament trees.
 //
-// This implementation maintains a heap-like data structure, with entries of type:
-//      std::pair<unsigned, post_synaptic_event>
-// where the unsigned ∈ [0, k-1] is the id of the list from which the event was
-// drawn. The id is stored so that the operation of removing the most recent event
-// knows which leaf node needs to be updated (i.e. the leaf node of the list from
-// which the most recent event was drawn).
+// This implementation is a loser tree. The sort keys (time, target) of the
+// current head of each input lane are stored in the compact array keys_, and
+// each internal node i ∈ [1, leaves_-1] of the tree stores in losers_[i] the
+// index of the lane that lost the match played at that node. The overall
+// winner is kept in winner_. Events themselves are never copied into the tree:
+// the head event is read directly from its input lane.
+//
+// Removing the head requires one walk from the winner's leaf to the root,
+// replaying only the matches on that path against the stored losers.
+//
+// Lanes are padded to a power of two with terminal keys. Ties on (time, target)
+// are broken by comparing event weights, so that the output is sorted
+// according to spike_event::operator<.
 //
 // unsigned is used for storing the index, because if drawing events from more
 // event generators than can be counted using an unsigned a complete redesign
@@ -45,108 +53,178 @@ tourney_tree::tourney_tree(std::vector<event_span>& input):
 
     // Must be able to fit leaves in unsigned count.
     arb_assert(leaves_>=n_lanes_);
-    nodes_ = 2*leaves_-1;
 
-    // Allocate space for the tree nodes
-    heap_.resize(nodes_);
-    // Set the leaf nodes
+    // Set the keys of the leaf nodes; null leaf nodes get a terminal key.
+    keys_.assign(leaves_, key_type{terminal_time, 0});
+    for (auto i=0u; i<n_lanes_; ++i) {
+        update_key(i);
+    }
+
+    // Play the initial tournament bottom up, recording the winner of each
+    // match in a scratch heap and the loser in the tree.
+    losers_.resize(leaves_);
+    std::vector<unsigned> winners(2*leaves_);
     for (auto i=0u; i<leaves_; ++i) {
-        heap_[leaf(i)] = i<n_lanes_?
-            key_val(i, input[i].empty()? terminal_pse: input[i].front()):
-            key_val(i, terminal_pse); // null leaf node
+        winners[leaves_+i] = i;
     }
-    // Walk the tree to initialize the non-leaf nodes
-    setup(0);
+    for (auto i=leaves_-1; i>0; --i) {
+        unsigned l = winners[2*i];
+        unsigned r = winners[2*i+1];
+        bool right_wins = less(r, l);
+        winners[i] = right_wins? r: l;
+        losers_[i] = right_wins? l: r;
+    }
+    winner_ = winners[1];
 }
 
 std::ostream& operator<<(std::ostream& out, const tourney_tree& tt) {
+    auto print_key = [&](unsigned lane) {
+        out << "{" << lane << "," << tt.keys_[lane].time << "," << tt.keys_[lane].target << "}";
+    };
+
+    out << "winner ";
+    print_key(tt.winner_);
     unsigned nxt = 1;
-    for (unsigned i = 0; i<tt.nodes_; ++i) {
-        if (i==nxt-1) {
+    for (unsigned i = 1; i<tt.leaves_; ++i) {
+        if (i==nxt) {
             nxt*=2;
             out << "\n";
         }
-        out << "{" << tt.heap_[i].first << "," << tt.heap_[i].second << "}\n";
+        print_key(tt.losers_[i]);
     }
-    return out;
+    return out << "\n";
 }
 
 bool tourney_tree::empty() const {
-    return event(0).time == terminal_time;
+    return keys_[winner_].time == terminal_time;
 }
 
 spike_event tourney_tree::head() const {
-    return event(0);
+    return empty()? terminal_pse: input_[winner_].front();
 }
 
 // Remove the smallest (most recent) event from the tree, then update the
 // tree so that head() returns the next event.
 void tourney_tree::pop() {
-    unsigned lane = id(0);
-    unsigned i = leaf(lane);
+    unsigned lane = winner_;
 
     // draw the next event from the input lane
     auto& in = input_[lane];
-
     if (!in.empty()) {
         ++in.left;
     }
-
-    event(i) = in.empty()? terminal_pse: in.front();
-
-    // re-heapify the tree with a single walk from leaf to root
-    while ((i=parent(i))) {
-        merge_up(i);
+    update_key(lane);
+
+    // replay the matches on the path from the leaf to the root
+    for (unsigned i = (lane+leaves_)>>1; i; i >>= 1) {
+        unsigned l = losers_[i];
+        bool swap = less(l, lane);
+        losers_[i] = swap? lane: l;
+        lane = swap? l: lane;
     }
-    merge_up(0); // handle the root
+    winner_ = lane;
 }
 
-void tourney_tree::setup(unsigned i) {
-    if (is_leaf(i)) return;
-    setup(left(i));
-    setup(right(i));
-    merge_up(i);
-};
-
-// Update the value at node i of the tree to be the smallest
-// of its left and right children.
-// The result is undefined for leaf nodes.
-void tourney_tree::merge_up(unsigned i) {
-    const auto l = left(i);
-    const auto r = right(i);
-    heap_[i] = event(l)<event(r)? heap_[l]: heap_[r];
+void tourney_tree::update_key(unsigned lane) {
+    const auto& in = input_[lane];
+    keys_[lane] = in.empty()?
+        key_type{terminal_time, 0}:
+        key_type{in.front().time, in.front().target};
 }
 
-// The tree is stored using the standard heap indexing scheme.
+// Compare the heads of lanes a and b.
+bool tourney_tree::less(unsigned a, unsigned b) const {
+    const auto& ka = keys_[a];
+    const auto& kb = keys_[b];
 
-unsigned tourney_tree::parent(unsigned i) const {
-    return (i-1)>>1;
-}
-unsigned tourney_tree::left(unsigned i) const {
-    return (i<<1) + 1;
-}
-unsigned tourney_tree::right(unsigned i) const {
-    return left(i)+1;
-}
-unsigned tourney_tree::leaf(unsigned i) const {
-    return i+leaves_-1;
-}
-bool tourney_tree::is_leaf(unsigned i) const {
-    return i>=leaves_-1;
+    if (ka.time!=kb.time) return ka.time<kb.time;
+    if (ka.target!=kb.target) return ka.target<kb.target;
+
+    // Keys match: fall back to the event weights. Null and exhausted lanes
+    // are never compared beyond their keys.
+    return ka.time!=terminal_time && input_[a].front().weight<input_[b].front().weight;
 }
-const unsigned& tourney_tree::id(unsigned i) const {
-    return heap_[i].first;
+
+// Two- and three-way merges select the smallest head without branching on
+// the comparison results; ties are resolved in favour of the earlier lane.
+
+static spike_event* merge_two_impl(
+    const spike_event* a, const spike_event* a_end,
+    const spike_event* b, const spike_event* b_end,
+    spike_event* out)
+{
+    while (a!=a_end && b!=b_end) {
+        bool take_b = *b<*a;
+        *out++ = take_b? *b: *a;
+        b += take_b;
+        a += !take_b;
+    }
+    out = std::copy(a, a_end, out);
+    return std::copy(b, b_end, out);
 }
-spike_event& tourney_tree::event(unsigned i) {
-    return heap_[i].second;
+
+void merge_two(event_span a, event_span b, pse_vector& out) {
+    auto n = out.size();
+    out.resize(n+a.size()+b.size());
+    merge_two_impl(a.begin(), a.end(), b.begin(), b.end(), out.data()+n);
 }
-const spike_event& tourney_tree::event(unsigned i) const {
-    return heap_[i].second;
+
+void merge_three(event_span a, event_span b, event_span c, pse_vector& out) {
+    auto n = out.size();
+    out.resize(n+a.size()+b.size()+c.size());
+    spike_event* o = out.data()+n;
+
+    auto pa = a.begin(), pb = b.begin(), pc = c.begin();
+    const auto ea = a.end(), eb = b.end(), ec = c.end();
+
+    while (pa!=ea && pb!=eb && pc!=ec) {
+        bool b_lt_a = *pb<*pa;
+        const spike_event* m = b_lt_a? pb: pa;
+        bool c_lt_m = *pc<*m;
+        *o++ = c_lt_m? *pc: *m;
+        pa += !b_lt_a & !c_lt_m;
+        pb += b_lt_a & !c_lt_m;
+        pc += c_lt_m;
+    }
+
+    // At least one lane is exhausted: finish with a two-way merge.
+    if (pa==ea) merge_two_impl(pb, eb, pc, ec, o);
+    else if (pb==eb) merge_two_impl(pa, ea, pc, ec, o);
+    else merge_two_impl(pa, ea, pb, eb, o);
 }
 
 } // namespace impl
 
 void tree_merge_events(std::vector<event_span>& sources, pse_vector& out) {
+    // Empty lanes do not take part in the merge: collect the first few
+    // non-empty lanes to pick a small-k merge.
+    event_span lanes[3];
+    unsigned n_lanes = 0;
+    for (auto& s: sources) {
+        if (s.empty()) continue;
+        if (n_lanes==3) {
+            n_lanes = 4;
+            break;
+        }
+        lanes[n_lanes++] = s;
+    }
+
+    switch (n_lanes) {
+    case 0:
+        return;
+    case 1:
+        out.insert(out.end(), lanes[0].begin(), lanes[0].end());
+        return;
+    case 2:
+        impl::merge_two(lanes[0], lanes[1], out);
+        return;
+    case 3:
+        impl::merge_three(lanes[0], lanes[1], lanes[2], out);
+        return;
+    default:
+        break;
+    }
+
     impl::tourney_tree tree(sources);
     while (!tree.empty()) {
         out.push_back(tree.head());
@@ -15,14 +15,23 @@ namespace arb {
 
 using event_span = util::range<const spike_event*>;
 
+// The merged events are appended to out. The number of spans in sources is
+// unchanged, but the spans may be advanced as their events are consumed.
 void tree_merge_events(std::vector<event_span>& sources, pse_vector& out);
 
 namespace impl {
     // The tournament tree is used internally by the merge_events method, and
     // it is not intended for use elsewhere. It is exposed here for unit testing
     // of its functionality.
+    //
+    // It is implemented as a loser tree: internal nodes record only the index
+    // of the lane that lost the match at that node, and the sort keys of the
+    // current head of each lane are kept in a compact per-lane array.
     class tourney_tree {
-        using key_val = std::pair<unsigned, spike_event>;
+        struct key_type {
+            time_type time;
+            cell_lid_type target;
+        };
 
     public:
         tourney_tree(std::vector<event_span>& input);
@@ -32,25 +41,22 @@ namespace impl {
         friend std::ostream& operator<<(std::ostream&, const tourney_tree&);
 
     private:
-        void setup(unsigned i);
-        void merge_up(unsigned i);
-        void update_lane(unsigned lane);
-        unsigned parent(unsigned i) const;
-        unsigned left(unsigned i) const;
-        unsigned right(unsigned i) const;
-        unsigned leaf(unsigned i) const;
-        bool is_leaf(unsigned i) const;
-        const unsigned& id(unsigned i) const;
-        spike_event& event(unsigned i);
-        const spike_event& event(unsigned i) const;
-        unsigned next_power_2(unsigned x) const;
-
-        std::vector<key_val> heap_;
+        void update_key(unsigned lane);
+        bool less(unsigned a, unsigned b) const;
+
+        std::vector<key_type> keys_;
+        std::vector<unsigned> losers_;
         std::vector<event_span>& input_;
+        unsigned winner_;
         unsigned leaves_;
-        unsigned nodes_;
         unsigned n_lanes_;
     };
+
+    // Branchless merges of two and three sorted sequences, used in place of
+    // the tournament tree for the common case of few input lanes. Merged
+    // events are appended to `out`.
+    void merge_two(event_span a, event_span b, pse_vector& out);
+    void merge_three(event_span a, event_span b, event_span c, pse_vector& out);
 }
 
 } // namespace arb
@@ -4,6 +4,7 @@
 #include <arbor/context.hpp>
 
 #include "memory_meter.hpp"
+#include "perf_meter.hpp"
 #include "power_meter.hpp"
 
 #include "execution_context.hpp"
@@ -52,6 +53,9 @@ meter_manager::meter_manager() {
     if (auto m = make_power_meter()) {
         meters_.push_back(std::move(m));
     }
+    for (auto& m: make_perf_counter_meters()) {
+        meters_.push_back(std::move(m));
+    }
 };
 
 void meter_manager::start(const context& ctx) {
@@ -0,0 +1,102 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <arbor/profile/meter.hpp>
+#include <arbor/profile/profiler.hpp>
+#include <arbor/profile/timer.hpp>
+
+#include "hardware/perf_counters.hpp"
+#include "perf_meter.hpp"
+#include "util/rangeutil.hpp"
+
+namespace arb {
+namespace profile {
+
+using timer_type = timer<>;
+
+// Reports a rate derived from the hardware event counts accumulated over
+// all profiler regions on all threads between readings.
+class perf_meter: public meter {
+    using rate_fn = double (*)(const hw::perf_counts&, double);
+
+    std::string name_;
+    std::string units_;
+    rate_fn rate_;
+
+    tick_type start_ = timer_type::tic();
+    std::vector<double> times_;
+    std::vector<hw::perf_counts> readings_;
+
+public:
+    perf_meter(std::string name, std::string units, rate_fn rate):
+        name_(std::move(name)), units_(std::move(units)), rate_(rate)
+    {}
+
+    std::string name() override {
+        return name_;
+    }
+
+    std::string units() override {
+        return units_;
+    }
+
+    std::vector<double> measurements() override {
+        std::vector<double> rates;
+
+        for (auto i=1ul; i<readings_.size(); ++i) {
+            rates.push_back(rate_(readings_[i]-readings_[i-1], times_[i]-times_[i-1]));
+        }
+
+        return rates;
+    }
+
+    void take_reading() override {
+        auto p = profiler_summary();
+
+        hw::perf_counts total;
+        total.cycles = util::sum(p.cycles, std::uint64_t(0));
+        total.instructions = util::sum(p.instructions, std::uint64_t(0));
+        total.llc_misses = util::sum(p.llc_misses, std::uint64_t(0));
+        total.fp_ops = util::sum(p.fp_ops, std::uint64_t(0));
+
+        times_.push_back(timer_type::toc(start_));
+        readings_.push_back(total);
+    }
+};
+
+std::vector<meter_ptr> make_perf_counter_meters() {
+    std::vector<meter_ptr> meters;
+
+#ifdef ARB_HAVE_PERF_COUNTERS
+    hw::perf_counter_group counters;
+    if (!counters.available()) {
+        return meters;
+    }
+
+    // Instructions per cycle.
+    meters.emplace_back(new perf_meter("ipc", "",
+        [](const hw::perf_counts& c, double) {
+            return c.cycles? double(c.instructions)/c.cycles: 0.;
+        }));
+
+    // Memory traffic of last level cache misses, per second of wall time.
+    meters.emplace_back(new perf_meter("llc-bandwidth", "GB/s",
+        [](const hw::perf_counts& c, double t) {
+            return t>0? double(c.llc_misses)*hw::cache_line_bytes/t*1e-9: 0.;
+        }));
+
+    if (counters.has_fp_ops()) {
+        // Floating point arithmetic instructions per second of wall time.
+        meters.emplace_back(new perf_meter("fp-rate", "GFP/s",
+            [](const hw::perf_counts& c, double t) {
+                return t>0? double(c.fp_ops)/t*1e-9: 0.;
+            }));
+    }
+#endif
+
+    return meters;
+}
+
+} // namespace profile
+} // namespace arb
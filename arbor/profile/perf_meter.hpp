@@ -0,0 +1,16 @@
+#pragma once
+
+#include <vector>
+
+#include <arbor/profile/meter.hpp>
+
+namespace arb {
+namespace profile {
+
+// Meters derived from the hardware event counts recorded in profiler
+// regions; empty unless arbor is built with ARB_WITH_PERF_COUNTERS and the
+// counters can be opened.
+std::vector<meter_ptr> make_perf_counter_meters();
+
+} // namespace profile
+} // namespace arb
@@ -1,4 +1,5 @@
 #include <cstdio>
+#include <memory>
 #include <mutex>
 #include <ostream>
 
@@ -6,6 +7,8 @@
 #include <arbor/profile/profiler.hpp>
 
 #include "execution_context.hpp"
+#include "hardware/perf_counters.hpp"
+#include "profile/recorder.hpp"
 #include "threading/threading.hpp"
 #include "util/span.hpp"
 #include "util/rangeutil.hpp"
@@ -18,6 +21,12 @@ using util::make_span;
 
 #ifdef ARB_HAVE_PROFILING
 namespace {
+#ifdef ARB_HAVE_PERF_COUNTERS
+    constexpr bool with_perf_counters = true;
+#else
+    constexpr bool with_perf_counters = false;
+#endif
+
     // Check whether a string describes a valid profiler region name.
     bool is_valid_region_string(const std::string& s) {
         if (s.size()==0u || s.front()=='_' || s.back()=='_') return false;
@@ -44,43 +53,6 @@ namespace {
     }
 }
 
-// Holds the accumulated number of calls and time spent in a region.
-struct profile_accumulator {
-    std::size_t count=0;
-    double time=0.;
-};
-
-// Records the accumulated time spent in profiler regions on one thread.
-// There is one recorder for each thread.
-class recorder {
-    // used to mark that the recorder is not currently timing a region.
-    static constexpr region_id_type npos = std::numeric_limits<region_id_type>::max();
-
-    // The index of the region being timed.
-    // If set to npos, no region is being timed.
-    region_id_type index_ = npos;
-
-    tick_type start_time_;
-
-    // One accumulator for call count and wall time for each region.
-    std::vector<profile_accumulator> accumulators_;
-
-public:
-    // Return a list of the accumulated call count and wall times for each region.
-    const std::vector<profile_accumulator>& accumulators() const;
-
-    // Start timing the region with index.
-    // Throws std::runtime_error if already timing a region.
-    void enter(region_id_type index);
-
-    // Stop timing the current region, and add the time taken to the accumulated time.
-    // Throws std::runtime_error if not currently timing a region.
-    void leave();
-
-    // Reset all of the accumulated call counts and times to zero.
-    void clear();
-};
-
 // Manages the thread-local recorders.
 class profiler {
     std::vector<recorder> recorders_;
@@ -128,6 +100,7 @@ struct profile_node {
     std::string name;
     double time = 0;
     region_id_type count = npos;
+    hw::perf_counts counts;
     std::vector<profile_node> children;
 
     profile_node() = default;
@@ -151,6 +124,14 @@ void recorder::enter(region_id_type index) {
         accumulators_.resize(index+1);
     }
     index_ = index;
+    if constexpr (with_perf_counters) {
+        if (!counters_) {
+            counters_ = std::make_unique<hw::perf_counter_group>();
+        }
+        if (counters_->available()) {
+            start_counts_ = counters_->read();
+        }
+    }
     start_time_ = timer_type::tic();
 }
 
@@ -163,6 +144,9 @@ void recorder::leave() {
     }
     accumulators_[index_].count++;
     accumulators_[index_].time += delta;
+    if (has_counters()) {
+        accumulators_[index_].counts += counters_->read()-start_counts_;
+    }
     index_ = npos;
 }
 
@@ -171,6 +155,14 @@ void recorder::clear() {
     accumulators_.resize(0);
 }
 
+bool recorder::has_counters() const {
+    return counters_ && counters_->available();
+}
+
+bool recorder::has_fp_ops() const {
+    return counters_ && counters_->has_fp_ops();
+}
+
 // profiler implementation
 
 profiler::profiler() {}
@@ -214,14 +206,17 @@ region_id_type profiler::region_index(const char* name) {
 // Used to prepare the profiler output for printing.
 // Perform a depth first traversal of a profile tree that:
 // - sorts the children of each node in ascending order of time taken;
-// - sets the time taken for each non-leaf node to the sum of its children.
+// - sets the time taken and hardware event counts for each non-leaf node to
+//   the sum of its children.
 double sort_profile_tree(profile_node& n) {
     // accumulate all time taken in children
     if (!n.children.empty()) {
         n.time = 0;
+        n.counts = {};
         for (auto &c: n.children) {
             sort_profile_tree(c);
             n.time += c.time;
+            n.counts += c.counts;
         }
     }
 
@@ -247,6 +242,29 @@ profile profiler::results() const {
         }
     }
 
+    // Hardware counters are reported if they could be opened on any thread.
+    bool has_counters = util::any_of(recorders_, [](auto& r) { return r.has_counters(); });
+    bool has_fp_ops = util::any_of(recorders_, [](auto& r) { return r.has_fp_ops(); });
+    if (has_counters) {
+        p.cycles = std::vector<std::uint64_t>(nregions);
+        p.instructions = std::vector<std::uint64_t>(nregions);
+        p.llc_misses = std::vector<std::uint64_t>(nregions);
+        if (has_fp_ops) {
+            p.fp_ops = std::vector<std::uint64_t>(nregions);
+        }
+
+        for (auto& r: recorders_) {
+            auto& accumulators = r.accumulators();
+            for (auto i: make_span(0, accumulators.size())) {
+                const auto& c = accumulators[i].counts;
+                p.cycles[i] += c.cycles;
+                p.instructions[i] += c.instructions;
+                p.llc_misses[i] += c.llc_misses;
+                if (has_fp_ops) p.fp_ops[i] += c.fp_ops;
+            }
+        }
+    }
+
     p.num_threads = recorders_.size();
 
     return p;
@@ -283,6 +301,16 @@ profile_node make_profile_tree(const profile& p) {
             }
         }
         node->children.emplace_back(names[idx].back(), p.times[idx], p.counts[idx]);
+
+        auto& counts = node->children.back().counts;
+        if (!p.cycles.empty()) {
+            counts.cycles = p.cycles[idx];
+            counts.instructions = p.instructions[idx];
+            counts.llc_misses = p.llc_misses[idx];
+        }
+        if (!p.fp_ops.empty()) {
+            counts.fp_ops = p.fp_ops[idx];
+        }
     }
     sort_profile_tree(tree);
 
@@ -293,14 +321,22 @@ const std::vector<std::string>& profiler::regions() const {
     return region_names_;
 }
 
+// Achieved rate, in 10^9 per second of wall time, of events counted over
+// the thread time of a region.
+float giga_rate(std::uint64_t events, double thread_time, unsigned nthreads) {
+    return thread_time>0? events/(thread_time/nthreads)*1e-9: 0;
+}
+
 void print(std::ostream& o,
            profile_node& n,
            float wall_time,
            unsigned nthreads,
            float thresh,
+           bool counters,
+           bool fp_ops,
            std::string indent="")
 {
-    static char buf[80];
+    static char buf[128];
 
     auto name = indent + n.name;
     float per_thread_time = n.time/nthreads;
@@ -320,8 +356,19 @@ void print(std::ostream& o,
     }
     o << "\n" << buf;
 
+    if (counters) {
+        float ipc = n.counts.cycles? float(n.counts.instructions)/n.counts.cycles: 0;
+        float bandwidth = giga_rate(n.counts.llc_misses*hw::cache_line_bytes, n.time, nthreads);
+        snprintf(buf, std::size(buf), "%8.2f%8.2f", ipc, bandwidth);
+        o << buf;
+    }
+    if (fp_ops) {
+        snprintf(buf, std::size(buf), "%8.2f", giga_rate(n.counts.fp_ops, n.time, nthreads));
+        o << buf;
+    }
+
     // print each of the children in turn
-    for (auto& c: n.children) print(o, c, wall_time, nthreads, thresh, indent+"  ");
+    for (auto& c: n.children) print(o, c, wall_time, nthreads, thresh, counters, fp_ops, indent+"  ");
 };
 
 //
@@ -349,13 +396,23 @@ void profiler_initialize(context& ctx) {
 
 // Print profiler statistics to an ostream
 std::ostream& operator<<(std::ostream& o, const profile& prof) {
-    char buf[80];
+    char buf[128];
 
     auto tree = make_profile_tree(prof);
+    bool counters = !prof.cycles.empty();
+    bool fp_ops = !prof.fp_ops.empty();
 
     snprintf(buf, std::size(buf), "_p_ %-20s%12s%12s%12s%8s", "REGION", "CALLS", "THREAD", "WALL", "\%");
     o << buf;
-    print(o, tree, tree.time, prof.num_threads, 0, "");
+    if (counters) {
+        snprintf(buf, std::size(buf), "%8s%8s", "IPC", "GB/s");
+        o << buf;
+    }
+    if (fp_ops) {
+        snprintf(buf, std::size(buf), "%8s", "GFP/s");
+        o << buf;
+    }
+    print(o, tree, tree.time, prof.num_threads, 0, counters, fp_ops, "");
     return o;
 }
 
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <arbor/profile/profiler.hpp>
+#include <arbor/profile/timer.hpp>
+
+#include "hardware/perf_counters.hpp"
+
+// The per-thread recorder of the profiler; it is only implemented in builds
+// with profiling enabled.
+
+namespace arb {
+namespace profile {
+
+// Holds the accumulated number of calls, time and hardware event counts
+// in a region.
+struct profile_accumulator {
+    std::size_t count=0;
+    double time=0.;
+    hw::perf_counts counts;
+};
+
+// Records the accumulated time spent in profiler regions on one thread.
+// There is one recorder for each thread.
+class recorder {
+    // used to mark that the recorder is not currently timing a region.
+    static constexpr region_id_type npos = std::numeric_limits<region_id_type>::max();
+
+    // The index of the region being timed.
+    // If set to npos, no region is being timed.
+    region_id_type index_ = npos;
+
+    tick_type start_time_;
+
+    // Hardware counters for the thread of the recorder, opened on the first
+    // call to enter, and their values when the current region was entered.
+    std::unique_ptr<hw::perf_counter_group> counters_;
+    hw::perf_counts start_counts_;
+
+    // One accumulator for call count and wall time for each region.
+    std::vector<profile_accumulator> accumulators_;
+
+public:
+    // Return a list of the accumulated call count and wall times for each region.
+    const std::vector<profile_accumulator>& accumulators() const;
+
+    // Start timing the region with index.
+    // Throws std::runtime_error if already timing a region.
+    void enter(region_id_type index);
+
+    // Stop timing the current region, and add the time taken to the accumulated time.
+    // Throws std::runtime_error if not currently timing a region.
+    void leave();
+
+    // Reset all of the accumulated call counts and times to zero.
+    void clear();
+
+    // Whether hardware counters are recorded, and which.
+    bool has_counters() const;
+    bool has_fp_ops() const;
+};
+
+} // namespace profile
+} // namespace arb
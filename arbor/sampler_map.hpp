@@ -3,6 +3,7 @@
 // Helper classes for managing sampler/schedule associations in
 // cell group classes (see sampling_api doc).
 
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -24,4 +25,22 @@ struct sampler_association {
 
 using sampler_association_map = std::unordered_map<sampler_association_handle, sampler_association>;
 
+// An association between a schedule, a single probe and a sample sink, as
+// provided to `simulation::add_sample_sink()`. Sink associations are shared,
+// so that a sink being written to outlives its removal from the map.
+
+struct sample_sink_association {
+    schedule sched;
+    cell_member_type probe_id;
+    unsigned index;
+    sample_ring_buffer ring;
+    sample_commit_function commit;
+    sampling_policy policy;
+
+    // Total number of rows written to the ring buffer.
+    std::size_t n_written = 0;
+};
+
+using sample_sink_association_map = std::unordered_map<sampler_association_handle, std::shared_ptr<sample_sink_association>>;
+
 } // namespace arb
@@ -1,3 +1,4 @@
+#include <iostream>
 #include <memory>
 #include <set>
 #include <vector>
@@ -12,6 +13,7 @@
 
 #include "cell_group.hpp"
 #include "cell_group_factory.hpp"
+#include "checkpoint.hpp"
 #include "communication/communicator.hpp"
 #include "execution_context.hpp"
 #include "merge_events.hpp"
@@ -95,9 +97,16 @@ public:
 
     time_type run(time_type tfinal, time_type dt);
 
+    void checkpoint(checkpoint_writer& w) const;
+    void restore(checkpoint_reader& r);
+
     sampler_association_handle add_sampler(cell_member_predicate probe_ids,
         schedule sched, sampler_function f, sampling_policy policy = sampling_policy::lax);
 
+    sampler_association_handle add_sample_sink(cell_member_type probe_id, unsigned index,
+        schedule sched, sample_ring_buffer ring, sample_commit_function commit,
+        sampling_policy policy = sampling_policy::lax);
+
     void remove_sampler(sampler_association_handle);
 
     void remove_all_samplers();
@@ -441,6 +450,70 @@ time_type simulation_state::run(time_type tfinal, time_type dt) {
     return current.t1;
 }
 
+// Version of the checkpoint format, to be incremented with any change.
+static constexpr std::uint32_t checkpoint_version = 1;
+
+// On return from run(), with epoch_.id==k, the remaining state comprises the
+// cell group state, the events of lanes k that are due after the epoch, the
+// pending events from the spike exchange of epoch k, and the positions of the
+// event generators, which have been queried up to the end of epoch k.
+
+void simulation_state::checkpoint(checkpoint_writer& w) const {
+    w.write(std::string("arbor-checkpoint"));
+    w.write(checkpoint_version);
+    w.write(epoch_);
+    w.write(communicator_.num_spikes());
+
+    w.write<std::uint64_t>(cell_groups_.size());
+    for (auto& group: cell_groups_) {
+        w.write(group->get_cell_kind());
+        group->write_checkpoint(w);
+    }
+
+    auto& lanes = event_lanes_[epoch_.id&1];
+    for (auto i: util::make_span(communicator_.num_local_cells())) {
+        w.write_seq(lanes[i]);
+        w.write_seq(pending_events_[i]);
+    }
+}
+
+void simulation_state::restore(checkpoint_reader& r) {
+    reset();
+
+    r.expect("arbor-checkpoint");
+    if (r.read<std::uint32_t>()!=checkpoint_version) {
+        throw bad_checkpoint("unsupported version");
+    }
+    auto ep = r.read<epoch>();
+    communicator_.restore_num_spikes(r.read<std::uint64_t>());
+
+    if (r.read<std::uint64_t>()!=cell_groups_.size()) {
+        throw bad_checkpoint("cell group count mismatch");
+    }
+    for (auto& group: cell_groups_) {
+        if (r.read<cell_kind>()!=group->get_cell_kind()) {
+            throw bad_checkpoint("cell kind mismatch");
+        }
+        group->read_checkpoint(r, ep.t1);
+    }
+
+    auto& lanes = event_lanes(ep.id);
+    for (auto i: util::make_span(communicator_.num_local_cells())) {
+        r.read_vector(lanes[i]);
+        r.read_vector(pending_events_[i]);
+    }
+
+    if (ep.t1>0) {
+        for (auto& gens: event_generators_) {
+            for (auto& g: gens) {
+                g.events(0, ep.t1);
+            }
+        }
+    }
+
+    epoch_ = ep;
+}
+
 sampler_association_handle simulation_state::add_sampler(
         cell_member_predicate probe_ids,
         schedule sched,
@@ -455,6 +528,22 @@ sampler_association_handle simulation_state::add_sampler(
     return h;
 }
 
+sampler_association_handle simulation_state::add_sample_sink(
+        cell_member_type probe_id,
+        unsigned index,
+        schedule sched,
+        sample_ring_buffer ring,
+        sample_commit_function commit,
+        sampling_policy policy)
+{
+    sampler_association_handle h = sassoc_handles_.acquire();
+
+    foreach_group(
+        [&](cell_group_ptr& group) { group->add_sample_sink(h, probe_id, index, sched, ring, commit, policy); });
+
+    return h;
+}
+
 void simulation_state::remove_sampler(sampler_association_handle h) {
     foreach_group(
         [h](cell_group_ptr& group) { group->remove_sampler(h); });
@@ -517,6 +606,16 @@ time_type simulation::run(time_type tfinal, time_type dt) {
     return impl_->run(tfinal, dt);
 }
 
+void simulation::checkpoint(std::ostream& out) const {
+    checkpoint_writer w(out);
+    impl_->checkpoint(w);
+}
+
+void simulation::restore(std::istream& in) {
+    checkpoint_reader r(in);
+    impl_->restore(r);
+}
+
 sampler_association_handle simulation::add_sampler(
     cell_member_predicate probe_ids,
     schedule sched,
@@ -526,6 +625,17 @@ sampler_association_handle simulation::add_sampler(
     return impl_->add_sampler(std::move(probe_ids), std::move(sched), std::move(f), policy);
 }
 
+sampler_association_handle simulation::add_sample_sink(
+    cell_member_type probe_id,
+    unsigned index,
+    schedule sched,
+    sample_ring_buffer ring,
+    sample_commit_function commit,
+    sampling_policy policy)
+{
+    return impl_->add_sample_sink(probe_id, index, std::move(sched), ring, std::move(commit), policy);
+}
+
 void simulation::remove_sampler(sampler_association_handle h) {
     impl_->remove_sampler(h);
 }
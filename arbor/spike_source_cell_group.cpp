@@ -70,6 +70,14 @@ const std::vector<spike>& spike_source_cell_group::spikes() const {
     return spikes_;
 }
 
+// The only state is the position in each schedule.
+void spike_source_cell_group::read_checkpoint(checkpoint_reader&, time_type t) {
+    reset();
+    for (auto& s: time_sequences_) {
+        s.events(0, t);
+    }
+}
+
 void spike_source_cell_group::clear_spikes() {
     spikes_.clear();
 }
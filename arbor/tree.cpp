@@ -321,9 +321,10 @@ tree::iarray tree::minimize_depth() {
         curr = parent(curr);
     }
 
-    // reduce the path
+    // reduce the path; one of u and v may be an ancestor of the other
     auto last_together = 0;
-    while (path_to_root_u.back() == path_to_root_v.back()) {
+    while (!path_to_root_u.empty() && !path_to_root_v.empty() &&
+           path_to_root_u.back() == path_to_root_v.back()) {
         last_together = path_to_root_u.back();
         path_to_root_u.pop_back();
         path_to_root_v.pop_back();
@@ -1,6 +1,8 @@
 include(CMakeParseArguments)
 
 # If a MODCC executable is explicitly provided, don't make the in-tree modcc a dependency.
+# Additional modcc flags for a single mechanism <mech> can be given in the
+# variable MODCC_FLAGS_<mech>, e.g. to freeze its global parameters.
 
 function(build_modules)
     cmake_parse_arguments(build_modules "" "MODCC;TARGET;SOURCE_DIR;DEST_DIR;MECH_SUFFIX" "MODCC_FLAGS;GENERATES" ${ARGN})
@@ -31,7 +33,7 @@ function(build_modules)
             set(modcc_bin $<TARGET_FILE:modcc>)
         endif()
 
-        set(flags ${build_modules_MODCC_FLAGS} -o "${out}")
+        set(flags ${build_modules_MODCC_FLAGS} ${MODCC_FLAGS_${mech}} -o "${out}")
         if(build_modules_MECH_SUFFIX)
             list(APPEND flags -m "${mech}${build_modules_MECH_SUFFIX}")
         endif()
@@ -103,7 +103,8 @@ void IdentifierExpression::semantic(scope_ptr scp) {
     // procedure.
     //
     // If, however, we are in a PROCEDURE or FUNCTION block, we do not
-    // have access to indexed variables and this constitutes an error.
+    // have access to indexed variables and this constitutes an error,
+    // except for reading the temperature in a tabulated procedure.
 
     if(auto sym = s->is_indexed_variable()) {
         if (scope_->in_api_context()) {
@@ -111,7 +112,7 @@ void IdentifierExpression::semantic(scope_ptr scp) {
             var->external_variable(sym);
             s = scope_->add_local_symbol(spelling_, scope_type::symbol_ptr{var});
         }
-        else {
+        else if (!scope_->in_table_context() || sym->data_source()!=sourceKind::temperature) {
             error( pprintf("the symbol '%' refers to an external quantity "
                            "and is unavailable in a function or procedure",
                            yellow(spelling_)));
@@ -534,6 +535,9 @@ std::string ProcedureExpression::to_string() const {
     str += blue("  args") + "    : ";
     for(auto& arg : args_)
         str += arg->to_string() + " ";
+    if (table_) {
+        str += "\n  " + table_->to_string();
+    }
     str += "\n  "+blue("body")+" :";
     str += body_->to_string();
 
@@ -585,6 +589,7 @@ void ProcedureExpression::semantic(scope_type::symbol_map &global_symbols) {
         break;
     default:
         scp->in_api_context(false);
+        scp->in_table_context(table_!=nullptr);
         break;
     }
     semantic(scp);
@@ -899,6 +904,32 @@ expression_ptr ConductanceExpression::clone() const {
     return expression_ptr{s};
 }
 
+/*******************************************************************************
+  TableExpression
+*******************************************************************************/
+
+std::string TableExpression::to_string() const {
+    std::string str = blue("table") + " (";
+    for (auto& name: names_) str += " " + yellow(name);
+    str += " ) " + blue("depend") + " (";
+    for (auto& name: depend_) str += " " + yellow(name);
+    str += " ) " + blue("from") + " " + std::to_string(from_)
+        + " " + blue("to") + " " + std::to_string(to_)
+        + " " + blue("with") + " " + std::to_string(n_);
+    return str;
+}
+
+void TableExpression::semantic(scope_ptr scp) {
+    error_ = false;
+    scope_ = scp;
+    // The tabulated and DEPEND variables are checked against the procedure
+    // body by Module::check_tables.
+}
+
+expression_ptr TableExpression::clone() const {
+    return make_expression<TableExpression>(location_, names_, depend_, from_, to_, n_);
+}
+
 /*******************************************************************************
   BlockExpression
 *******************************************************************************/
@@ -1026,6 +1057,9 @@ void SolveExpression::accept(Visitor *v) {
 void ConductanceExpression::accept(Visitor *v) {
     v->visit(this);
 }
+void TableExpression::accept(Visitor *v) {
+    v->visit(this);
+}
 void DerivativeExpression::accept(Visitor *v) {
     v->visit(this);
 }
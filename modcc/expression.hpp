@@ -43,6 +43,7 @@ class InitialBlock;
 class SolveExpression;
 class Symbol;
 class ConductanceExpression;
+class TableExpression;
 class PDiffExpression;
 class VariableExpression;
 class NetReceiveExpression;
@@ -101,6 +102,7 @@ std::string to_string(symbolKind k);
 enum class solverMethod {
     cnexp, // for diagonal linear ODE systems.
     sparse, // for non-diagonal linear ODE systems.
+    derivimplicit, // for non-linear ODE systems: backward Euler with Newton iterations.
     none
 };
 
@@ -113,6 +115,7 @@ static std::string to_string(solverMethod m) {
     switch(m) {
         case solverMethod::cnexp:  return std::string("cnexp");
         case solverMethod::sparse: return std::string("sparse");
+        case solverMethod::derivimplicit: return std::string("derivimplicit");
         case solverMethod::none:   return std::string("none");
     }
     return std::string("<error : undefined solverMethod>");
@@ -187,6 +190,7 @@ public:
     virtual SolveExpression*       is_solve_statement()   {return nullptr;}
     virtual Symbol*                is_symbol()            {return nullptr;}
     virtual ConductanceExpression* is_conductance_statement() {return nullptr;}
+    virtual TableExpression*       is_table_statement()   {return nullptr;}
     virtual PDiffExpression*       is_pdiff()             {return nullptr;}
 
     virtual bool is_lvalue() const {return false;}
@@ -723,6 +727,50 @@ private:
     std::string ion_channel_;
 };
 
+// TABLE statement in a PROCEDURE: the variables in `names` assigned by the
+// procedure are tabulated as functions of its single argument at `n`+1
+// equally spaced points in [from, to], and are looked up by linear
+// interpolation in place of evaluating the procedure body. The table is
+// rebuilt whenever one of the global variables in `depend` changes.
+class TableExpression : public Expression {
+public:
+    TableExpression(
+            Location loc,
+            std::vector<std::string> names,
+            std::vector<std::string> depend,
+            double from,
+            double to,
+            int n)
+    :   Expression(loc), names_(std::move(names)), depend_(std::move(depend)),
+        from_(from), to_(to), n_(n)
+    {}
+
+    std::string to_string() const override;
+
+    const std::vector<std::string>& names() const { return names_; }
+    const std::vector<std::string>& depend() const { return depend_; }
+    double from() const { return from_; }
+    double to() const { return to_; }
+    int n() const { return n_; }
+
+    TableExpression* is_table_statement() override {
+        return this;
+    }
+
+    expression_ptr clone() const override;
+
+    void semantic(scope_ptr scp) override;
+    void accept(Visitor *v) override;
+
+    ~TableExpression() {}
+private:
+    std::vector<std::string> names_;
+    std::vector<std::string> depend_;
+    double from_;
+    double to_;
+    int n_;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // recursive if statement
 // requires a BlockExpression that is a simple wrapper around a std::list
@@ -1055,11 +1103,20 @@ public:
     /// from a special block, e.g. BREAKPOINT, INITIAL, NET_RECEIVE, etc
     procedureKind kind() const {return kind_;}
 
+    /// the TABLE statement of the procedure, or nullptr if it has none
+    TableExpression* table() {
+        return table_? table_->is_table_statement(): nullptr;
+    }
+    void table(expression_ptr&& t) {
+        table_ = std::move(t);
+    }
+
 protected:
     Symbol* symbol_;
 
     std::vector<expression_ptr> args_;
     expression_ptr body_;
+    expression_ptr table_;
     procedureKind kind_ = procedureKind::normal;
 };
 
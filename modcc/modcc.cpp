@@ -1,8 +1,11 @@
+#include <cstdlib>
 #include <exception>
 #include <iostream>
 #include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <tinyopt/tinyopt.h>
 
@@ -29,6 +32,10 @@ int report_error(const std::string& message) {
     return 1;
 }
 
+void report_warning(const std::string& message) {
+    cerr << yellow("warning: ") << message << "\n";
+}
+
 int report_ice(const std::string& message) {
     cerr << red("internal compiler error: ") << message << "\n"
          << "\nPlease report this error to the modcc developers.\n";
@@ -71,6 +78,9 @@ struct Options {
     bool verbose = false;
     bool analysis = false;
     std::unordered_set<targetKind> targets;
+    std::vector<std::pair<std::string, std::string>> frozen_globals;
+    unsigned newton_iterations = 3;
+    double newton_tolerance = 1e-8;
 };
 
 // Helper for formatting tabulated output (option reporting).
@@ -97,12 +107,20 @@ std::ostream& operator<<(std::ostream& out, const Options& opt) {
         targets += " "+key_by_value(targetKindMap, t);
     }
 
+    std::string frozen;
+    for (auto& [name, value]: opt.frozen_globals) {
+        frozen += " "+name+"="+value;
+    }
+
     return out <<
         table_prefix{"file"} << opt.modfile << line_end <<
         table_prefix{"output"} << (opt.outprefix.empty()? "-": opt.outprefix) << line_end <<
         table_prefix{"verbose"} << noyes[opt.verbose] << line_end <<
         table_prefix{"targets"} << targets << line_end <<
-        table_prefix{"analysis"} << noyes[opt.analysis] << line_end;
+        table_prefix{"analysis"} << noyes[opt.analysis] << line_end <<
+        table_prefix{"frozen globals"} << frozen << line_end <<
+        table_prefix{"newton iterations"} << opt.newton_iterations << line_end <<
+        table_prefix{"newton tolerance"} << opt.newton_tolerance << line_end;
 }
 
 std::ostream& operator<<(std::ostream& out, const printer_options& popt) {
@@ -112,7 +130,9 @@ std::ostream& operator<<(std::ostream& out, const printer_options& popt) {
     return out <<
         table_prefix{"namespace"} << popt.cpp_namespace << line_end <<
         table_prefix{"profile"} << noyes[popt.profile] << line_end <<
-        table_prefix{"simd"} << popt.simd << line_end;
+        table_prefix{"simd"} << popt.simd << line_end <<
+        table_prefix{"single precision state"} << noyes[popt.single_precision_state] << line_end <<
+        table_prefix{"fast math level"} << popt.fast_math_level << line_end;
 }
 
 std::istream& operator>> (std::istream& i, simd_spec& spec) {
@@ -131,6 +151,43 @@ std::istream& operator>> (std::istream& i, simd_spec& spec) {
     return i;
 }
 
+// Parse NAME=VALUE, where VALUE is a number.
+to::maybe<std::pair<std::string, std::string>> parse_frozen_global(const char* arg) {
+    std::string s(arg);
+    auto eq = s.find('=');
+    if (eq==std::string::npos || eq==0) return to::nothing;
+
+    auto value = s.substr(eq+1);
+    char* end = nullptr;
+    std::strtod(value.c_str(), &end);
+    if (value.empty() || *end) return to::nothing;
+
+    return std::make_pair(s.substr(0, eq), value);
+}
+
+// Parse a positive number of iterations.
+to::maybe<unsigned> parse_iterations(const char* arg) {
+    char* end = nullptr;
+    long n = std::strtol(arg, &end, 10);
+    if (!*arg || *end || n<1 || n>100) return to::nothing;
+    return unsigned(n);
+}
+
+// Parse a non-negative tolerance.
+to::maybe<double> parse_tolerance(const char* arg) {
+    char* end = nullptr;
+    double tol = std::strtod(arg, &end);
+    if (!*arg || *end || !(tol>=0)) return to::nothing;
+    return tol;
+}
+
+// Parse accuracy level of fast maths approximations: 0 (exact), 1 or 2.
+to::maybe<unsigned> parse_fast_math_level(const char* arg) {
+    std::string s(arg);
+    if (s!="0" && s!="1" && s!="2") return to::nothing;
+    return unsigned(s[0]-'0');
+}
+
 const char* usage_str =
         "\n"
         "-o|--output            [Prefix for output file names]\n"
@@ -142,6 +199,11 @@ const char* usage_str =
         "-V|--verbose           [Toggle verbose mode]\n"
         "-A|--analyse           [Toggle analysis mode]\n"
         "-T|--trace-codegen     [Leave trace marks in generated source]\n"
+        "--single-precision-state [Store STATE variables in single precision in CPU code]\n"
+        "--fast-math-level      [Approximate exp, log, exprelr and pow in CPU code; 0 (exact, default), 1 (3 ulp) or 2 (1e-6 relative)]\n"
+        "-G|--freeze-global     [Replace GLOBAL PARAMETER by a constant; argument is NAME=VALUE]\n"
+        "--newton-iterations    [Newton iterations in derivimplicit and non-linear sparse solves; default 3]\n"
+        "--newton-tolerance     [Skip further Newton iterations once the relative update is below this; 0 to always iterate; default 1e-8]\n"
         "<filename>             [File to be compiled]\n";
 
 int main(int argc, char **argv) {
@@ -166,6 +228,22 @@ int main(int argc, char **argv) {
             opt.targets.insert(t);
         };
 
+        auto add_frozen_global = [&opt](const std::pair<std::string, std::string>& g) {
+            opt.frozen_globals.push_back(g);
+        };
+
+        auto set_fast_math_level = [&popt](unsigned level) {
+            popt.fast_math_level = level;
+        };
+
+        auto set_newton_iterations = [&opt](unsigned n) {
+            opt.newton_iterations = n;
+        };
+
+        auto set_newton_tolerance = [&opt](double tol) {
+            opt.newton_tolerance = tol;
+        };
+
         to::option options[] = {
                 { opt.modfile,  to::mandatory},
                 { opt.outprefix,                                         "-o", "--output" },
@@ -177,7 +255,12 @@ int main(int argc, char **argv) {
                 { to::action(enable_simd), to::flag,                     "-s", "--simd" },
                 { popt.simd,                                             "-S", "--simd-abi" },
                 { to::set(popt.trace_codegen), to::flag,                 "-T", "--trace-codegen"},
+                { to::set(popt.single_precision_state), to::flag,        "--single-precision-state"},
+                { to::action(set_fast_math_level, parse_fast_math_level), "--fast-math-level" },
                 { {to::action(add_target, to::keywords(targetKindMap))}, "-t", "--target" },
+                { to::action(add_frozen_global, parse_frozen_global),    "-G", "--freeze-global" },
+                { to::action(set_newton_iterations, parse_iterations),   "--newton-iterations" },
+                { to::action(set_newton_tolerance, parse_tolerance),     "--newton-tolerance" },
                 { to::action(help), to::flag, to::exit,                  "-h", "--help" }
         };
 
@@ -188,6 +271,13 @@ int main(int argc, char **argv) {
         return 1;
     }
 
+    // Single precision state is only implemented for non-SIMD CPU kernels.
+    // GPU kernels are generated alongside the CPU kernels in every catalogue
+    // build, so their state being in double precision is documented instead.
+    if (popt.single_precision_state && popt.simd.abi!=simd_spec::none) {
+        report_warning("--single-precision-state is ignored with SIMD code generation: state is stored in double precision");
+    }
+
     try {
         auto emit_header = [&opt](const char* h) {
             if (opt.verbose) {
@@ -215,6 +305,12 @@ int main(int argc, char **argv) {
             m.module_name(opt.modulename);
         }
 
+        for (auto& [name, value]: opt.frozen_globals) {
+            m.freeze_global(name, value);
+        }
+        m.newton_iterations(opt.newton_iterations);
+        m.newton_tolerance(opt.newton_tolerance);
+
         // Perform parsing and semantic analysis passes.
 
         emit_header("parsing");
@@ -142,6 +142,24 @@ bool Module::semantic() {
     // that all symbols are correctly used
     ////////////////////////////////////////////////////////////////////////////
 
+    // Frozen globals have already been replaced by their values in the
+    // parser; check that they are global (that is, non-RANGE) parameters,
+    // and drop them.
+    for (const auto& [name, value]: frozen_globals_) {
+        auto has_name = [&name](const Token& t) { return t.spelling==name; };
+        auto& ranges = neuron_block_.ranges;
+        auto& globals = neuron_block_.globals;
+        auto p = std::find_if(parameter_block_.begin(), parameter_block_.end(),
+            [&name](const Id& id) { return id.name()==name; });
+
+        if (p==parameter_block_.end() || std::any_of(ranges.begin(), ranges.end(), has_name)) {
+            error(pprintf("can not freeze '%', which is not a global PARAMETER", name));
+            return false;
+        }
+        parameter_block_.parameters.erase(p);
+        globals.erase(std::remove_if(globals.begin(), globals.end(), has_name), globals.end());
+    }
+
     // first add variables defined in the NEURON, ASSIGNED and PARAMETER
     // blocks these symbols have "global" scope, i.e. they are visible to all
     // functions and procedurs in the mechanism
@@ -205,6 +223,9 @@ bool Module::semantic() {
         return false;
     }
 
+    check_tables();
+    if (has_error()) return false;
+
     // All API methods are generated from statements in one of the special procedures
     // defined in NMODL, e.g. the init() API call is based on the INITIAL block.
     // When creating an API method, the first task is to look up the source procedure,
@@ -398,6 +419,13 @@ bool Module::semantic() {
             solver = std::make_unique<SparseSolverVisitor>(solve_expression->variant());
             break;
         }
+        case solverMethod::derivimplicit:
+            if (solve_expression->variant()==solverVariant::steadystate) {
+                error("STEADYSTATE can only be used with the sparse method", e->location());
+                return false;
+            }
+            solver = std::make_unique<SparseNonlinearSolverVisitor>(newton_iterations_, newton_tolerance_);
+            break;
         case solverMethod::none:
             solver = std::make_unique<DirectSolverVisitor>();
             break;
@@ -420,7 +448,7 @@ bool Module::semantic() {
             }
 
             if (!linear_kinetic) {
-                solver = std::make_unique<SparseNonlinearSolverVisitor>();
+                solver = std::make_unique<SparseNonlinearSolverVisitor>(newton_iterations_, newton_tolerance_);
             }
 
             rewrite_body->semantic(advance_state_scope);
@@ -535,6 +563,35 @@ bool Module::semantic() {
                     }
                 }
             }
+
+            // The NET_RECEIVE block is linear in the event weight if each statement
+            // is an assignment `s = s + c*weight` to a state variable s, where c
+            // depends on neither the weight nor any state variable. Events with the
+            // same target and delivery time can then be aggregated by summing their
+            // weights.
+            const auto& args = net_rec_api.second->args();
+            linear_net_receive_ = !state_vars.empty() && !args.empty();
+            if (linear_net_receive_) {
+                std::string weight_arg = args.front()->is_argument()->name();
+                auto vars = state_vars;
+                vars.push_back(weight_arg);
+
+                for (auto &s: net_rec_api.second->body()->statements()) {
+                    auto a = s->is_assignment();
+                    auto lhs = a? a->lhs()->is_identifier(): nullptr;
+                    if (!lhs || !std::count(state_vars.begin(), state_vars.end(), lhs->name())) {
+                        linear_net_receive_ = false;
+                        break;
+                    }
+
+                    linear_test_result r = linear_test(a->rhs(), vars);
+                    linear_net_receive_ &= r.is_linear && r.is_homogeneous;
+                    for (const auto& id: state_vars) {
+                        double coef = r.coef.count(id)? expr_value(r.coef.at(id)): 0;
+                        linear_net_receive_ &= coef == (id == lhs->name()? 1: 0);
+                    }
+                }
+            }
         }
     }
     linear_ = linear;
@@ -884,6 +941,135 @@ int Module::semantic_func_proc() {
     return errors;
 }
 
+// Collect the symbols read and assigned in a procedure body, and the
+// location of any procedure call.
+class TableBodyVisitor: public Visitor {
+public:
+    std::vector<Symbol*> reads;
+    std::vector<Symbol*> writes;
+    Location call_location;
+    bool has_call = false;
+
+    void visit(Expression*) override {}
+
+    void visit(BlockExpression* e) override {
+        for (auto& s: e->statements()) {
+            s->accept(this);
+        }
+    }
+
+    void visit(IfExpression* e) override {
+        e->condition()->accept(this);
+        e->true_branch()->accept(this);
+        if (e->false_branch()) {
+            e->false_branch()->accept(this);
+        }
+    }
+
+    void visit(AssignmentExpression* e) override {
+        if (auto lhs = e->lhs()->is_identifier()) {
+            writes.push_back(lhs->symbol());
+        }
+        e->rhs()->accept(this);
+    }
+
+    void visit(IdentifierExpression* e) override {
+        reads.push_back(e->symbol());
+    }
+
+    void visit(UnaryExpression* e) override {
+        e->expression()->accept(this);
+    }
+
+    void visit(BinaryExpression* e) override {
+        e->lhs()->accept(this);
+        e->rhs()->accept(this);
+    }
+
+    void visit(CallExpression* e) override {
+        if (!has_call) call_location = e->location();
+        has_call = true;
+    }
+};
+
+void Module::check_tables() {
+    for (auto& e: symbols_) {
+        auto proc = e.second->is_procedure();
+        if (!proc || !proc->table()) continue;
+
+        auto table = proc->table();
+        auto loc = table->location();
+        auto name = proc->name();
+
+        if (proc->args().size()!=1) {
+            error(pprintf("procedure '%' with TABLE must have exactly one argument", name), loc);
+            continue;
+        }
+
+        TableBodyVisitor v;
+        proc->body()->accept(&v);
+
+        if (v.has_call) {
+            error(pprintf("procedure '%' with TABLE can not call other procedures", name), v.call_location);
+            continue;
+        }
+
+        auto is_tabulated = [&](Symbol* s) {
+            return s && std::count(table->names().begin(), table->names().end(), s->name());
+        };
+
+        // The temperature is the only indexed variable a table can depend on.
+        auto is_celsius = [](Symbol* s) {
+            auto var = s? s->is_indexed_variable(): nullptr;
+            return var && var->data_source()==sourceKind::temperature;
+        };
+        bool depends_on_celsius = false;
+
+        for (auto& tname: table->names()) {
+            auto s = symbols_.find(tname);
+            auto var = s==symbols_.end()? nullptr: s->second->is_variable();
+            if (!var || !var->is_range() || var->is_state()) {
+                error(pprintf("TABLE variable '%' is not an ASSIGNED RANGE variable", tname), loc);
+            }
+            else if (!std::count_if(v.writes.begin(), v.writes.end(), [&](Symbol* w) { return w && w->name()==tname; })) {
+                error(pprintf("TABLE variable '%' is not assigned in procedure '%'", tname, name), loc);
+            }
+        }
+
+        for (auto& dname: table->depend()) {
+            auto s = symbols_.find(dname);
+            if (s!=symbols_.end() && is_celsius(s->second.get())) {
+                depends_on_celsius = true;
+                continue;
+            }
+            auto var = s==symbols_.end()? nullptr: s->second->is_variable();
+            if (!var || var->is_range()) {
+                error(pprintf("TABLE DEPEND '%' is not a global variable or celsius", dname), loc);
+            }
+        }
+
+        // The tabulated values may depend only on the argument, globals and,
+        // if it is a DEPEND variable, the temperature.
+        for (auto s: v.reads) {
+            if (!s || s->is_local_variable() || is_tabulated(s)) continue;
+            if (is_celsius(s)) {
+                if (!depends_on_celsius) {
+                    error(pprintf("procedure '%' with TABLE reads '%', which is not in DEPEND", name, s->name()), loc);
+                }
+                continue;
+            }
+            auto var = s->is_variable();
+            if (!var || var->is_range()) {
+                error(pprintf("procedure '%' with TABLE can not read '%'", name, s->name()), loc);
+            }
+        }
+        for (auto s: v.writes) {
+            if (!s || s->is_local_variable() || is_tabulated(s)) continue;
+            error(pprintf("procedure '%' with TABLE assigns '%', which is not in the TABLE", name, s->name()), loc);
+        }
+    }
+}
+
 void Module::check_revpot_mechanism() {
     int n_write_revpot = 0;
     for (auto& iondep: neuron_block_.ions) {
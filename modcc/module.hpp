@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iterator>
+#include <map>
 #include <string>
 #include <utility>
 #include <vector>
@@ -67,6 +68,22 @@ public:
     void parameter_block(const ParameterBlock& p) { parameter_block_ = p; }
     void assigned_block(const AssignedBlock& a) { assigned_block_ = a; }
 
+    // Replace GLOBAL PARAMETER `name` by the constant `value`, before parsing;
+    // the global is removed from the mechanism interface.
+    void freeze_global(const std::string& name, const std::string& value) { frozen_globals_[name] = value; }
+    const std::map<std::string, std::string>& frozen_globals() const { return frozen_globals_; }
+
+    // Number of Newton iterations in the backward Euler step of non-linear
+    // systems (derivimplicit, or sparse with a non-linear KINETIC block).
+    void newton_iterations(unsigned n) { newton_iterations_ = n; }
+    unsigned newton_iterations() const { return newton_iterations_; }
+
+    // Iterations after the first stop once the largest update of a state,
+    // relative to the state where that exceeds one, is at most the tolerance;
+    // zero always runs all iterations.
+    void newton_tolerance(double tol) { newton_tolerance_ = tol; }
+    double newton_tolerance() const { return newton_tolerance_; }
+
     // Add global procedure or function, before semantic pass (called from Parser).
     void add_callable(symbol_ptr callable);
 
@@ -105,6 +122,7 @@ public:
 
     bool is_linear() const { return linear_; }
     bool has_post_events() const { return post_events_; }
+    bool has_linear_net_receive() const { return linear_net_receive_; }
 
 private:
     moduleKind kind_;
@@ -120,6 +138,10 @@ private:
     AssignedBlock assigned_block_;
     bool linear_;
     bool post_events_;
+    bool linear_net_receive_ = false;
+    std::map<std::string, std::string> frozen_globals_;
+    unsigned newton_iterations_ = 3;
+    double newton_tolerance_ = 1e-8;
 
     // AST storage.
     std::vector<symbol_ptr> callables_;
@@ -144,6 +166,10 @@ private:
     // Check requirements for reversal potential setters.
     void check_revpot_mechanism();
 
+    // Check that tabulated procedures (see TableExpression) depend only on
+    // their argument and global variables.
+    void check_tables();
+
     // Perform semantic analysis on functions and procedures.
     // Returns the number of errors that were encountered.
     int semantic_func_proc();
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstring>
 #include <string>
 
@@ -61,6 +62,7 @@ void Parser::error(std::string msg, Location loc) {
 
 Parser::Parser(Module& m, bool advance):
     Lexer(m.buffer()),
+    constants_map_(m.frozen_globals().begin(), m.frozen_globals().end()),
     module_(&m) {
     // prime the first token
     get_token();
@@ -889,6 +891,26 @@ void Parser::parse_title() {
     get_token();
 }
 
+// Remove the TABLE statement from the top level of a procedure or function
+// body and return it; at most one TABLE statement is allowed.
+expression_ptr Parser::take_table_statement(BlockExpression* body) {
+    expression_ptr table;
+    auto& statements = body->statements();
+    for (auto it = statements.begin(); it != statements.end();) {
+        if (!(*it)->is_table_statement()) {
+            ++it;
+            continue;
+        }
+        if (table) {
+            error("only one TABLE statement is allowed in a block", (*it)->location());
+            return nullptr;
+        }
+        table = std::move(*it);
+        it = statements.erase(it);
+    }
+    return table;
+}
+
 /// parse a procedure
 /// can handle both PROCEDURE and INITIAL blocks
 /// an initial block is stored as a procedure with name 'initial' and empty argument list
@@ -953,6 +975,13 @@ symbol_ptr Parser::parse_procedure() {
     expression_ptr body = parse_block(false);
     if (body == nullptr) return nullptr;
 
+    expression_ptr table = take_table_statement(body->is_block());
+    if (table && kind != procedureKind::normal) {
+        error("TABLE statements are only allowed in PROCEDURE and FUNCTION blocks", table->location());
+        return nullptr;
+    }
+    if (status_ == lexerStatus::error) return nullptr;
+
     auto proto = p->is_prototype();
     if(kind == procedureKind::net_receive) {
         return make_symbol<NetReceiveExpression> (proto->location(), proto->name(), std::move(proto->args()), std::move(body));
@@ -960,7 +989,9 @@ symbol_ptr Parser::parse_procedure() {
     if(kind == procedureKind::post_event) {
         return make_symbol<PostEventExpression> (proto->location(), proto->name(), std::move(proto->args()), std::move(body));
     }
-    return make_symbol<ProcedureExpression> (proto->location(), proto->name(), std::move(proto->args()), std::move(body), kind);
+    auto proc = make_symbol<ProcedureExpression> (proto->location(), proto->name(), std::move(proto->args()), std::move(body), kind);
+    if (table) proc->is_procedure()->table(std::move(table));
+    return proc;
 }
 
 symbol_ptr Parser::parse_function() {
@@ -988,6 +1019,15 @@ symbol_ptr Parser::parse_function() {
     auto body = parse_block(false);
     if (body == nullptr) return nullptr;
 
+    // Functions are inlined at their call sites, where they are evaluated
+    // directly: a TABLE statement in a function is ignored.
+    if (auto table = take_table_statement(body->is_block())) {
+        if (module_) {
+            module_->warning("TABLE statement in FUNCTION is ignored", table->location());
+        }
+    }
+    if (status_ == lexerStatus::error) return nullptr;
+
     PrototypeExpression* proto = p->is_prototype();
     return make_symbol<FunctionExpression>(proto->location(), proto->name(), std::move(proto->args()), std::move(body));
 }
@@ -1003,6 +1043,8 @@ expression_ptr Parser::parse_statement() {
         break;
     case tok::conductance:
         return parse_conductance();
+    case tok::table:
+        return parse_table();
     case tok::solve:
         return parse_solve();
     case tok::local:
@@ -1587,6 +1629,9 @@ expression_ptr Parser::parse_solve() {
         case tok::sparse:
             method = solverMethod::sparse;
             break;
+        case tok::derivimplicit:
+            method = solverMethod::derivimplicit;
+            break;
         default:
             goto solve_statement_error;
         }
@@ -1608,11 +1653,87 @@ solve_statement_error:
           "    or\n"
           "  SOLVE x\n"
           "where 'x' is the name of a DERIVATIVE block and "
-          "'method' is 'cnexp' or 'sparse'",
+          "'method' is 'cnexp', 'sparse' or 'derivimplicit'",
         loc);
     return nullptr;
 }
 
+/// parse TABLE statement with the form
+///     TABLE name [, name ...] [DEPEND name [, name ...]] FROM lb TO ub WITH n
+/// where lb and ub are numeric constants and n is a positive integer
+expression_ptr Parser::parse_table() {
+    Location loc = location_;
+    std::vector<std::string> names;
+    std::vector<std::string> depend;
+
+    // Read an optional comma separated list of identifiers following the
+    // current keyword, leaving the token after the list.
+    auto identifiers = [this](std::vector<std::string>& out) {
+        if (peek().type != tok::identifier) {
+            get_token();
+            return;
+        }
+        for (auto& t: comma_separated_identifiers()) {
+            out.push_back(t.spelling);
+        }
+    };
+
+    identifiers(names); // consumes the TABLE keyword
+    if (status_ == lexerStatus::error) return nullptr;
+
+    if (token_.type == tok::depend) {
+        identifiers(depend);
+        if (status_ == lexerStatus::error) return nullptr;
+        if (depend.empty()) {
+            error("expected a variable name after DEPEND");
+            return nullptr;
+        }
+        // Frozen globals are constants, so the table never has to be
+        // rebuilt for them.
+        if (module_) {
+            auto& frozen = module_->frozen_globals();
+            depend.erase(std::remove_if(depend.begin(), depend.end(),
+                    [&frozen](const std::string& d) { return frozen.count(d); }),
+                depend.end());
+        }
+    }
+
+    if (token_.type != tok::from) {
+        error(pprintf("expected '%', found '%'", yellow("FROM"), yellow(token_.spelling)));
+        return nullptr;
+    }
+    get_token(); // consume FROM
+    auto from = value_literal();
+    if (status_ == lexerStatus::error) return nullptr;
+
+    if (token_.type != tok::to) {
+        error(pprintf("expected '%', found '%'", yellow("TO"), yellow(token_.spelling)));
+        return nullptr;
+    }
+    get_token(); // consume TO
+    auto to = value_literal();
+    if (status_ == lexerStatus::error) return nullptr;
+
+    if (token_.type != tok::with) {
+        error(pprintf("expected '%', found '%'", yellow("WITH"), yellow(token_.spelling)));
+        return nullptr;
+    }
+    get_token(); // consume WITH
+    int n = value_signed_integer();
+    if (status_ == lexerStatus::error) return nullptr;
+
+    if (n <= 0) {
+        error("TABLE must have a positive number of intervals", loc);
+        return nullptr;
+    }
+    if (!(std::stod(from) < std::stod(to))) {
+        error("TABLE range FROM lb TO ub must have lb < ub", loc);
+        return nullptr;
+    }
+
+    return make_expression<TableExpression>(loc, std::move(names), std::move(depend), std::stod(from), std::stod(to), n);
+}
+
 /// parse a CONDUCTANCE statement
 /// a CONDUCTANCE statement specifies a variable and a channel
 /// where the channel is optional
@@ -1720,6 +1841,10 @@ expression_ptr Parser::parse_block(bool is_nested) {
                 error("reaction expressions are not allowed inside a nested scope");
                 return nullptr;
             }
+            if (e->is_table_statement()) {
+                error("TABLE statements are not allowed inside a nested scope");
+                return nullptr;
+            }
         }
 
         body.emplace_back(std::move(e));
@@ -35,6 +35,7 @@ public:
     expression_ptr parse_local();
     expression_ptr parse_solve();
     expression_ptr parse_conductance();
+    expression_ptr parse_table();
     expression_ptr parse_block(bool);
     expression_ptr parse_initial();
     expression_ptr parse_compartment_statement();
@@ -69,6 +70,7 @@ private:
     int value_signed_integer();
     std::pair<std::string, std::string> range_description();
     std::pair<std::string, std::string> from_to_description();
+    expression_ptr take_table_statement(BlockExpression*);
 
     /// build the identifier list
     void add_variables_to_symbols();
@@ -33,6 +33,16 @@ std::ostream& operator<<(std::ostream& out, as_c_double wrap) {
     }
 }
 
+std::string CExprEmitter::math_spelling(tok op, const std::string& spelling) const {
+    bool has_fast = op==tok::exp || op==tok::log || op==tok::exprelr || op==tok::pow;
+    if (!fast_math_level_ || !has_fast) return spelling;
+
+    // Qualified names keep their qualification: S::exp -> S::fast_exp<L>.
+    auto pos = spelling.rfind("::");
+    pos = pos==std::string::npos? 0: pos+2;
+    return spelling.substr(0, pos)+"fast_"+spelling.substr(pos)+"<"+std::to_string(fast_math_level_)+">";
+}
+
 void CExprEmitter::emit_as_call(const char* sub, Expression* e) {
     out_ << sub << '(';
     e->accept(this);
@@ -70,7 +80,7 @@ void CExprEmitter::visit(UnaryExpression* e) {
             "CExprEmitter: unsupported unary operator "+token_string(e->op()), e->location());
     }
 
-    const char* op_spelling = unaryop_tbl.at(e->op());
+    auto op_spelling = math_spelling(e->op(), unaryop_tbl.at(e->op()));
     Expression* inner = e->expression();
 
     // No need to use parenthesis for unary minus if inner expression is
@@ -80,7 +90,7 @@ void CExprEmitter::visit(UnaryExpression* e) {
         inner->accept(this);
     }
     else {
-        emit_as_call(op_spelling, inner);
+        emit_as_call(op_spelling.c_str(), inner);
     }
 }
 
@@ -91,7 +101,7 @@ void CExprEmitter::visit(AssignmentExpression* e) {
 }
 
 void CExprEmitter::visit(PowBinaryExpression* e) {
-    emit_as_call("pow", e->lhs(), e->rhs());
+    emit_as_call(math_spelling(tok::pow, "pow").c_str(), e->lhs(), e->rhs());
 }
 
 void CExprEmitter::visit(BinaryExpression* e) {
@@ -178,7 +188,7 @@ void CExprEmitter::visit(IfExpression* e) {
 std::unordered_set<std::string> SimdExprEmitter::mask_names_;
 
 void SimdExprEmitter::visit(PowBinaryExpression* e) {
-    out_ << "S::pow(";
+    out_ << math_spelling(tok::pow, "S::pow") << '(';
     e->lhs()->accept(this);
     out_ << ", ";
     e->rhs()->accept(this);
@@ -206,7 +216,7 @@ void SimdExprEmitter::visit(UnaryExpression* e) {
             "CExprEmitter: unsupported unary operator "+token_string(e->op()), e->location());
     }
 
-    const char* op_spelling = unaryop_tbl.at(e->op());
+    auto op_spelling = math_spelling(e->op(), unaryop_tbl.at(e->op()));
     Expression* inner = e->expression();
 
     auto iden = inner->is_identifier();
@@ -217,7 +227,7 @@ void SimdExprEmitter::visit(UnaryExpression* e) {
         out_ << ")";
     }
     else {
-        emit_as_call(op_spelling, inner);
+        emit_as_call(op_spelling.c_str(), inner);
     }
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iosfwd>
+#include <string>
 #include <unordered_set>
 
 #include "expression.hpp"
@@ -12,8 +13,8 @@
 
 class CExprEmitter: public Visitor {
 public:
-    CExprEmitter(std::ostream& out, Visitor* fallback):
-        out_(out), fallback_(fallback)
+    CExprEmitter(std::ostream& out, Visitor* fallback, unsigned fast_math_level = 0):
+        out_(out), fallback_(fallback), fast_math_level_(fast_math_level)
     {}
 
     void visit(Expression* e) override { e->accept(fallback_); }
@@ -29,12 +30,20 @@ protected:
     std::ostream& out_;
     Visitor* fallback_;
 
+    // Non-zero: call the fast approximations of exp, log, exprelr and pow
+    // with this accuracy level (see arbor/fast_math.hpp).
+    unsigned fast_math_level_;
+
     void emit_as_call(const char* sub, Expression*);
     void emit_as_call(const char* sub, Expression*, Expression*);
+
+    // Spelling of a call to the function `spelling` (optionally qualified),
+    // or to its fast approximation if it has one and fast_math_level_ is set.
+    std::string math_spelling(tok op, const std::string& spelling) const;
 };
 
-inline void cexpr_emit(Expression* e, std::ostream& out, Visitor* fallback) {
-    CExprEmitter emitter(out, fallback);
+inline void cexpr_emit(Expression* e, std::ostream& out, Visitor* fallback, unsigned fast_math_level = 0) {
+    CExprEmitter emitter(out, fallback, fast_math_level);
     e->accept(&emitter);
 }
 
@@ -46,8 +55,9 @@ public:
         bool is_indirect,
         std::string input_mask,
         const std::unordered_set<std::string>& scalars,
-        Visitor* fallback):
-            CExprEmitter(out, fallback), is_indirect_(is_indirect), input_mask_(input_mask), scalars_(scalars), fallback_(fallback) {}
+        Visitor* fallback,
+        unsigned fast_math_level = 0):
+            CExprEmitter(out, fallback, fast_math_level), is_indirect_(is_indirect), input_mask_(input_mask), scalars_(scalars), fallback_(fallback) {}
 
     void visit(BlockExpression *e) override;
     void visit(CallExpression *e) override;
@@ -84,9 +94,10 @@ inline void simd_expr_emit(
         bool is_indirect,
         std::string input_mask,
         const std::unordered_set<std::string>& scalars,
-        Visitor* fallback)
+        Visitor* fallback,
+        unsigned fast_math_level = 0)
 {
-    SimdExprEmitter emitter(out, is_indirect, input_mask, scalars, fallback);
+    SimdExprEmitter emitter(out, is_indirect, input_mask, scalars, fallback, fast_math_level);
     e->accept(&emitter);
 }
 
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <regex>
@@ -42,11 +43,22 @@ void emit_procedure_proto(std::ostream&, ProcedureExpression*, const std::string
 void emit_simd_procedure_proto(std::ostream&, ProcedureExpression*, const std::string&, const std::string& qualified = "");
 void emit_masked_simd_procedure_proto(std::ostream&, ProcedureExpression*, const std::string&, const std::string& qualified = "");
 
-void emit_api_body(std::ostream&, APIMethod*, bool cv_loop = true);
-void emit_simd_api_body(std::ostream&, APIMethod*, const std::vector<VariableExpression*>& scalars);
+void emit_api_body(std::ostream&, APIMethod*, const printer_options&, bool cv_loop = true);
+void emit_simd_api_body(std::ostream&, APIMethod*, const std::vector<VariableExpression*>& scalars, const printer_options&);
 
 void emit_simd_index_initialize(std::ostream& out, const std::list<index_prop>& indices, simd_expr_constraint constraint);
 
+std::vector<ProcedureExpression*> tabulated_procedures(const Module&);
+void emit_table_point_proto(std::ostream&, ProcedureExpression*, const std::string&);
+void emit_table_update_proto(std::ostream&, ProcedureExpression*, const std::string&);
+void emit_table_update(std::ostream&, ProcedureExpression*, const std::string&);
+void emit_table_lookup(std::ostream&, ProcedureExpression*);
+void emit_simd_table_lookup(std::ostream&, ProcedureExpression*, bool masked);
+std::string table_update_name(ProcedureExpression*);
+
+bool is_simd_net_receive(APIMethod*);
+void emit_simd_apply_events(std::ostream&, APIMethod*, const std::string& kernel_name, const std::vector<VariableExpression*>& scalars, const printer_options&);
+
 void emit_simd_body_for_loop(std::ostream& out,
                              BlockExpression* body,
                              const std::vector<LocalVariable*>& indexed_vars,
@@ -61,10 +73,19 @@ void emit_simd_for_loop_per_constraint(std::ostream& out, BlockExpression* body,
 
 struct cprint {
     Expression* expr_;
-    explicit cprint(Expression* expr): expr_(expr) {}
+    const printer_options& opt_;
+    bool is_uniform_ = false;
+    explicit cprint(Expression* expr, const printer_options& opt): expr_(expr), opt_(opt) {}
+
+    void set_uniform_fields() {
+        is_uniform_ = true;
+    }
 
     friend std::ostream& operator<<(std::ostream& out, const cprint& w) {
         CPrinter printer(out);
+        printer.set_single_precision_state(w.opt_.single_precision_state && w.opt_.simd.abi==simd_spec::none);
+        printer.set_uniform_fields(w.is_uniform_);
+        printer.set_fast_math_level(w.opt_.fast_math_level);
         return w.expr_->accept(&printer), out;
     }
 };
@@ -72,10 +93,13 @@ struct cprint {
 struct simdprint {
     Expression* expr_;
     bool is_indirect_ = false;
+    bool is_gathered_ = false;
     bool is_masked_ = false;
+    bool is_uniform_ = false;
     std::unordered_set<std::string> scalars_;
+    const printer_options& opt_;
 
-    explicit simdprint(Expression* expr, const std::vector<VariableExpression*>& scalars): expr_(expr) {
+    explicit simdprint(Expression* expr, const std::vector<VariableExpression*>& scalars, const printer_options& opt): expr_(expr), opt_(opt) {
         for (const auto& s: scalars) {
             scalars_.insert(s->name());
         }
@@ -84,9 +108,15 @@ struct simdprint {
     void set_indirect_index() {
         is_indirect_ = true;
     }
+    void set_gathered_index() {
+        is_gathered_ = true;
+    }
     void set_masked() {
         is_masked_ = true;
     }
+    void set_uniform_fields() {
+        is_uniform_ = true;
+    }
 
     friend std::ostream& operator<<(std::ostream& out, const simdprint& w) {
         SimdPrinter printer(out);
@@ -94,11 +124,33 @@ struct simdprint {
             printer.set_input_mask("mask_input_");
         }
         printer.set_var_indexed(w.is_indirect_);
+        printer.set_var_gathered(w.is_gathered_);
+        printer.set_uniform_fields(w.is_uniform_);
         printer.save_scalar_names(w.scalars_);
+        printer.set_fast_math_level(w.opt_.fast_math_level);
         return w.expr_->accept(&printer), out;
     }
 };
 
+// RANGE parameters are read-only in the kernels; when a parameter has the
+// same value for all instances, the back end points <name>_uniform_ at that
+// value. The loop of each API method is emitted twice: a variant that reads
+// the parameters it uses as scalars, taken if all of them are uniform, and a
+// variant that reads the value of each instance. The printers of the former
+// are set to read the scalars with set_uniform_fields.
+
+static bool is_uniform_field(const VariableExpression* array) {
+    return array->is_range() && !array->is_state() && array->access()==accessKind::read;
+}
+
+static std::string uniform_field(const VariableExpression* array) {
+    return "pp->"+array->name()+"_uniform_";
+}
+
+static std::string uniform_field_value(const VariableExpression* array) {
+    return array->name()+"_uniform_value_";
+}
+
 static std::string ion_state_field(std::string ion_name) {
     return "ion_"+ion_name+"_";
 }
@@ -124,6 +176,12 @@ std::string emit_cpp_source(const Module& module_, const printer_options& opt) {
     bool with_simd = opt.simd.abi!=simd_spec::none;
 
     options_trace_codegen = opt.trace_codegen;
+
+    // STATE variables are stored in single precision (see printer_options).
+    bool single_precision_state = opt.single_precision_state && !with_simd;
+    auto is_float_field = [single_precision_state](const VariableExpression* array) {
+        return single_precision_state && array->is_state();
+    };
     
     // init_api, state_api, current_api methods are mandatory:
 
@@ -133,6 +191,7 @@ std::string emit_cpp_source(const Module& module_, const printer_options& opt) {
 
     auto vars = local_module_variables(module_);
     auto ion_deps = module_.ion_deps();
+    auto tables = tabulated_procedures(module_);
     std::string fingerprint = "<placeholder>";
 
     auto profiler_enter = [name, opt](const char* region_prefix) -> std::string {
@@ -168,6 +227,12 @@ std::string emit_cpp_source(const Module& module_, const printer_options& opt) {
         "#include <" << arb_private_header_prefix() << "backends/multicore/mechanism.hpp>\n"
         "#include <" << arb_header_prefix() << "math.hpp>\n";
 
+    opt.fast_math_level &&
+        out << "#include <" << arb_header_prefix() << "fast_math.hpp>\n";
+
+    tables.size() &&
+        out << "#include <vector>\n";
+
     opt.profile &&
         out << "#include <" << arb_header_prefix() << "profile/profiler.hpp>\n";
 
@@ -191,8 +256,16 @@ std::string emit_cpp_source(const Module& module_, const printer_options& opt) {
         "using ::std::max;\n"
         "using ::std::min;\n"
         "using ::std::pow;\n"
-        "using ::std::sin;\n"
-        "\n";
+        "using ::std::sin;\n";
+
+    opt.fast_math_level &&
+        out <<
+            "using ::arb::math::fast_exp;\n"
+            "using ::arb::math::fast_exprelr;\n"
+            "using ::arb::math::fast_log;\n"
+            "using ::arb::math::fast_pow;\n";
+
+    out << "\n";
 
     if (with_simd) {
         out <<
@@ -247,20 +320,39 @@ std::string emit_cpp_source(const Module& module_, const printer_options& opt) {
         out << "::arb::fvm_value_type " << scalar->name() <<  " = " << as_c_double(scalar->value()) << ";\n";
     }
     for (const auto& array: vars.arrays) {
-        out << "::arb::fvm_value_type* " << array->name() << ";\n";
+        out << (is_float_field(array)? "float* ": "::arb::fvm_value_type* ") << array->name() << ";\n";
+    }
+    for (const auto& array: vars.arrays) {
+        if (is_uniform_field(array)) {
+            out << "const ::arb::fvm_value_type* " << array->name() << "_uniform_ = nullptr;\n";
+        }
     }
     for (const auto& dep: ion_deps) {
         out << "::arb::ion_state_view " << ion_state_field(dep.name) << ";\n";
         out << "::arb::fvm_index_type* " << ion_state_index(dep.name) << ";\n";
     }
+    for (auto proc: tables) {
+        out << "std::vector<::arb::fvm_value_type> " << proc->name() << "_table_;\n";
+        if (!proc->table()->depend().empty()) {
+            out << "std::vector<::arb::fvm_value_type> " << proc->name() << "_table_depend_;\n";
+        }
+    }
     out << popindent << "};\n\n";
 
     // Make implementations
     auto emit_body = [&](APIMethod *p) {
         if (with_simd) {
-            emit_simd_api_body(out, p, vars.scalars);
+            emit_simd_api_body(out, p, vars.scalars, opt);
         } else {
-            emit_api_body(out, p);
+            emit_api_body(out, p, opt);
+        }
+    };
+
+    // Rebuild lookup tables for tabulated procedures if required.
+    auto emit_table_updates = [&](APIMethod* api = nullptr) {
+        if (api && api->body()->statements().empty()) return;
+        for (auto proc: tables) {
+            out << table_update_name(proc) << "(pp);\n";
         }
     };
 
@@ -278,26 +370,36 @@ std::string emit_cpp_source(const Module& module_, const printer_options& opt) {
             out << ";\n";
         }
     }
+    for (auto proc: tables) {
+        emit_table_point_proto(out, proc, ppack_name);
+        out << ";\n";
+        emit_table_update_proto(out, proc, ppack_name);
+        out << ";\n";
+    }
     out << "\n";
 
     out << "// interface methods\n";
     out << "void init(" << ppack_name << "* pp) {\n" << indent;
+    emit_table_updates(init_api);
     emit_body(init_api);
     out << popindent << "}\n\n";
 
     out << "void advance_state(" << ppack_name << "* pp) {\n" << indent;
     out << profiler_enter("advance_integrate_state");
+    emit_table_updates(state_api);
     emit_body(state_api);
     out << profiler_leave();
     out << popindent << "}\n\n";
 
     out << "void compute_currents(" << ppack_name << "* pp) {\n" << indent;
     out << profiler_enter("advance_integrate_current");
+    emit_table_updates(current_api);
     emit_body(current_api);
     out << profiler_leave();
     out << popindent << "}\n\n";
 
     out << "void write_ions(" << ppack_name << "* pp) {\n" << indent;
+    emit_table_updates(write_ions_api);
     emit_body(write_ions_api);
     out << popindent << "}\n\n";
 
@@ -305,26 +407,45 @@ std::string emit_cpp_source(const Module& module_, const printer_options& opt) {
         const std::string weight_arg = net_receive_api->args().empty() ? "weight" : net_receive_api->args().front()->is_argument()->name();
         out <<
             "void net_receive(" << ppack_name << "* pp, int i_, ::arb::fvm_value_type " << weight_arg << ") {\n" << indent;
-            emit_api_body(out, net_receive_api, false);
+            emit_api_body(out, net_receive_api, opt, false);
             out << popindent <<
-            "}\n\n"
-            "void apply_events(" << ppack_name << "* pp, ::arb::fvm_size_type mechanism_id, ::arb::multicore::deliverable_event_stream::state events) {\n" << indent <<
+            "}\n\n";
+
+        if (with_simd && is_simd_net_receive(net_receive_api)) {
+            out << "void apply_events(" << ppack_name << "* pp, ::arb::multicore::deliverable_event_stream::state events) {\n" << indent;
+            out << profiler_enter("advance_integrate_deliver");
+            emit_table_updates();
+            emit_simd_apply_events(out, net_receive_api, namespace_name, vars.scalars, opt);
+            out << profiler_leave();
+            out << popindent << "}\n\n";
+        }
+        else {
+            out <<
+            "void apply_events(" << ppack_name << "* pp, ::arb::multicore::deliverable_event_stream::state events) {\n" << indent;
+            out << profiler_enter("advance_integrate_deliver");
+            emit_table_updates();
+            out <<
             "auto ncell = events.n_streams();\n"
             "for (::arb::fvm_size_type c = 0; c<ncell; ++c) {\n" << indent <<
             "auto begin = events.begin_marked(c);\n"
             "auto end = events.end_marked(c);\n"
             "for (auto p = begin; p<end; ++p) {\n" << indent <<
-            "if (p->mech_id==mechanism_id) " << namespace_name << "::net_receive(pp, p->mech_index, p->weight);\n" << popindent <<
-            "}\n" << popindent <<
+            namespace_name << "::net_receive(pp, p->mech_index, p->weight);\n" << popindent <<
             "}\n" << popindent <<
+            "}\n";
+            out << profiler_leave();
+            out << popindent <<
             "}\n"
             "\n";
+        }
     }
 
     if(post_event_api) {
         const std::string time_arg = post_event_api->args().empty() ? "time" : post_event_api->args().front()->is_argument()->name();
         out <<
-            "void post_event(" << ppack_name << "* pp) {\n" << indent <<
+            "void post_event(" << ppack_name << "* pp) {\n" << indent;
+            emit_table_updates();
+            out <<
             "int n_ = pp->width_;\n"
             "for (int i_ = 0; i_ < n_; ++i_) {\n" << indent <<
             "auto node_index_i_ = pp->node_index_[i_];\n"
@@ -333,7 +454,7 @@ std::string emit_cpp_source(const Module& module_, const printer_options& opt) {
             "for (::arb::fvm_index_type c = 0; c < pp->n_detectors_; c++) {\n" << indent <<
             "auto " << time_arg << " = pp->time_since_spike_[offset_ + c];\n"
             "if (" <<  time_arg << " >= 0) {\n" << indent;
-            emit_api_body(out, post_event_api, false);
+            emit_api_body(out, post_event_api, opt, false);
             out << popindent <<
             "}\n" << popindent <<
             "}\n" << popindent <<
@@ -344,20 +465,44 @@ std::string emit_cpp_source(const Module& module_, const printer_options& opt) {
 
     out << "// Procedure definitions\n";
     for (auto proc: normal_procedures(module_)) {
-        if (with_simd) {
+        if (proc->table()) {
+            emit_table_point_proto(out, proc, ppack_name);
+            out << " {\n" << indent << cprint(proc->body(), opt) << popindent << "}\n\n";
+
+            emit_table_update(out, proc, ppack_name);
+
+            if (with_simd) {
+                emit_simd_procedure_proto(out, proc, ppack_name);
+                out << " {\n" << indent;
+                emit_simd_table_lookup(out, proc, false);
+                out << popindent << "}\n\n";
+
+                emit_masked_simd_procedure_proto(out, proc, ppack_name);
+                out << " {\n" << indent;
+                emit_simd_table_lookup(out, proc, true);
+                out << popindent << "}\n\n";
+            }
+            else {
+                emit_procedure_proto(out, proc, ppack_name);
+                out << " {\n" << indent;
+                emit_table_lookup(out, proc);
+                out << popindent << "}\n\n";
+            }
+        }
+        else if (with_simd) {
             emit_simd_procedure_proto(out, proc, ppack_name);
-            auto simd_print = simdprint(proc->body(), vars.scalars);
+            auto simd_print = simdprint(proc->body(), vars.scalars, opt);
             out << " {\n" << indent << simd_print << popindent <<  "}\n\n";
 
             emit_masked_simd_procedure_proto(out, proc, ppack_name);
-            auto masked_print = simdprint(proc->body(), vars.scalars);
+            auto masked_print = simdprint(proc->body(), vars.scalars, opt);
             masked_print.set_masked();
             out << " {\n" << indent << masked_print << popindent << "}\n\n";
         } else {
             emit_procedure_proto(out, proc, ppack_name);
             out <<
                 " {\n" << indent <<
-                cprint(proc->body()) << popindent <<
+                cprint(proc->body(), opt) << popindent <<
                 "}\n\n";
         }
     }
@@ -381,7 +526,7 @@ std::string emit_cpp_source(const Module& module_, const printer_options& opt) {
         "void write_ions() override{ " << namespace_name << "::write_ions(&pp_); }\n";
 
     net_receive_api &&
-        out << "void apply_events(deliverable_event_stream::state events) override { " << namespace_name << "::apply_events(&pp_, mechanism_id_, events); }\n";
+        out << "void apply_events(deliverable_event_stream::state events) override { " << namespace_name << "::apply_events(&pp_, events); }\n";
 
     post_event_api &&
         out << "void post_event() override { " << namespace_name <<  "::post_event(&pp_); };\n";
@@ -416,10 +561,27 @@ std::string emit_cpp_source(const Module& module_, const printer_options& opt) {
         sep.reset();
         for (const auto& array: vars.arrays) {
             auto memb = array->name();
-            out << sep << "{" << quote(memb) << ", &pp_." << memb << "}";
+            if (!is_float_field(array)) {
+                out << sep << "{" << quote(memb) << ", &pp_." << memb << "}";
+            }
         }
         out << popindent << "\n};" << popindent << "\n}\n";
 
+        if (single_precision_state) {
+            out <<
+                "mechanism_float_field_table float_field_table() override {\n" << indent <<
+                "return {" << indent;
+
+            sep.reset();
+            for (const auto& array: vars.arrays) {
+                auto memb = array->name();
+                if (is_float_field(array)) {
+                    out << sep << "{" << quote(memb) << ", &pp_." << memb << "}";
+                }
+            }
+            out << popindent << "\n};" << popindent << "\n}\n";
+        }
+
         out <<
             "mechanism_field_default_table field_default_table() override {\n" << indent <<
             "return {" << indent;
@@ -434,6 +596,21 @@ std::string emit_cpp_source(const Module& module_, const printer_options& opt) {
         }
         out << popindent << "\n};" << popindent << "\n}\n";
 
+        if (std::any_of(vars.arrays.begin(), vars.arrays.end(), is_uniform_field)) {
+            out <<
+                "mechanism_uniform_field_table uniform_field_table() override {\n" << indent <<
+                "return {" << indent;
+
+            sep.reset();
+            for (const auto& array: vars.arrays) {
+                auto memb = array->name();
+                if (is_uniform_field(array)) {
+                    out << sep << "{" << quote(memb) << ", &pp_." << memb << "_uniform_}";
+                }
+            }
+            out << popindent << "\n};" << popindent << "\n}\n";
+        }
+
         out <<
             "mechanism_state_table state_table() override {\n" << indent <<
             "return {" << indent;
@@ -441,7 +618,7 @@ std::string emit_cpp_source(const Module& module_, const printer_options& opt) {
         sep.reset();
         for (const auto& array: vars.arrays) {
             auto memb = array->name();
-            if(array->is_state()) {
+            if(array->is_state() && !is_float_field(array)) {
                 out << sep << "{" << quote(memb) << ", &pp_." << memb << "}";
             }
         }
@@ -495,7 +672,36 @@ void CPrinter::visit(LocalVariable* sym) {
 }
 
 void CPrinter::visit(VariableExpression *sym) {
-    out_ << "pp->" << sym->name() << (sym->is_range()? "[i_]": "");
+    if (single_precision_state_ && sym->is_state() && !is_lhs_) {
+        out_ << "::arb::fvm_value_type(pp->" << sym->name() << "[i_])";
+    }
+    else if (read_uniform_fields_ && is_uniform_field(sym)) {
+        out_ << uniform_field_value(sym);
+    }
+    else {
+        out_ << "pp->" << sym->name() << (sym->is_range()? "[i_]": "");
+    }
+}
+
+// Indexed variables are read directly only in the body of a tabulated
+// procedure, which may read the temperature.
+void CPrinter::visit(IndexedVariable* sym) {
+    auto d = decode_indexed_variable(sym);
+    if (sym->is_write() || d.scalar() || !d.cell_index_var.empty()) {
+        throw compiler_exception("CPrinter cannot read indexed variable "+sym->to_string());
+    }
+    out_ << "pp->" << d.data_var << "[pp->" << d.node_index_var << "[i_]]";
+    if (d.scale!=1) {
+        out_ << "*" << as_c_double(d.scale);
+    }
+}
+
+void CPrinter::visit(AssignmentExpression* e) {
+    is_lhs_ = true;
+    e->lhs()->accept(this);
+    is_lhs_ = false;
+    out_ << " = ";
+    e->rhs()->accept(this);
 }
 
 void CPrinter::visit(CallExpression* e) {
@@ -563,6 +769,81 @@ namespace {
             return o << data_via_ppack(wrap.d) << '[' << (wrap.d.scalar() ? "0": i_name) << ']';
         }
     };
+
+    // Time and dt are the same for all CVs while dt_uniform_ is non-negative
+    // (see multicore::shared_state::dt_uniform), and are then read as scalars
+    // instead of through the CV and integration domain indices.
+    bool is_uniform_time(LocalVariable* local) {
+        auto kind = local->external_variable()->data_source();
+        return local->is_read() && (kind==sourceKind::dt || kind==sourceKind::time);
+    }
+
+    std::string uniform_time_value(LocalVariable* local) {
+        return local->external_variable()->data_source()==sourceKind::dt? "dt_uniform_": "pp->vec_t_[0]";
+    }
+
+    void emit_uniform_time_read(std::ostream& out, const std::vector<LocalVariable*>& indexed_vars) {
+        if (std::any_of(indexed_vars.begin(), indexed_vars.end(), is_uniform_time)) {
+            out << "auto dt_uniform_ = *pp->dt_uniform_;\n";
+        }
+    }
+
+    // Collect the uniform RANGE parameters read in a kernel body, excluding
+    // those read in the procedures it calls.
+    class uniform_field_visitor: public Visitor {
+    public:
+        std::vector<VariableExpression*> fields;
+
+        void visit(Expression*) override {}
+        void visit(IdentifierExpression* e) override {
+            auto var = e->symbol()? e->symbol()->is_variable(): nullptr;
+            if (var && is_uniform_field(var) && !std::count(fields.begin(), fields.end(), var)) {
+                fields.push_back(var);
+            }
+        }
+        void visit(AssignmentExpression* e) override { e->rhs()->accept(this); }
+        void visit(CallExpression* e) override {
+            for (auto& a: e->args()) a->accept(this);
+        }
+        void visit(UnaryExpression* e) override { e->expression()->accept(this); }
+        void visit(BinaryExpression* e) override {
+            e->lhs()->accept(this);
+            e->rhs()->accept(this);
+        }
+        void visit(IfExpression* e) override {
+            e->condition()->accept(this);
+            e->true_branch()->accept(this);
+            if (e->false_branch()) e->false_branch()->accept(this);
+        }
+        void visit(BlockExpression* e) override {
+            for (auto& stmt: e->statements()) stmt->accept(this);
+        }
+    };
+
+    // Emit the kernel loop printed by `emit_loop(uniform)` in the uniform and
+    // the per-instance variants, selected once per call by the uniform pointers.
+    template <typename F>
+    void emit_uniform_field_variants(std::ostream& out, BlockExpression* body, F&& emit_loop) {
+        uniform_field_visitor v;
+        body->accept(&v);
+        if (v.fields.empty()) {
+            emit_loop(false);
+            return;
+        }
+
+        io::separator sep(" && ");
+        out << "if (";
+        for (auto f: v.fields) out << sep << uniform_field(f);
+        out << ") {\n" << indent;
+        for (auto f: v.fields) {
+            out << "const ::arb::fvm_value_type " << uniform_field_value(f) << " = *" << uniform_field(f) << ";\n";
+        }
+        emit_loop(true);
+        out << popindent << "}\n"
+            "else {\n" << indent;
+        emit_loop(false);
+        out << popindent << "}\n";
+    }
 }
 
 std::list<index_prop> gather_indexed_vars(const std::vector<LocalVariable*>& indexed_vars, const std::string& index) {
@@ -585,10 +866,13 @@ std::list<index_prop> gather_indexed_vars(const std::vector<LocalVariable*>& ind
 
 void emit_state_read(std::ostream& out, LocalVariable* local) {
     ENTER(out);
-    out << "::arb::fvm_value_type " << cprint(local) << " = ";
+    out << "::arb::fvm_value_type " << local->name() << " = ";
 
     if (local->is_read()) {
         auto d = decode_indexed_variable(local->external_variable());
+        if (is_uniform_time(local)) {
+            out << "dt_uniform_>=0? " << uniform_time_value(local) << ": ";
+        }
         if (d.scale != 1) {
             out << as_c_double(d.scale) << "*";
         }
@@ -627,31 +911,211 @@ void emit_state_update(std::ostream& out, Symbol* from, IndexedVariable* externa
     EXIT(out);
 }
 
-void emit_api_body(std::ostream& out, APIMethod* method, bool cv_loop) {
+void emit_api_body(std::ostream& out, APIMethod* method, const printer_options& opt, bool cv_loop) {
     ENTER(out);
     auto body = method->body();
     auto indexed_vars = indexed_locals(method->scope());
 
     std::list<index_prop> indices = gather_indexed_vars(indexed_vars, "i_");
     if (!body->statements().empty()) {
-        cv_loop && out <<
-            "int n_ = pp->width_;\n"
-            "for (int i_ = 0; i_ < n_; ++i_) {\n" << indent;
+        emit_uniform_time_read(out, indexed_vars);
 
-        for (auto index: indices) {
-            out << "auto " << source_index_i_name(index) << " = " << source_var(index) << "[" << index.index_name << "];\n";
-        }
+        auto emit_loop = [&](bool uniform) {
+            cv_loop && out <<
+                "int n_ = pp->width_;\n"
+                "for (int i_ = 0; i_ < n_; ++i_) {\n" << indent;
 
-        for (auto& sym: indexed_vars) {
-            emit_state_read(out, sym);
+            for (auto index: indices) {
+                out << "auto " << source_index_i_name(index) << " = " << source_var(index) << "[" << index.index_name << "];\n";
+            }
+
+            for (auto& sym: indexed_vars) {
+                emit_state_read(out, sym);
+            }
+            cprint printer(body, opt);
+            if (uniform) {
+                printer.set_uniform_fields();
+            }
+            out << printer;
+
+            for (auto& sym: indexed_vars) {
+                emit_state_update(out, sym, sym->external_variable());
+            }
+            cv_loop && out << popindent << "}\n";
+        };
+
+        // Without a CV loop, the body runs once per call.
+        if (cv_loop) {
+            emit_uniform_field_variants(out, body, emit_loop);
+        }
+        else {
+            emit_loop(false);
         }
-        out << cprint(body);
+    }
+    EXIT(out);
+}
 
-        for (auto& sym: indexed_vars) {
-            emit_state_update(out, sym, sym->external_variable());
+// Tabulated procedures:
+//
+// A procedure with a TABLE statement is emitted as a lookup that linearly
+// interpolates each tabulated variable between the n+1 grid points of the
+// table. The original body is emitted as `<proc>_table_point_`, which is
+// used to build the table and for arguments outside of its range. Tables
+// are stored one variable after another in the ppack field `<proc>_table_`,
+// and are rebuilt by `<proc>_table_update_` on entry to each interface
+// method if the values of the DEPEND globals have changed.
+//
+// A table may also depend on `celsius`, which is given per CV. The table is
+// built for the temperature of the first instance if it is the same for all
+// instances; otherwise the table is left empty and the body is evaluated
+// directly for each instance.
+
+std::vector<ProcedureExpression*> tabulated_procedures(const Module& m) {
+    std::vector<ProcedureExpression*> procs;
+    for (auto proc: normal_procedures(m)) {
+        if (proc->table()) procs.push_back(proc);
+    }
+    return procs;
+}
+
+std::string table_update_name(ProcedureExpression* e) {
+    return e->name()+"_table_update_";
+}
+
+static bool table_depends_on_celsius(ProcedureExpression* e) {
+    auto& depend = e->table()->depend();
+    return std::count(depend.begin(), depend.end(), "celsius");
+}
+
+void emit_table_point_proto(std::ostream& out, ProcedureExpression* e, const std::string& ppack_name) {
+    out << "void " << e->name() << "_table_point_(" << ppack_name << "* pp, int i_, ::arb::fvm_value_type "
+        << e->args().front()->is_argument()->name() << ")";
+}
+
+void emit_table_update_proto(std::ostream& out, ProcedureExpression* e, const std::string& ppack_name) {
+    out << "void " << table_update_name(e) << "(" << ppack_name << "* pp)";
+}
+
+void emit_table_update(std::ostream& out, ProcedureExpression* e, const std::string& ppack_name) {
+    ENTER(out);
+    auto table = e->table();
+    auto& names = table->names();
+    auto& depend = table->depend();
+    auto n = table->n();
+    auto data = "pp->"+e->name()+"_table_";
+    auto depend_data = "pp->"+e->name()+"_table_depend_";
+
+    emit_table_update_proto(out, e, ppack_name);
+    out << " {\n" << indent;
+    if (depend.empty()) {
+        out << "if (!" << data << ".empty()) return;\n";
+    }
+    else {
+        if (table_depends_on_celsius(e)) {
+            out << "if (!pp->width_) return;\n"
+                "const auto celsius_ = pp->temperature_degC_[pp->node_index_[0]];\n"
+                "for (int i_ = 1; i_ < pp->width_; ++i_) {\n" << indent <<
+                "if (pp->temperature_degC_[pp->node_index_[i_]]!=celsius_) {\n" << indent <<
+                data << ".clear();\n"
+                "return;\n" << popindent <<
+                "}\n" << popindent <<
+                "}\n";
         }
-        cv_loop && out << popindent << "}\n";
+        io::separator sep(", ");
+        out << "const ::arb::fvm_value_type depend_[] = {";
+        for (auto& d: depend) out << sep << (d=="celsius"? "celsius_": "pp->"+d);
+        out << "};\n"
+            "if (!" << data << ".empty() && std::equal(depend_, depend_+" << depend.size() << ", " << depend_data << ".begin())) return;\n"
+            << depend_data << ".assign(depend_, depend_+" << depend.size() << ");\n";
+    }
+    out << data << ".resize(" << names.size()*(n+1) << ");\n\n";
+
+    // Evaluate the body at each grid point with the tabulated variables
+    // pointing into the table.
+    for (auto& name: names) {
+        out << "auto " << name << "_saved_ = pp->" << name << ";\n";
+    }
+    out << "for (int j_ = 0; j_ <= " << n << "; ++j_) {\n" << indent;
+    for (unsigned k = 0; k<names.size(); ++k) {
+        out << "pp->" << names[k] << " = " << data << ".data()+" << k*(n+1) << "+j_;\n";
+    }
+    out << e->name() << "_table_point_(pp, 0, " << as_c_double(table->from()) << "+j_*"
+        << as_c_double((table->to()-table->from())/n) << ");\n" << popindent
+        << "}\n";
+    for (auto& name: names) {
+        out << "pp->" << name << " = " << name << "_saved_;\n";
+    }
+    out << popindent << "}\n\n";
+    EXIT(out);
+}
+
+void emit_table_lookup(std::ostream& out, ProcedureExpression* e) {
+    ENTER(out);
+    auto table = e->table();
+    auto n = table->n();
+    auto arg = e->args().front()->is_argument()->name();
+
+    out << "auto x_ = (" << arg << (table->from()<0? "+": "-") << as_c_double(std::abs(table->from())) << ")*"
+        << as_c_double(n/(table->to()-table->from())) << ";\n"
+        "if (" << (table_depends_on_celsius(e)? "!pp->"+e->name()+"_table_.empty() && ": "") <<
+        "x_ >= 0 && x_ < " << n << ") {\n" << indent <<
+        "int j_ = x_;\n"
+        "auto f_ = x_-j_;\n"
+        "auto t_ = pp->" << e->name() << "_table_.data()+j_;\n";
+    io::separator sep("", "t_ += " + std::to_string(n+1) + ";\n");
+    for (auto& name: table->names()) {
+        out << sep << "pp->" << name << "[i_] = t_[0]+f_*(t_[1]-t_[0]);\n";
     }
+    out << popindent << "}\n"
+        "else {\n" << indent <<
+        e->name() << "_table_point_(pp, i_, " << arg << ");\n" << popindent <<
+        "}\n";
+    EXIT(out);
+}
+
+void emit_simd_table_lookup(std::ostream& out, ProcedureExpression* e, bool masked) {
+    ENTER(out);
+    auto table = e->table();
+    auto n = table->n();
+    auto arg = e->args().front()->is_argument()->name();
+
+    if (table_depends_on_celsius(e)) {
+        out << "if (pp->" << e->name() << "_table_.empty()) {\n" << indent <<
+            "for (unsigned l_ = 0; l_ < simd_width_; ++l_) {\n" << indent <<
+            (masked? "if (mask_input_[l_]) ": "") <<
+            e->name() << "_table_point_(pp, i_+l_, " << arg << "[l_]);\n" << popindent <<
+            "}\n"
+            "return;\n" << popindent <<
+            "}\n";
+    }
+
+    // Interpolate in all lanes that fall within the table, with the other
+    // lanes clamped to the first interval; out-of-range lanes are then
+    // evaluated directly, one at a time.
+    out << "simd_value x_ = S::mul(S::sub(" << arg << ", simd_cast<simd_value>(" << as_c_double(table->from()) << ")), "
+        "simd_cast<simd_value>(" << as_c_double(n/(table->to()-table->from())) << "));\n"
+        "simd_mask in_range_ = S::logical_and(S::cmp_geq(x_, simd_cast<simd_value>(0.)), "
+        "S::cmp_lt(x_, simd_cast<simd_value>(" << as_c_double(n) << ")));\n";
+    if (masked) {
+        out << "simd_mask lookup_ = S::logical_and(in_range_, mask_input_);\n";
+    }
+    out << "S::where(S::logical_not(in_range_), x_) = simd_cast<simd_value>(0.);\n"
+        "simd_index j_ = simd_cast<simd_index>(x_);\n"
+        "simd_value f_ = S::sub(x_, simd_cast<simd_value>(j_));\n"
+        "auto t_ = pp->" << e->name() << "_table_.data();\n"
+        "simd_value t0_, t1_;\n";
+    io::separator sep("", "t_ += " + std::to_string(n+1) + ";\n");
+    for (auto& name: table->names()) {
+        out << sep <<
+            "assign(t0_, indirect(t_, j_, simd_width_, index_constraint::none));\n"
+            "assign(t1_, indirect(t_+1, j_, simd_width_, index_constraint::none));\n"
+            "indirect(pp->" << name << "+i_, simd_width_) = S::where("
+            << (masked? "lookup_": "in_range_") << ", S::fma(f_, S::sub(t1_, t0_), t0_));\n";
+    }
+    out << "for (unsigned l_ = 0; l_ < simd_width_; ++l_) {\n" << indent <<
+        "if (" << (masked? "mask_input_[l_] && ": "") << "!in_range_[l_]) " <<
+        e->name() << "_table_point_(pp, i_+l_, " << arg << "[l_]);\n" << popindent <<
+        "}\n";
     EXIT(out);
 }
 
@@ -671,7 +1135,13 @@ void SimdPrinter::visit(LocalVariable* sym) {
 
 void SimdPrinter::visit(VariableExpression *sym) {
     ENTERM(out_, "variable");
-    if (sym->is_range()) {
+    if (read_uniform_fields_ && is_uniform_field(sym)) {
+        out_ << "simd_cast<simd_value>(" << uniform_field_value(sym) << ")";
+    }
+    else if (sym->is_range() && is_gathered_) {
+        out_ << "simd_cast<simd_value>(indirect(pp->" << sym->name() << ", index_, simd_width_, constraint_category_))";
+    }
+    else if (sym->is_range()) {
         auto index = is_indirect_? "index_": "i_";
         out_ << "simd_cast<simd_value>(indirect(pp->" << sym->name() << "+" << index << ", simd_width_))";
     }
@@ -698,7 +1168,9 @@ void SimdPrinter::visit(AssignmentExpression* e) {
 
     if (lhs->is_variable() && lhs->is_variable()->is_range()) {
         std::string pfx = lhs->is_local_variable() ? "" : "pp->";
-        if(is_indirect_)
+        if (is_gathered_)
+            out_ << "indirect(" << pfx << lhs->name() << ", index_, simd_width_, constraint_category_) = ";
+        else if(is_indirect_)
             out_ << "indirect(" << pfx << lhs->name() << "+index_, simd_width_) = ";
         else
             out_ << "indirect(" << pfx << lhs->name() << "+i_, simd_width_) = ";
@@ -719,6 +1191,10 @@ void SimdPrinter::visit(AssignmentExpression* e) {
             if (auto sym = rhs->symbol()) {
                 // We shouldn't call the rhs visitor in this case because it automatically casts indirect expressions
                 if (sym->is_variable() && sym->is_variable()->is_range()) {
+                    if (is_gathered_) {
+                        out_ << "indirect(pp->" << rhs->name() << ", index_, simd_width_, constraint_category_))";
+                        return;
+                    }
                     auto index = is_indirect_ ? "index_" : "i_";
                     out_ << "indirect(pp->" << rhs->name() << "+" << index << ", simd_width_))";
                     return;
@@ -803,25 +1279,34 @@ void emit_simd_state_read(std::ostream& out, LocalVariable* local, simd_expr_con
                 << "[0]);\n";
         }
         else {
+            // Statement terminating the declaration, if not yet terminated.
+            std::string decl_end = ";\n";
+            if (is_uniform_time(local)) {
+                out << ";\n"
+                    << "if (dt_uniform_>=0) " << local->name() << " = simd_cast<simd_value>(" << uniform_time_value(local) << ");\n"
+                    << "else ";
+                decl_end = "";
+            }
+
             if (d.cell_index_var.empty()) {
                 switch (constraint) {
                     case simd_expr_constraint::contiguous:
-                        out << ";\n"
+                        out << decl_end
                             << "assign(" << local->name() << ", indirect(" << data_via_ppack(d)
                             << " + " << node_index_i_name(d) << ", simd_width_));\n";
                         break;
                     case simd_expr_constraint::constant:
-                        out << " = simd_cast<simd_value>(" << data_via_ppack(d)
+                        out << (decl_end.empty()? local->name(): "") << " = simd_cast<simd_value>(" << data_via_ppack(d)
                             << "[" << node_index_i_name(d)  << "]);\n";
                         break;
                     default:
-                        out << ";\n"
+                        out << decl_end
                             << "assign(" << local->name() << ", indirect(" << data_via_ppack(d)
                             << ", " << node_index_i_name(d) << ", simd_width_, constraint_category_));\n";
                 }
             }
             else {
-                out << ";\n"
+                out << decl_end
                     << "assign(" << local->name() << ", indirect(" << data_via_ppack(d)
                     << ", " << index_i_name(d.cell_index_var) << ", simd_width_, index_constraint::none));\n";
             }
@@ -965,7 +1450,9 @@ void emit_simd_body_for_loop(
         const std::vector<LocalVariable*>& indexed_vars,
         const std::vector<VariableExpression*>& scalars,
         const std::list<index_prop>& indices,
-        const simd_expr_constraint& constraint) {
+        const simd_expr_constraint& constraint,
+        const printer_options& opt,
+        bool uniform) {
     ENTER(out);
     emit_simd_index_initialize(out, indices, constraint);
 
@@ -973,8 +1460,11 @@ void emit_simd_body_for_loop(
         emit_simd_state_read(out, sym, constraint);
     }
 
-    simdprint printer(body, scalars);
+    simdprint printer(body, scalars, opt);
     printer.set_indirect_index();
+    if (uniform) {
+        printer.set_uniform_fields();
+    }
 
     out << printer;
 
@@ -990,7 +1480,9 @@ void emit_simd_for_loop_per_constraint(std::ostream& out, BlockExpression* body,
                                   bool requires_weight,
                                   const std::list<index_prop>& indices,
                                   const simd_expr_constraint& constraint,
-                                  std::string underlying_constraint_name) {
+                                  std::string underlying_constraint_name,
+                                  const printer_options& opt,
+                                  bool uniform) {
     ENTER(out);
     out << "constraint_category_ = index_constraint::"<< underlying_constraint_name << ";\n";
     out << "for (unsigned i_ = 0; i_ < pp->index_constraints_." << underlying_constraint_name
@@ -1003,13 +1495,13 @@ void emit_simd_for_loop_per_constraint(std::ostream& out, BlockExpression* body,
             << "assign(w_, indirect((pp->weight_+index_), simd_width_));\n";
     }
 
-    emit_simd_body_for_loop(out, body, indexed_vars, scalars, indices, constraint);
+    emit_simd_body_for_loop(out, body, indexed_vars, scalars, indices, constraint, opt, uniform);
 
     out << popindent << "}\n";
     EXIT(out);
 }
 
-void emit_simd_api_body(std::ostream& out, APIMethod* method, const std::vector<VariableExpression*>& scalars) {
+void emit_simd_api_body(std::ostream& out, APIMethod* method, const std::vector<VariableExpression*>& scalars, const printer_options& opt) {
     auto body = method->body();
     auto indexed_vars = indexed_locals(method->scope());
     bool requires_weight = false;
@@ -1038,6 +1530,8 @@ void emit_simd_api_body(std::ostream& out, APIMethod* method, const std::vector<
     }
     if (!body->statements().empty()) {
         out << "assert(simd_width_ <= (unsigned)S::width(simd_cast<simd_value>(0)));\n";
+        emit_uniform_time_read(out, indexed_vars);
+        emit_uniform_field_variants(out, body, [&](bool uniform) {
         if (!indices.empty()) {
             out << "index_constraint constraint_category_;\n\n";
 
@@ -1045,25 +1539,25 @@ void emit_simd_api_body(std::ostream& out, APIMethod* method, const std::vector<
             simd_expr_constraint constraint = simd_expr_constraint::contiguous;
             std::string underlying_constraint = "contiguous";
 
-            emit_simd_for_loop_per_constraint(out, body, indexed_vars, scalars, requires_weight, indices, constraint, underlying_constraint);
+            emit_simd_for_loop_per_constraint(out, body, indexed_vars, scalars, requires_weight, indices, constraint, underlying_constraint, opt, uniform);
 
             //Generate for loop for all independent simd_vectors
             constraint = simd_expr_constraint::other;
             underlying_constraint = "independent";
 
-            emit_simd_for_loop_per_constraint(out, body, indexed_vars, scalars, requires_weight, indices, constraint, underlying_constraint);
+            emit_simd_for_loop_per_constraint(out, body, indexed_vars, scalars, requires_weight, indices, constraint, underlying_constraint, opt, uniform);
 
             //Generate for loop for all simd_vectors that have no optimizing constraints
             constraint = simd_expr_constraint::other;
             underlying_constraint = "none";
 
-            emit_simd_for_loop_per_constraint(out, body, indexed_vars, scalars, requires_weight, indices, constraint, underlying_constraint);
+            emit_simd_for_loop_per_constraint(out, body, indexed_vars, scalars, requires_weight, indices, constraint, underlying_constraint, opt, uniform);
 
             //Generate for loop for all constant simd_vectors
             constraint = simd_expr_constraint::constant;
             underlying_constraint = "constant";
 
-            emit_simd_for_loop_per_constraint(out, body, indexed_vars, scalars, requires_weight, indices, constraint, underlying_constraint);
+            emit_simd_for_loop_per_constraint(out, body, indexed_vars, scalars, requires_weight, indices, constraint, underlying_constraint, opt, uniform);
 
         }
         else {
@@ -1072,12 +1566,94 @@ void emit_simd_api_body(std::ostream& out, APIMethod* method, const std::vector<
                 emit_simd_state_read(out, sym, simd_expr_constraint::other);
             }
 
+            simdprint printer(body, scalars, opt);
+            if (uniform) {
+                printer.set_uniform_fields();
+            }
             out <<
                 "unsigned n_ = pp->width_;\n\n"
                 "for (unsigned i_ = 0; i_ < n_; i_ += simd_width_) {\n" << indent <<
-                simdprint(body, scalars) << popindent <<
+                printer << popindent <<
                 "}\n";
         }
+        });
     }
     EXIT(out);
 }
+
+// Vectorised event delivery:
+//
+// Events on each stream are delivered simd_width_ at a time, with mechanism
+// state read and written by gather and scatter on the instance indices of
+// the events. Several events may target the same instance, in which case
+// the indices of the events conflict and the events are delivered in order
+// by the scalar net_receive kernel instead, as are the remaining events that
+// do not fill a vector.
+//
+// Only NET_RECEIVE blocks that neither access indexed state nor contain
+// procedure calls or conditionals are vectorised.
+
+namespace {
+    class simd_net_receive_visitor: public Visitor {
+    public:
+        bool ok = true;
+
+        void visit(Expression*) override {}
+        void visit(CallExpression*) override { ok = false; }
+        void visit(IfExpression*) override { ok = false; }
+        void visit(UnaryExpression* e) override { e->expression()->accept(this); }
+        void visit(BinaryExpression* e) override {
+            e->lhs()->accept(this);
+            e->rhs()->accept(this);
+        }
+        void visit(BlockExpression* e) override {
+            for (auto& stmt: e->statements()) stmt->accept(this);
+        }
+    };
+}
+
+bool is_simd_net_receive(APIMethod* method) {
+    if (!indexed_locals(method->scope()).empty()) return false;
+
+    simd_net_receive_visitor v;
+    method->body()->accept(&v);
+    return v.ok;
+}
+
+void emit_simd_apply_events(std::ostream& out, APIMethod* method, const std::string& kernel_name, const std::vector<VariableExpression*>& scalars, const printer_options& opt) {
+    ENTER(out);
+    const std::string weight_arg = method->args().empty() ? "weight" : method->args().front()->is_argument()->name();
+
+    simdprint printer(method->body(), scalars, opt);
+    printer.set_gathered_index();
+
+    out <<
+        "auto ncell = events.n_streams();\n"
+        "for (::arb::fvm_size_type c = 0; c<ncell; ++c) {\n" << indent <<
+        "auto p = events.begin_marked(c);\n"
+        "auto end = events.end_marked(c);\n"
+        "for (; end-p>=(std::ptrdiff_t)simd_width_; p += simd_width_) {\n" << indent <<
+        "::arb::fvm_index_type ev_index_[simd_width_];\n"
+        "::arb::fvm_value_type ev_weight_[simd_width_];\n"
+        "for (unsigned j_ = 0; j_<simd_width_; ++j_) {\n" << indent <<
+        "ev_index_[j_] = p[j_].mech_index;\n"
+        "ev_weight_[j_] = p[j_].weight;\n" << popindent <<
+        "}\n\n"
+        "index_constraint constraint_category_ = ::arb::multicore::event_index_constraint(ev_index_, simd_width_);\n"
+        "if (constraint_category_==index_constraint::none) {\n" << indent <<
+        "for (unsigned j_ = 0; j_<simd_width_; ++j_) {\n" << indent <<
+        kernel_name << "::net_receive(pp, ev_index_[j_], ev_weight_[j_]);\n" << popindent <<
+        "}\n"
+        "continue;\n" << popindent <<
+        "}\n\n"
+        "auto index_ = simd_cast<simd_index>(indirect(ev_index_, simd_width_));\n"
+        "simd_value " << weight_arg << ";\n"
+        "assign(" << weight_arg << ", indirect(ev_weight_, simd_width_));\n"
+        << printer << popindent <<
+        "}\n"
+        "for (; p<end; ++p) {\n" << indent <<
+        kernel_name << "::net_receive(pp, p->mech_index, p->weight);\n" << popindent <<
+        "}\n" << popindent <<
+        "}\n";
+    EXIT(out);
+}
@@ -20,21 +20,40 @@ public:
     void visit(Expression* e) override {
         throw compiler_exception("CPrinter cannot translate expression "+e->to_string());
     }
+    // Read STATE variables stored in single precision.
+    void set_single_precision_state(bool single_precision) {
+        single_precision_state_ = single_precision;
+    }
+    // Call fast approximations of exp, log, exprelr and pow at this accuracy
+    // level; zero for the exact functions.
+    void set_fast_math_level(unsigned level) {
+        fast_math_level_ = level;
+    }
+    // Read uniform RANGE parameters from the scalars <name>_uniform_value_.
+    void set_uniform_fields(bool uniform) {
+        read_uniform_fields_ = uniform;
+    }
 
     void visit(BlockExpression*) override;
     void visit(CallExpression*) override;
     void visit(IdentifierExpression*) override;
     void visit(VariableExpression*) override;
     void visit(LocalVariable*) override;
+    void visit(IndexedVariable*) override;
+    void visit(AssignmentExpression*) override;
 
     // Delegate low-level emits to cexpr_emit:
-    void visit(NumberExpression* e) override { cexpr_emit(e, out_, this); }
-    void visit(UnaryExpression* e) override { cexpr_emit(e, out_, this); }
-    void visit(BinaryExpression* e) override { cexpr_emit(e, out_, this); }
-    void visit(IfExpression* e) override { cexpr_emit(e, out_, this); }
+    void visit(NumberExpression* e) override { cexpr_emit(e, out_, this, fast_math_level_); }
+    void visit(UnaryExpression* e) override { cexpr_emit(e, out_, this, fast_math_level_); }
+    void visit(BinaryExpression* e) override { cexpr_emit(e, out_, this, fast_math_level_); }
+    void visit(IfExpression* e) override { cexpr_emit(e, out_, this, fast_math_level_); }
 
 protected:
     std::ostream& out_;
+    bool is_lhs_ = false;   // Printing the target of an assignment?
+    bool single_precision_state_ = false;
+    bool read_uniform_fields_ = false;
+    unsigned fast_math_level_ = 0;
 };
 
 
@@ -54,12 +73,23 @@ public:
     void set_var_indexed(bool is_indirect_index) {
         is_indirect_ = is_indirect_index;
     }
+    // Access range variables by gather and scatter through the simd_index
+    // `index_`, with constraint `constraint_category_`.
+    void set_var_gathered(bool is_gathered) {
+        is_gathered_ = is_gathered;
+    }
     void set_input_mask(std::string input_mask) {
         input_mask_ = input_mask;
     }
     void save_scalar_names(const std::unordered_set<std::string>& scalars) {
         scalars_ = scalars;
     }
+    void set_fast_math_level(unsigned level) {
+        fast_math_level_ = level;
+    }
+    void set_uniform_fields(bool uniform) {
+        read_uniform_fields_ = uniform;
+    }
 
     void visit(BlockExpression*) override;
     void visit(CallExpression*) override;
@@ -68,14 +98,17 @@ public:
     void visit(LocalVariable*) override;
     void visit(AssignmentExpression*) override;
 
-    void visit(NumberExpression* e) override { simd_expr_emit(e, out_, is_indirect_, input_mask_, scalars_, this); } 
-    void visit(UnaryExpression* e)  override { simd_expr_emit(e, out_, is_indirect_, input_mask_, scalars_, this); }
-    void visit(BinaryExpression* e) override { simd_expr_emit(e, out_, is_indirect_, input_mask_, scalars_, this); }
-    void visit(IfExpression* e)     override { simd_expr_emit(e, out_, is_indirect_, input_mask_, scalars_, this); }
+    void visit(NumberExpression* e) override { simd_expr_emit(e, out_, is_indirect_, input_mask_, scalars_, this, fast_math_level_); } 
+    void visit(UnaryExpression* e)  override { simd_expr_emit(e, out_, is_indirect_, input_mask_, scalars_, this, fast_math_level_); }
+    void visit(BinaryExpression* e) override { simd_expr_emit(e, out_, is_indirect_, input_mask_, scalars_, this, fast_math_level_); }
+    void visit(IfExpression* e)     override { simd_expr_emit(e, out_, is_indirect_, input_mask_, scalars_, this, fast_math_level_); }
 
 private:
     std::ostream& out_;
     std::string input_mask_;
     bool is_indirect_ = false;
+    bool is_gathered_ = false;
+    bool read_uniform_fields_ = false;
     std::unordered_set<std::string> scalars_;
+    unsigned fast_math_level_ = 0;
 };
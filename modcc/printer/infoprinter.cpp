@@ -133,7 +133,9 @@ std::string build_info_header(const Module& m, const printer_options& opt) {
                                  "// linear, homogeneous mechanism\n"
         << m.is_linear() << ",\n"
                              "// post_events enabled mechanism\n"
-        << m.has_post_events() << "\n"
+        << m.has_post_events() << ",\n"
+                                  "// NET_RECEIVE linear in event weight\n"
+        << m.has_linear_net_receive() << "\n"
         << popindent << "};\n"
                         "\n"
                         "return info;\n"
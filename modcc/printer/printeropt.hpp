@@ -19,4 +19,14 @@ struct printer_options {
 
     bool profile = false;
     bool trace_codegen = false;
+
+    // Store STATE variables in single precision? Arithmetic remains in
+    // fvm_value_type. Currently only supported for the C printer without
+    // explicit vectorization.
+    bool single_precision_state = false;
+
+    // Accuracy level of fast approximations to exp, log, exprelr and pow
+    // (see arbor/fast_math.hpp): 0 uses the exact functions. Currently only
+    // supported for the C printer.
+    unsigned fast_math_level = 0;
 };
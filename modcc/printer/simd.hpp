@@ -43,6 +43,10 @@ struct simd_spec {
         case sve:
             size = 0;
             break;
+        case default_abi:
+            // The generic implementation supports any width.
+            if (width!=no_size) size = width;
+            break;
         default: ;
         }
 
@@ -39,10 +39,21 @@ public:
         api_context_ = flag;
     }
 
+    // The body of a procedure with a TABLE statement, which can read the
+    // temperature directly.
+    bool in_table_context() const {
+        return table_context_;
+    }
+
+    void in_table_context(bool flag) {
+        table_context_ = flag;
+    }
+
 private:
     symbol_map* global_symbols_=nullptr;
     symbol_map  local_symbols_;
     bool api_context_ = false;
+    bool table_context_ = false;
 };
 
 template<typename Symbol>
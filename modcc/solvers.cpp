@@ -788,29 +788,85 @@ void SparseNonlinearSolverVisitor::finalize() {
     // Update the state variables
     auto U_ = system_.generate_solution_assignments(dvar_temp_);
 
+    // With a tolerance, the Newton updates are kept in locals dx_, from
+    // which the size of the update relative to the state is measured.
+    bool test_convergence = newton_tolerance_>0 && newton_iterations_>1;
+    std::vector<expression_ptr> dx_;
+    if (test_convergence) {
+        for (auto& u: U_) {
+            auto dx = make_unique_local_decl(block_scope_, u->location(), "dx_");
+            statements_.push_back(std::move(dx.local_decl));
+            dx_.push_back(std::move(dx.id));
+        }
+    }
+
     // Create the statements that update the temporary state variables
     // (dvar_temp) after a Newton's iteration and save them in U_
-    for (auto& u: U_) {
+    std::vector<expression_ptr> dU_;
+    expression_ptr err;
+    for (unsigned i = 0; i<U_.size(); ++i) {
+        auto& u = U_[i];
+        auto loc = u->location();
         auto lhs = u->is_assignment()->lhs();
         auto rhs = u->is_assignment()->rhs();
-        u = make_expression<AssignmentExpression>(u->location(), lhs->clone(),
-                make_expression<SubBinaryExpression>(u->location(), lhs->clone(), rhs->clone()));
+        if (test_convergence) {
+            dU_.push_back(make_expression<AssignmentExpression>(loc, dx_[i]->clone(), rhs->clone()));
+            rhs = dx_[i].get();
+
+            // |dx|/max(1, |x|) with the updated state x.
+            auto rel = make_expression<DivBinaryExpression>(loc,
+                make_expression<AbsUnaryExpression>(loc, dx_[i]->clone()),
+                make_expression<MaxBinaryExpression>(loc,
+                    make_expression<NumberExpression>(loc, 1.0),
+                    make_expression<AbsUnaryExpression>(loc, lhs->clone())));
+            err = err? make_expression<MaxBinaryExpression>(loc, std::move(err), std::move(rel)): std::move(rel);
+        }
+        u = make_expression<AssignmentExpression>(loc, lhs->clone(),
+                make_expression<SubBinaryExpression>(loc, lhs->clone(), rhs->clone()));
+    }
+
+    expression_ptr err_id, err_assign;
+    if (test_convergence) {
+        auto err_term = make_unique_local_assign(block_scope_, err.get(), "err_");
+        statements_.push_back(std::move(err_term.local_decl));
+        err_assign = std::move(err_term.assignment);
+        err_id = std::move(err_term.id);
     }
 
-    // Do 3 Newton iterations
-    for (unsigned n = 0; n < 3; n++) {
+    // Do at most newton_iterations_ Newton iterations; with a tolerance, each
+    // iteration after the first runs only if the previous update exceeded it.
+    for (unsigned n = 0; n < newton_iterations_; n++) {
         // Print out the statements that calulate F(xn), J(xn), solve J(xn)^-1*F(xn), update xn -> xn+1
+        expr_list_type iteration;
         for (auto &s: F_) {
-            statements_.push_back(s->clone());
+            iteration.push_back(s->clone());
         }
         for (auto &s: J_) {
-            statements_.push_back(s->clone());
+            iteration.push_back(s->clone());
         }
         for (auto &s: S_) {
-            statements_.push_back(s->clone());
+            iteration.push_back(s->clone());
+        }
+        for (auto &s: dU_) {
+            iteration.push_back(s->clone());
         }
         for (auto &s: U_) {
-            statements_.push_back(s->clone());
+            iteration.push_back(s->clone());
+        }
+        if (err_assign && n+1<newton_iterations_) {
+            iteration.push_back(err_assign->clone());
+        }
+
+        if (n==0 || !test_convergence) {
+            std::move(iteration.begin(), iteration.end(), std::back_inserter(statements_));
+        }
+        else {
+            auto loc = err_id->location();
+            statements_.push_back(make_expression<IfExpression>(loc,
+                make_expression<ConditionalExpression>(loc, tok::gt, err_id->clone(),
+                    make_expression<NumberExpression>(loc, newton_tolerance_)),
+                make_expression<BlockExpression>(loc, std::move(iteration), true),
+                nullptr));
         }
     }
 
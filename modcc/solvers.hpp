@@ -209,10 +209,17 @@ protected:
     // System Solver helper
     SystemSolver system_;
 
+    // Maximum number of Newton iterations, and the tolerance on the relative
+    // update below which further iterations are skipped (none if zero).
+    unsigned newton_iterations_ = 3;
+    double newton_tolerance_ = 0;
+
 public:
     using SolverVisitorBase::visit;
 
     SparseNonlinearSolverVisitor() {}
+    SparseNonlinearSolverVisitor(unsigned newton_iterations, double newton_tolerance):
+        newton_iterations_(newton_iterations), newton_tolerance_(newton_tolerance) {}
     SparseNonlinearSolverVisitor(scope_ptr enclosing): SolverVisitorBase(enclosing) {}
 
     virtual void visit(BlockExpression* e) override;
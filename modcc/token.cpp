@@ -57,12 +57,16 @@ static Keyword keywords[] = {
     {"STEADYSTATE", tok::steadystate},
     {"FROM",        tok::from},
     {"TO",          tok::to},
+    {"TABLE",       tok::table},
+    {"DEPEND",      tok::depend},
+    {"WITH",        tok::with},
     {"if",          tok::if_stmt},
     {"IF",          tok::if_stmt},
     {"else",        tok::else_stmt},
     {"ELSE",        tok::else_stmt},
     {"cnexp",       tok::cnexp},
     {"sparse",      tok::sparse},
+    {"derivimplicit", tok::derivimplicit},
     {"min",         tok::min},
     {"max",         tok::max},
     {"exp",         tok::exp},
@@ -136,6 +140,9 @@ static TokenString token_strings[] = {
     {"COMPARTMENT", tok::compartment},
     {"METHOD",      tok::method},
     {"STEADYSTATE", tok::steadystate},
+    {"TABLE",       tok::table},
+    {"DEPEND",      tok::depend},
+    {"WITH",        tok::with},
     {"if",          tok::if_stmt},
     {"else",        tok::else_stmt},
     {"eof",         tok::eof},
@@ -149,6 +156,7 @@ static TokenString token_strings[] = {
     {"cos",         tok::cos},
     {"sin",         tok::sin},
     {"cnexp",       tok::cnexp},
+    {"derivimplicit", tok::derivimplicit},
     {"CONDUCTANCE", tok::conductance},
     {"error",       tok::reserved},
 };
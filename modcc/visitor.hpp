@@ -39,6 +39,7 @@ public:
     virtual void visit(NetReceiveExpression *e) { visit((ProcedureExpression*) e); }
     virtual void visit(APIMethod *e)            { visit((Expression*) e); }
     virtual void visit(ConductanceExpression *e) { visit((Expression*) e); }
+    virtual void visit(TableExpression *e)      { visit((Expression*) e); }
     virtual void visit(BlockExpression *e)      { visit((Expression*) e); }
     virtual void visit(InitialBlock *e)         { visit((BlockExpression*) e); }
 
@@ -96,6 +96,8 @@ void register_mechanisms(pybind11::module& m) {
             "Ion dependencies.")
         .def_readonly("linear", &arb::mechanism_info::linear,
             "True if a synapse mechanism has linear current contributions so that multiple instances on the same compartment can be coalesced.")
+        .def_readonly("linear_net_receive", &arb::mechanism_info::linear_net_receive,
+            "True if a synapse mechanism responds linearly to event weights, so that simultaneous events on the same target can be aggregated.")
         .def("__repr__",
                 [](const arb::mechanism_info& inf) {
                     return util::pprintf("(arbor.mechanism_info)"); })
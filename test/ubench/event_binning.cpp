@@ -3,6 +3,7 @@
 //
 // Keep this test as a prototype for testing, esp. when looking into binning.
 
+#include <algorithm>
 #include <random>
 #include <unordered_map>
 #include <vector>
@@ -11,7 +12,9 @@
 
 #include <arbor/spike_event.hpp>
 
+#include "event_binner.hpp"
 #include "event_queue.hpp"
+#include "merge_events.hpp"
 #include "backends/event.hpp"
 
 
@@ -99,9 +102,54 @@ void yes_hash(benchmark::State& state) {
     }
 }
 
+// Per-cell event lanes are formed by merging the old, pending and generated
+// events (three sorted lanes) and are then binned with the `following` policy,
+// as in the staging of events in mc_cell_group.
+void merge_and_bin(benchmark::State& state) {
+    const std::size_t ncells = state.range(0);
+    const std::size_t ev_per_cell = state.range(1);
+    const std::size_t nlanes = 3;
+
+    std::mt19937 gen;
+    std::uniform_real_distribution<float> time_dist(0.f, 1.f);
+
+    std::vector<std::vector<pse_vector>> inputs(ncells, std::vector<pse_vector>(nlanes));
+    for (auto& cell: inputs) {
+        for (std::size_t i=0; i<ev_per_cell; ++i) {
+            cell[i%nlanes].push_back({0, time_dist(gen), 1.f});
+        }
+        for (auto& lane: cell) {
+            std::sort(lane.begin(), lane.end());
+        }
+    }
+
+    std::vector<event_binner> binners(ncells, event_binner(binning_kind::following, 0.01));
+    std::vector<event_span> spans;
+    pse_vector merged;
+    merged.reserve(ev_per_cell);
+    std::vector<time_type> binned(ev_per_cell);
+    while (state.KeepRunning()) {
+        for (size_t i=0; i<ncells; ++i) {
+            spans.clear();
+            for (auto& lane: inputs[i]) {
+                spans.emplace_back(lane.data(), lane.data()+lane.size());
+            }
+            merged.clear();
+            tree_merge_events(spans, merged);
+
+            binners[i].reset();
+            for (size_t j=0; j<merged.size(); ++j) {
+                binned[j] = binners[i].bin(merged[j].time);
+            }
+        }
+
+        benchmark::ClobberMemory();
+    }
+}
+
 void run_custom_arguments(benchmark::internal::Benchmark* b) {
     for (auto ncells: {1, 10, 100, 1000, 10000}) {
-        for (auto ev_per_cell: {128, 256, 512, 1024, 2048, 4096}) {
+        for (auto ev_per_cell: {8, 32, 128, 256, 512, 1024, 2048, 4096}) {
             b->Args({ncells, ev_per_cell});
         }
     }
@@ -109,5 +157,6 @@ void run_custom_arguments(benchmark::internal::Benchmark* b) {
 
 BENCHMARK(no_hash)->Apply(run_custom_arguments);
 BENCHMARK(yes_hash)->Apply(run_custom_arguments);
+BENCHMARK(merge_and_bin)->Apply(run_custom_arguments);
 
 BENCHMARK_MAIN();
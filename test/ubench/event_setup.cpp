@@ -13,11 +13,11 @@
 #include <algorithm>
 #include <random>
 #include <vector>
-#include <algorithm>
 
 #include <benchmark/benchmark.h>
 
 #include "event_queue.hpp"
+#include "merge_events.hpp"
 #include "backends/event.hpp"
 
 using namespace arb;
@@ -190,17 +190,119 @@ void n_vector(benchmark::State& state) {
     }
 }
 
+// Generate nlanes sorted event lanes, as seen by merge_cell_events for
+// a single cell: events are drawn uniformly in [0, 1) over a small set of
+// targets.
+std::vector<pse_vector> generate_lanes(size_t nlanes, size_t ev_per_lane) {
+    std::mt19937 gen;
+    std::uniform_int_distribution<cell_lid_type> target_dist(0u, 15u);
+    std::uniform_real_distribution<float> time_dist(0.f, 1.f);
+
+    std::vector<pse_vector> lanes(nlanes);
+    for (auto& lane: lanes) {
+        lane.reserve(ev_per_lane);
+        for (std::size_t i=0; i<ev_per_lane; ++i) {
+            lane.push_back({target_dist(gen), time_dist(gen), 1.f});
+        }
+        std::sort(lane.begin(), lane.end());
+    }
+    return lanes;
+}
+
+// Merge sorted lanes with tree_merge_events, which dispatches to the
+// two- and three-way merges or the tournament tree depending on lane count.
+void tree_merge(benchmark::State& state) {
+    const std::size_t nlanes = state.range(0);
+    const std::size_t ev_per_lane = state.range(1);
+
+    auto lanes = generate_lanes(nlanes, ev_per_lane);
+
+    std::vector<event_span> spans;
+    pse_vector merged;
+    merged.reserve(nlanes*ev_per_lane);
+    while (state.KeepRunning()) {
+        spans.clear();
+        for (auto& lane: lanes) {
+            spans.emplace_back(lane.data(), lane.data()+lane.size());
+        }
+        merged.clear();
+        tree_merge_events(spans, merged);
+
+        benchmark::ClobberMemory();
+    }
+}
+
+// Reference: the tournament tree without the special cases for few lanes.
+void tourney_merge(benchmark::State& state) {
+    const std::size_t nlanes = state.range(0);
+    const std::size_t ev_per_lane = state.range(1);
+
+    auto lanes = generate_lanes(nlanes, ev_per_lane);
+
+    std::vector<event_span> spans;
+    pse_vector merged;
+    merged.reserve(nlanes*ev_per_lane);
+    while (state.KeepRunning()) {
+        spans.clear();
+        for (auto& lane: lanes) {
+            spans.emplace_back(lane.data(), lane.data()+lane.size());
+        }
+        merged.clear();
+        impl::tourney_tree tree(spans);
+        while (!tree.empty()) {
+            merged.push_back(tree.head());
+            tree.pop();
+        }
+
+        benchmark::ClobberMemory();
+    }
+}
+
+// Reference: concatenate the lanes and sort.
+void sort_merge(benchmark::State& state) {
+    const std::size_t nlanes = state.range(0);
+    const std::size_t ev_per_lane = state.range(1);
+
+    auto lanes = generate_lanes(nlanes, ev_per_lane);
+
+    pse_vector merged;
+    merged.reserve(nlanes*ev_per_lane);
+    while (state.KeepRunning()) {
+        merged.clear();
+        for (auto& lane: lanes) {
+            merged.insert(merged.end(), lane.begin(), lane.end());
+        }
+        std::sort(merged.begin(), merged.end());
+
+        benchmark::ClobberMemory();
+    }
+}
+
 void run_custom_arguments(benchmark::internal::Benchmark* b) {
     for (auto ncells: {1, 10, 100, 1000, 10000}) {
-        for (auto ev_per_cell: {128, 256, 512, 1024, 2048, 4096}) {
+        for (auto ev_per_cell: {8, 32, 128, 256, 512, 1024, 2048, 4096}) {
             b->Args({ncells, ev_per_cell});
         }
     }
 }
 
+// Lane counts and sizes typical of merge_cell_events: the old and pending
+// events plus one or more generators, with tens to hundreds of events per
+// lane for each epoch.
+void run_merge_arguments(benchmark::internal::Benchmark* b) {
+    for (auto nlanes: {2, 3, 4, 8, 16, 64}) {
+        for (auto ev_per_lane: {8, 32, 128, 512}) {
+            b->Args({nlanes, ev_per_lane});
+        }
+    }
+}
+
 //BENCHMARK(run_original)->Apply(run_custom_arguments);
 BENCHMARK(single_queue)->Apply(run_custom_arguments);
 BENCHMARK(n_queue)->Apply(run_custom_arguments);
 BENCHMARK(n_vector)->Apply(run_custom_arguments);
+BENCHMARK(tree_merge)->Apply(run_merge_arguments);
+BENCHMARK(tourney_merge)->Apply(run_merge_arguments);
+BENCHMARK(sort_merge)->Apply(run_merge_arguments);
 
 BENCHMARK_MAIN();
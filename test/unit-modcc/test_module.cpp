@@ -1,6 +1,9 @@
 #include "common.hpp"
 #include "io/bulkio.hpp"
 #include "module.hpp"
+#include <algorithm>
+#include <map>
+#include <string>
 #include <unordered_map>
 
 TEST(Module, open) {
@@ -103,6 +106,24 @@ TEST(Module, linear_mechanisms) {
     }
 }
 
+TEST(Module, linear_net_receive) {
+    // test1, test3 and test5 increment a state by the weight; test2 has no
+    // NET_RECEIVE block; test4 scales a state by the weight.
+    for (int i = 1; i < 6; i++) {
+        auto file_name = "test" + std::to_string(i) + ".mod";
+
+        Module m(io::read_all(DATADIR "/mod_files/" + file_name), file_name);
+        ASSERT_NE(m.buffer().size(), 0);
+
+        Parser p(m, false);
+        ASSERT_TRUE(p.parse());
+
+        m.semantic();
+
+        EXPECT_EQ(i==1 || i==3 || i==5, m.has_linear_net_receive()) << file_name;
+    }
+}
+
 TEST(Module, breakpoint) {
     // Test function call in BREAKPOINT block
     Module m(io::read_all(DATADIR "/mod_files/test8.mod"), "test8.mod");
@@ -113,3 +134,222 @@ TEST(Module, breakpoint) {
 
     EXPECT_TRUE(m.semantic());
 }
+
+TEST(Module, table) {
+    auto make_module = [](const std::string& rates) {
+        return
+            "NEURON { SUFFIX tab GLOBAL k RANGE g }\n"
+            "PARAMETER { k = 1 g = 1 celsius }\n"
+            "ASSIGNED { v a b c }\n"
+            "INITIAL {\n"
+            "    rates(v)\n"
+            "}\n"
+            "BREAKPOINT {\n"
+            "    rates(v)\n"
+            "}\n"
+            + rates;
+    };
+
+    auto check = [&](const std::string& rates) {
+        Module m(make_module(rates), "tab.mod");
+        Parser p(m, false);
+        EXPECT_TRUE(p.parse());
+        return m.semantic();
+    };
+
+    EXPECT_TRUE(check(
+        "PROCEDURE rates(u) {\n"
+        "    LOCAL x\n"
+        "    TABLE a, b DEPEND k FROM -100 TO 100 WITH 200\n"
+        "    x = exp(u/k)\n"
+        "    a = x\n"
+        "    b = 2*a\n"
+        "}\n"));
+
+    // The temperature may be read if it is a DEPEND variable.
+    EXPECT_TRUE(check(
+        "PROCEDURE rates(u) {\n"
+        "    TABLE a DEPEND k, celsius FROM -100 TO 100 WITH 200\n"
+        "    a = k*u*celsius\n"
+        "}\n"));
+    EXPECT_FALSE(check(
+        "PROCEDURE rates(u) {\n"
+        "    TABLE a DEPEND k FROM -100 TO 100 WITH 200\n"
+        "    a = k*u*celsius\n"
+        "}\n"));
+
+    // Tabulated variables must be assigned range variables.
+    EXPECT_FALSE(check(
+        "PROCEDURE rates(u) {\n"
+        "    TABLE a, b FROM -100 TO 100 WITH 200\n"
+        "    a = u\n"
+        "}\n"));
+    EXPECT_FALSE(check(
+        "PROCEDURE rates(u) {\n"
+        "    TABLE a, k FROM -100 TO 100 WITH 200\n"
+        "    a = u\n"
+        "}\n"));
+
+    // DEPEND variables must be globals.
+    EXPECT_FALSE(check(
+        "PROCEDURE rates(u) {\n"
+        "    TABLE a DEPEND g FROM -100 TO 100 WITH 200\n"
+        "    a = u*g\n"
+        "}\n"));
+
+    // The body may read only its argument, locals, globals and tabulated
+    // variables, and assign only locals and tabulated variables.
+    EXPECT_FALSE(check(
+        "PROCEDURE rates(u) {\n"
+        "    TABLE a FROM -100 TO 100 WITH 200\n"
+        "    a = u*c\n"
+        "}\n"));
+    EXPECT_FALSE(check(
+        "PROCEDURE rates(u) {\n"
+        "    TABLE a FROM -100 TO 100 WITH 200\n"
+        "    a = u\n"
+        "    c = u\n"
+        "}\n"));
+
+    // Tabulated procedures have a single argument and make no calls.
+    EXPECT_FALSE(check(
+        "PROCEDURE rates(u) {\n"
+        "    a = u\n"
+        "}\n"
+        "PROCEDURE rates2(u, w) {\n"
+        "    TABLE b FROM -100 TO 100 WITH 200\n"
+        "    b = u*w\n"
+        "}\n"));
+    EXPECT_FALSE(check(
+        "PROCEDURE rates(u) {\n"
+        "    TABLE a FROM -100 TO 100 WITH 200\n"
+        "    a = u\n"
+        "    other(u)\n"
+        "}\n"
+        "PROCEDURE other(u) {\n"
+        "    c = u\n"
+        "}\n"));
+}
+
+TEST(Module, derivimplicit) {
+    auto make_module = [](const std::string& solve) {
+        return
+            "NEURON { SUFFIX di }\n"
+            "STATE { x y }\n"
+            "BREAKPOINT {\n"
+            "    " + solve + "\n"
+            "}\n"
+            "DERIVATIVE states {\n"
+            "    x' = -x*y\n"
+            "    y' = x - exp(y)\n"
+            "}\n";
+    };
+
+    auto check = [&](const std::string& solve) {
+        Module m(make_module(solve), "di.mod");
+        Parser p(m, false);
+        EXPECT_TRUE(p.parse());
+        return m.semantic();
+    };
+
+    EXPECT_TRUE(check("SOLVE states METHOD derivimplicit"));
+    EXPECT_FALSE(check("SOLVE states STEADYSTATE derivimplicit"));
+
+    auto advance_state = [&](Module& m) -> auto& {
+        Parser p(m, false);
+        EXPECT_TRUE(p.parse());
+        EXPECT_TRUE(m.semantic());
+        return m.symbols().at("advance_state")->is_api_method()->body()->statements();
+    };
+
+    // Without a tolerance, each Newton iteration adds the same statements to
+    // advance_state.
+    auto advance_state_size = [&](unsigned newton_iterations) {
+        Module m(make_module("SOLVE states METHOD derivimplicit"), "di.mod");
+        m.newton_iterations(newton_iterations);
+        m.newton_tolerance(0);
+        return advance_state(m).size();
+    };
+
+    auto n1 = advance_state_size(1);
+    auto n2 = advance_state_size(2);
+    auto n5 = advance_state_size(5);
+    EXPECT_LT(n1, n2);
+    EXPECT_EQ(4*(n2-n1), n5-n1);
+
+    // With a tolerance, each iteration after the first is conditional.
+    auto count_conditional = [&](unsigned newton_iterations) {
+        Module m(make_module("SOLVE states METHOD derivimplicit"), "di.mod");
+        m.newton_iterations(newton_iterations);
+        m.newton_tolerance(1e-6);
+        auto& body = advance_state(m);
+        return std::count_if(body.begin(), body.end(), [](auto& s) { return s->is_if(); });
+    };
+
+    EXPECT_EQ(0, count_conditional(1));
+    EXPECT_EQ(1, count_conditional(2));
+    EXPECT_EQ(4, count_conditional(5));
+}
+
+TEST(Module, freeze_global) {
+    auto make_module = [](const std::map<std::string, std::string>& frozen) {
+        Module m(std::string(
+            "NEURON { SUFFIX fg RANGE g GLOBAL k }\n"
+            "PARAMETER { k = 1 g = 2 q = 3 }\n"
+            "ASSIGNED { a }\n"
+            "BREAKPOINT {\n"
+            "    a = k*g*q\n"
+            "}\n"), "fg.mod");
+        for (auto& [name, value]: frozen) m.freeze_global(name, value);
+        return m;
+    };
+
+    auto check = [](Module& m) {
+        Parser p(m, false);
+        EXPECT_TRUE(p.parse());
+        return m.semantic();
+    };
+
+    {
+        auto m = make_module({{"k", "4"}, {"q", "-5"}});
+        EXPECT_TRUE(check(m));
+        EXPECT_EQ(0u, m.symbols().count("k"));
+        EXPECT_EQ(0u, m.symbols().count("q"));
+        EXPECT_EQ(1u, m.symbols().count("g"));
+        EXPECT_EQ(1u, m.parameter_block().parameters.size());
+        EXPECT_TRUE(m.neuron_block().globals.empty());
+    }
+
+    // A frozen global is dropped from the DEPEND list of a TABLE.
+    {
+        Module m(std::string(
+            "NEURON { SUFFIX fg RANGE a GLOBAL k }\n"
+            "PARAMETER { k = 1 celsius }\n"
+            "ASSIGNED { v a }\n"
+            "BREAKPOINT {\n"
+            "    rates(v)\n"
+            "}\n"
+            "PROCEDURE rates(u) {\n"
+            "    TABLE a DEPEND k, celsius FROM -100 TO 100 WITH 200\n"
+            "    a = k*u*celsius\n"
+            "}\n"), "fg.mod");
+        m.freeze_global("k", "4");
+        EXPECT_TRUE(check(m));
+
+        auto rates = m.symbols().at("rates")->is_procedure();
+        ASSERT_TRUE(rates->table());
+        auto& depend = rates->table()->depend();
+        ASSERT_EQ(1u, depend.size());
+        EXPECT_EQ("celsius", depend[0]);
+    }
+
+    // Only global parameters can be frozen.
+    {
+        auto m = make_module({{"g", "4"}});
+        EXPECT_FALSE(check(m));
+    }
+    {
+        auto m = make_module({{"x", "4"}});
+        EXPECT_FALSE(check(m));
+    }
+}
@@ -256,11 +256,19 @@ TEST(Parser, parse_solve) {
         EXPECT_EQ(s->name(), "states");
     }
 
+    EXPECT_TRUE(check_parse(s, &Parser::parse_solve, "SOLVE states METHOD derivimplicit"));
+    if (s) {
+        EXPECT_EQ(s->method(), solverMethod::derivimplicit);
+        EXPECT_EQ(s->name(), "states");
+    }
+
     EXPECT_TRUE(check_parse(s, &Parser::parse_solve, "SOLVE states"));
     if (s) {
         EXPECT_EQ(s->method(), solverMethod::none);
         EXPECT_EQ(s->name(), "states");
     }
+
+    EXPECT_FALSE(check_parse(s, &Parser::parse_solve, "SOLVE states METHOD euler"));
 }
 
 TEST(Parser, parse_conductance) {
@@ -279,6 +287,86 @@ TEST(Parser, parse_conductance) {
     }
 }
 
+TEST(Parser, parse_table) {
+    std::unique_ptr<TableExpression> s;
+
+    EXPECT_TRUE(check_parse(s, &Parser::parse_table, "TABLE minf, mtau DEPEND celsius, q10 FROM -100 TO 100 WITH 200"));
+    if (s) {
+        EXPECT_EQ((std::vector<std::string>{"minf", "mtau"}), s->names());
+        EXPECT_EQ((std::vector<std::string>{"celsius", "q10"}), s->depend());
+        EXPECT_EQ(-100., s->from());
+        EXPECT_EQ(100., s->to());
+        EXPECT_EQ(200, s->n());
+    }
+
+    EXPECT_TRUE(check_parse(s, &Parser::parse_table, "TABLE minf FROM -1.5 TO 2.5e1 WITH 10"));
+    if (s) {
+        EXPECT_EQ(std::vector<std::string>{"minf"}, s->names());
+        EXPECT_TRUE(s->depend().empty());
+        EXPECT_EQ(-1.5, s->from());
+        EXPECT_EQ(25., s->to());
+        EXPECT_EQ(10, s->n());
+    }
+
+    const char* bad_tables[] = {
+        "TABLE minf DEPEND FROM -100 TO 100 WITH 200",
+        "TABLE minf FROM -100 TO 100",
+        "TABLE minf FROM -100 TO 100 WITH 2.5",
+        "TABLE minf FROM -100 TO 100 WITH 0",
+        "TABLE minf FROM 100 TO -100 WITH 200",
+        "TABLE minf FROM a TO 100 WITH 200",
+    };
+    for (auto text: bad_tables) {
+        EXPECT_TRUE(check_parse_fail(&Parser::parse_table, text));
+    }
+
+    // TABLE statements are moved from the procedure body to the procedure.
+    std::unique_ptr<ProcedureExpression> p;
+    EXPECT_TRUE(check_parse(p, &Parser::parse_procedure,
+        "PROCEDURE rates(v) {\n"
+        "    LOCAL x\n"
+        "    TABLE minf DEPEND celsius FROM -100 TO 100 WITH 200\n"
+        "    x = v\n"
+        "    minf = x\n"
+        "}"));
+    if (p) {
+        ASSERT_TRUE(p->table());
+        EXPECT_EQ(std::vector<std::string>{"minf"}, p->table()->names());
+        for (auto& stmt: p->body()->statements()) {
+            EXPECT_FALSE(stmt->is_table_statement());
+        }
+    }
+
+    const char* bad_procedures[] = {
+        "PROCEDURE rates(v) {\n"
+        "    if (v > 0) {\n"
+        "        TABLE minf FROM -100 TO 100 WITH 200\n"
+        "    }\n"
+        "    minf = v\n"
+        "}",
+        "PROCEDURE rates(v) {\n"
+        "    TABLE minf FROM -100 TO 100 WITH 200\n"
+        "    TABLE minf FROM -100 TO 100 WITH 200\n"
+        "    minf = v\n"
+        "}",
+        "INITIAL {\n"
+        "    TABLE minf FROM -100 TO 100 WITH 200\n"
+        "    minf = v\n"
+        "}",
+    };
+    for (auto text: bad_procedures) {
+        EXPECT_TRUE(check_parse_fail(&Parser::parse_procedure, text));
+    }
+
+    // TABLE statements in functions are ignored.
+    std::unique_ptr<FunctionExpression> f;
+    EXPECT_TRUE(check_parse(f, &Parser::parse_function,
+        "FUNCTION alpha(v) {\n"
+        "    TABLE FROM -100 TO 100 WITH 200\n"
+        "    alpha = v\n"
+        "}"));
+}
+
 TEST(Parser, parse_if) {
     std::unique_ptr<IfExpression> s;
 
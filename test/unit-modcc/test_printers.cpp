@@ -9,6 +9,7 @@
 #include "printer/cexpr_emit.hpp"
 #include "printer/cprinter.hpp"
 #include "printer/gpuprinter.hpp"
+#include "printer/printeropt.hpp"
 #include "expression.hpp"
 #include "symdiff.hpp"
 
@@ -274,6 +275,119 @@ TEST(CPrinter, proc_body_inlined) {
     EXPECT_EQ(strip(expected), proc_with_locals);
 }
 
+TEST(CPrinter, single_precision_state) {
+    Module m(io::read_all(DATADIR "/mod_files/test6.mod"), "test6.mod");
+    Parser p(m, false);
+    p.parse();
+    m.semantic();
+
+    const auto npos = std::string::npos;
+    printer_options opt;
+
+    std::string text = strip(emit_cpp_source(m, opt));
+    EXPECT_EQ(npos, text.find("float*"));
+    EXPECT_NE(npos, text.find(strip("pp->s0[i_] = pp->s1[i_]*pp->s2[i_];")));
+
+    // State is stored as float, converted on load and rounded on store.
+    opt.single_precision_state = true;
+    text = strip(emit_cpp_source(m, opt));
+    for (auto s: {"s0", "s1", "s2"}) {
+        EXPECT_NE(npos, text.find(strip(std::string("float* ")+s+";")));
+        EXPECT_NE(npos, text.find(strip(std::string("{\"")+s+"\", &pp_."+s+"}")));
+    }
+    EXPECT_NE(npos, text.find(strip("pp->s0[i_] = ::arb::fvm_value_type(pp->s1[i_])*::arb::fvm_value_type(pp->s2[i_]);")));
+    EXPECT_NE(npos, text.find("float_field_table()"));
+}
+
+TEST(CPrinter, fast_math_level) {
+    Module m(io::read_all(DATADIR "/mod_files/test6.mod"), "test6.mod");
+    Parser p(m, false);
+    p.parse();
+    m.semantic();
+
+    const auto npos = std::string::npos;
+    printer_options opt;
+
+    std::string text = strip(emit_cpp_source(m, opt));
+    EXPECT_EQ(npos, text.find("fast_"));
+    EXPECT_NE(npos, text.find(strip("t1 = exprelr(t0);")));
+
+    opt.fast_math_level = 2;
+    text = strip(emit_cpp_source(m, opt));
+    EXPECT_NE(npos, text.find("#include<arbor/fast_math.hpp>"));
+    EXPECT_NE(npos, text.find(strip("t1 = fast_exprelr<2>(t0);")));
+    EXPECT_NE(npos, text.find(strip("= fast_log<2>(")));
+    EXPECT_EQ(npos, text.find(strip(" exp(")));
+
+    // Simd printer: expressions only, as printing the module would also
+    // allocate mask names.
+    Scope<Symbol>::symbol_map globals;
+    auto scope = std::make_shared<Scope<Symbol>>(globals);
+    for (auto var: {"x", "y"}) {
+        scope->add_local_symbol(var, make_symbol<LocalVariable>(Location(), var, localVariableKind::local));
+    }
+
+    auto e = parse_line_expression("y = exp(x)*log(x)+x^y");
+    ASSERT_TRUE(e);
+    e->semantic(scope);
+    ASSERT_FALSE(e->has_error());
+
+    std::stringstream out;
+    SimdPrinter printer(out);
+    printer.set_fast_math_level(1);
+    e->accept(&printer);
+    EXPECT_EQ(strip("assign(y, S::add(S::mul(S::fast_exp<1>(x), S::fast_log<1>(x)), S::fast_pow<1>(x, y)))"), strip(out.str()));
+}
+
+TEST(CPrinter, profile_regions) {
+    Module m(io::read_all(DATADIR "/mod_files/test1.mod"), "test1.mod");
+    Parser p(m, false);
+    p.parse();
+    m.semantic();
+
+    const auto npos = std::string::npos;
+    printer_options opt;
+
+    std::string text = emit_cpp_source(m, opt);
+    EXPECT_EQ(npos, text.find("profiler"));
+
+    // One region for each of the API methods called during integration,
+    // except write_ions, which runs inside the ionupdate region of the cell.
+    opt.profile = true;
+    text = emit_cpp_source(m, opt);
+    EXPECT_EQ(npos, text.find("advance_integrate_ions"));
+    for (auto region: {"state", "current", "deliver"}) {
+        auto id = std::string("profiler_region_id(\"advance_integrate_")+region+"_expsyn\")";
+        EXPECT_NE(npos, text.find(id)) << id;
+    }
+
+    auto n_leave = 0u;
+    for (auto i = text.find("profiler_leave()"); i!=npos; i = text.find("profiler_leave()", i+1)) {
+        ++n_leave;
+    }
+    EXPECT_EQ(3u, n_leave);
+}
+
+TEST(CPrinter, uniform_parameters) {
+    Module m(io::read_all(DATADIR "/mod_files/test1.mod"), "test1.mod");
+    Parser p(m, false);
+    p.parse();
+    m.semantic();
+
+    const auto npos = std::string::npos;
+    printer_options opt;
+
+    // The uniform variant of each loop is selected once per kernel call,
+    // and reads the parameter from a local copy.
+    std::string text = strip(emit_cpp_source(m, opt));
+    EXPECT_NE(npos, text.find(strip("const ::arb::fvm_value_type* e_uniform_ = nullptr;")));
+    EXPECT_NE(npos, text.find(strip("if (pp->e_uniform_) { const ::arb::fvm_value_type e_uniform_value_ = *pp->e_uniform_;")));
+    EXPECT_NE(npos, text.find(strip("i = pp->g[i_]*(v-e_uniform_value_);")));
+    EXPECT_NE(npos, text.find(strip("i = pp->g[i_]*(v-pp->e[i_]);")));
+    EXPECT_NE(npos, text.find(strip("if (pp->tau_uniform_) { const ::arb::fvm_value_type tau_uniform_value_ = *pp->tau_uniform_;")));
+    EXPECT_EQ(npos, text.find("?*pp->"));
+}
+
 TEST(SimdPrinter, simd_if_else) {
     std::vector<const char*> expected_procs = {
             "simd_value u;\n"
@@ -331,3 +445,66 @@ TEST(SimdPrinter, simd_if_else) {
 
     }
 }
+
+TEST(SimdPrinter, default_abi_width) {
+    Module m(io::read_all(DATADIR "/mod_files/test1.mod"), "test1.mod");
+    Parser p(m, false);
+    p.parse();
+    m.semantic();
+
+    const auto npos = std::string::npos;
+    printer_options opt;
+
+    // Without a width, the generic ABI uses the native width.
+    opt.simd = simd_spec(simd_spec::default_abi);
+    std::string text = strip(emit_cpp_source(m, opt));
+    EXPECT_NE(npos, text.find(strip("vector_length_ = S::simd_abi::native_width<::arb::fvm_value_type>::value;")));
+
+    // The generic ABI supports any width: the vector length is the width.
+    opt.simd = simd_spec(simd_spec::default_abi, 2);
+    text = strip(emit_cpp_source(m, opt));
+    EXPECT_NE(npos, text.find(strip("static constexpr unsigned vector_length_ = 2;")));
+    EXPECT_NE(npos, text.find(strip("static constexpr unsigned simd_width_ = 2;")));
+    EXPECT_NE(npos, text.find(strip("S::simd<::arb::fvm_value_type, vector_length_, S::simd_abi::default_abi>")));
+}
+
+TEST(SimdPrinter, net_receive) {
+    const auto npos = std::string::npos;
+    printer_options opt;
+    opt.simd = simd_spec(simd_spec::native);
+
+    // Event delivery is vectorised, with gather and scatter on the instance
+    // indices of the events.
+    {
+        Module m(io::read_all(DATADIR "/mod_files/test1.mod"), "test1.mod");
+        Parser p(m, false);
+        p.parse();
+        m.semantic();
+
+        std::string text = strip(emit_cpp_source(m, opt));
+        EXPECT_NE(npos, text.find(strip("event_index_constraint(ev_index_, simd_width_)")));
+        EXPECT_NE(npos, text.find(strip(
+            "indirect(pp->g, index_, simd_width_, constraint_category_) = "
+            "S::add(simd_cast<simd_value>(indirect(pp->g, index_, simd_width_, constraint_category_)), weight);")));
+    }
+
+    // NET_RECEIVE blocks with conditionals are delivered by the scalar kernel.
+    {
+        const char* source =
+            "NEURON { POINT_PROCESS cond NONSPECIFIC_CURRENT i }\n"
+            "STATE { g }\n"
+            "BREAKPOINT { i = g }\n"
+            "NET_RECEIVE(weight) {\n"
+            "    if (weight > 0) { g = g + weight }\n"
+            "}\n";
+
+        Module m(std::string(source), "cond.mod");
+        Parser p(m, false);
+        p.parse();
+        m.semantic();
+
+        std::string text = strip(emit_cpp_source(m, opt));
+        EXPECT_EQ(npos, text.find("event_index_constraint"));
+        EXPECT_NE(npos, text.find(strip("net_receive(pp, p->mech_index, p->weight);")));
+    }
+}
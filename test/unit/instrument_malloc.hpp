@@ -20,7 +20,9 @@
 
 #include <cstddef>
 
-#if (__GLIBC__==2)
+// The malloc hooks were removed in glibc 2.34.
+
+#if (__GLIBC__==2) && (__GLIBC_MINOR__<34)
 #include <malloc.h>
 #define CAN_INSTRUMENT_MALLOC
 #endif
@@ -0,0 +1,28 @@
+: A rate tabulated with a TABLE statement that depends on the temperature,
+: for testing the rebuilding of tables generated by modcc.
+
+NEURON {
+    SUFFIX table_celsius_test
+}
+
+PARAMETER {
+    celsius
+}
+
+ASSIGNED {
+    v
+    q
+}
+
+INITIAL {
+    rates(v)
+}
+
+BREAKPOINT {
+    rates(v)
+}
+
+PROCEDURE rates(u) {
+    TABLE q DEPEND celsius FROM -100 TO 100 WITH 200
+    q = celsius*exp(u/50)
+}
@@ -0,0 +1,38 @@
+: Rates tabulated with a TABLE statement, for testing the
+: interpolation tables generated by modcc.
+
+NEURON {
+    SUFFIX table_test
+    GLOBAL k
+}
+
+PARAMETER {
+    k = 1
+}
+
+ASSIGNED {
+    v
+    a
+    b
+}
+
+INITIAL {
+    rates(v)
+}
+
+BREAKPOINT {
+    rates(v)
+}
+
+PROCEDURE rates(u) {
+    LOCAL x
+    TABLE a, b DEPEND k FROM -100 TO 100 WITH 200
+    x = u/50
+    a = k*exp(x)
+    if (u < 0) {
+        b = -u
+    }
+    else {
+        b = u*u
+    }
+}
@@ -0,0 +1,24 @@
+NEURON {
+    SUFFIX test_derivimplicit
+}
+
+STATE {
+    x y
+}
+
+BREAKPOINT {
+    SOLVE state METHOD derivimplicit
+}
+
+DERIVATIVE state {
+    LOCAL r
+    r = x*x
+
+    x' = -r
+    y' = x - y
+}
+
+INITIAL {
+    x = 1
+    y = 0
+}
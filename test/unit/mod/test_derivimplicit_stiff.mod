@@ -0,0 +1,21 @@
+NEURON {
+    SUFFIX test_derivimplicit_stiff
+}
+
+STATE {
+    x y
+}
+
+BREAKPOINT {
+    SOLVE state METHOD derivimplicit
+}
+
+DERIVATIVE state {
+    x' = -1000*(x - y*y)
+    y' = -y
+}
+
+INITIAL {
+    x = 0
+    y = 1
+}
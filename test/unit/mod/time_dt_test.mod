@@ -0,0 +1,26 @@
+NEURON {
+    SUFFIX time_dt_test
+}
+
+PARAMETER {
+    t
+}
+
+STATE {
+    t_seen
+    dt_seen
+}
+
+BREAKPOINT {
+    SOLVE states
+}
+
+DERIVATIVE states {
+    t_seen = t
+    dt_seen = dt
+}
+
+INITIAL {
+    t_seen = -1
+    dt_seen = -1
+}
@@ -10,6 +10,8 @@
 #include "arbor/cable_cell_param.hpp"
 #include "arbor/morph/morphology.hpp"
 #include "arbor/morph/segment_tree.hpp"
+#include "backends/multicore/multicore_common.hpp"
+#include "backends/multicore/partition_by_constraint.hpp"
 #include "fvm_layout.hpp"
 #include "util/maputil.hpp"
 #include "util/rangeutil.hpp"
@@ -496,6 +498,98 @@ TEST(fvm_layout, synapse_targets) {
     }
 }
 
+TEST(fvm_layout, fused_density) {
+    auto system = two_cell_system();
+    auto& descriptions = system.descriptions;
+
+    // hh and kdrmt on both somas, and kamt with pas on all dendrites, are
+    // fused; nax on one soma only is not.
+    for (auto& d: descriptions) {
+        d.decorations.paint("soma"_lab, "kdrmt");
+        d.decorations.paint("dend"_lab, "kamt");
+    }
+    descriptions[0].decorations.paint("soma"_lab, "nax");
+
+    cable_cell_global_properties gprop;
+    gprop.default_parameters = neuron_parameter_defaults;
+
+    auto cells = system.cells();
+    check_two_cell_system(cells);
+    fvm_cv_discretization D = fvm_cv_discretize(cells, gprop.default_parameters);
+
+    fvm_mechanism_data M = fvm_build_mechanism_data(gprop, cells, D);
+    using group = std::vector<std::string>;
+    EXPECT_EQ((std::vector<group>{{"hh", "kdrmt"}, {"kamt", "pas"}}), M.fused_density);
+
+    gprop.fused_density_block_size = 0;
+    EXPECT_TRUE(fvm_build_mechanism_data(gprop, cells, D).fused_density.empty());
+}
+
+TEST(fvm_layout, reorder_point_instances) {
+    using ivec = std::vector<fvm_index_type>;
+
+    // Instance i has parameter value i, multiplicity 1 + i%2, and targets
+    // numbered consecutively.
+
+    fvm_mechanism_config config;
+    config.kind = mechanismKind::point;
+    config.cv = {0, 0, 0, 0, 0, 1, 2, 3, 5, 5, 7, 8, 9, 10, 12, 12};
+
+    std::vector<fvm_value_type> param;
+    ivec targets_of[16];
+    fvm_index_type next_target = 0;
+    for (auto i: count_along(config.cv)) {
+        param.push_back(i);
+        config.multiplicity.push_back(1+i%2);
+        for (std::size_t j = 0; j<=i%2; ++j) {
+            targets_of[i].push_back(next_target);
+            config.target.push_back(next_target++);
+        }
+    }
+    config.param_values = {{"p", param}};
+
+    auto histogram = [](ivec cv, unsigned width) {
+        cv.resize(math::round_up(cv.size(), width), cv.back());
+        return multicore::make_constraint_histogram(multicore::make_constraint_partition(cv, cv.size(), width));
+    };
+
+    auto h0 = histogram(config.cv, 4);
+    EXPECT_EQ(1u, h0.constant);
+    EXPECT_EQ(1u, h0.contiguous);
+    EXPECT_EQ(2u, h0.none);
+
+    auto unchanged = config;
+    fvm_reorder_point_instances(unchanged, 1);
+    EXPECT_EQ(config.cv, unchanged.cv);
+    EXPECT_EQ(config.target, unchanged.target);
+
+    auto original = config;
+    fvm_reorder_point_instances(config, 4);
+
+    auto h1 = histogram(config.cv, 4);
+    EXPECT_EQ(1u, h1.constant);
+    EXPECT_EQ(2u, h1.contiguous);
+    EXPECT_EQ(0u, h1.independent);
+    EXPECT_EQ(1u, h1.none);
+
+    // All instance data is permuted together.
+    ASSERT_EQ(original.cv.size(), config.cv.size());
+    ASSERT_EQ(1u, config.param_values.size());
+
+    std::vector<bool> seen(16);
+    ivec target;
+    for (auto j: count_along(config.cv)) {
+        auto i = (fvm_index_type)config.param_values[0].second[j];
+        ASSERT_FALSE(seen[i]);
+        seen[i] = true;
+
+        EXPECT_EQ(original.cv[i], config.cv[j]);
+        EXPECT_EQ(original.multiplicity[i], config.multiplicity[j]);
+        util::append(target, targets_of[i]);
+    }
+    EXPECT_EQ(target, config.target);
+}
+
 namespace {
     double wm_impl(double wa, double xa) {
         return wa? xa/wa: 0;
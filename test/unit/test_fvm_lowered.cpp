@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 #include <string>
@@ -18,6 +19,7 @@
 #include <arbor/simulation.hpp>
 #include <arbor/schedule.hpp>
 #include <arbor/util/any_ptr.hpp>
+#include <arbor/version.hpp>
 
 #include <arborenv/concurrency.hpp>
 
@@ -53,6 +55,8 @@ ACCESS_BIND(matrix fvm_cell::*, private_matrix_ptr, &fvm_cell::matrix_)
 
 ACCESS_BIND(std::vector<arb::mechanism_ptr> fvm_cell::*, private_mechanisms_ptr, &fvm_cell::mechanisms_)
 
+ACCESS_BIND(std::vector<arb::fvm_index_type> fvm_cell::*, private_tile_cell_divs_ptr, &fvm_cell::tile_cell_divs_)
+
 arb::mechanism* find_mechanism(fvm_cell& fvcell, const std::string& name) {
     for (auto& mech: fvcell.*private_mechanisms_ptr) {
         if (mech->internal_name()==name) {
@@ -1544,4 +1548,437 @@ TEST(fvm_lowered, label_data) {
         }
         EXPECT_EQ(actual_labeled_ranges, expected_labeled_ranges);
     }
-}
\ No newline at end of file
+}
+TEST(fvm_lowered, tiled_integration) {
+    arb::proc_allocation resources;
+    arb::execution_context context(resources);
+
+    // Cells alternating with and without stimulus, with a synapse and a detector
+    // on the soma, and with Nernst sodium reversal potential.
+
+    std::vector<cable_cell> cells;
+    for (unsigned i = 0; i<6; ++i) {
+        auto desc = make_cell_ball_and_3stick(i%2==0);
+        desc.decorations.place(mlocation{0, 0.5}, "expsyn", "syn");
+        desc.decorations.place(mlocation{0, 0.5}, threshold_detector{10}, "detector");
+        cells.push_back(desc);
+    }
+
+    struct tiled_recipe: cable1d_recipe {
+        tiled_recipe(const std::vector<cable_cell>& cells, std::size_t tile_size_bytes): cable1d_recipe(cells) {
+            nernst_ion("na");
+            cell_gprop_.tile_size_bytes = tile_size_bytes;
+        }
+    };
+
+    std::vector<cell_gid_type> gids = {0, 1, 2, 3, 4, 5};
+
+    fvm_cell untiled(context), tiled(context);
+    auto fvm_info = untiled.initialize(gids, tiled_recipe(cells, 0));
+    tiled.initialize(gids, tiled_recipe(cells, 1));
+
+    // One cell per tile; SIMD mechanism kernels can not be tiled.
+#ifndef ARB_VECTORIZE_ENABLED
+    EXPECT_EQ(7u, (tiled.*private_tile_cell_divs_ptr).size());
+#endif
+    EXPECT_TRUE((untiled.*private_tile_cell_divs_ptr).empty());
+
+    std::vector<deliverable_event> events;
+    for (unsigned i = 0; i<gids.size(); ++i) {
+        events.push_back(deliverable_event(1.0+i, fvm_info.target_handles[i], 0.05));
+    }
+    util::sort_by(events, [](auto& e) { return e.handle.intdom_index; });
+
+    const auto& untiled_state = *(untiled.*private_state_ptr);
+    const auto& tiled_state = *(tiled.*private_state_ptr);
+
+    // Sample the voltage at the first CV of each cell.
+    std::vector<sample_event> samples;
+    for (unsigned i = 0; i<gids.size(); ++i) {
+        auto cv = std::find(untiled_state.cv_to_intdom.begin(), untiled_state.cv_to_intdom.end(), (fvm_index_type)i)-untiled_state.cv_to_intdom.begin();
+        samples.push_back(sample_event{2.0, (cell_gid_type)i, {untiled_state.voltage.data()+cv, (sample_size_type)i}});
+    }
+
+    auto untiled_result = untiled.integrate(20, 0.025, events, samples);
+    std::vector<double> untiled_samples(untiled_result.sample_value.begin(), untiled_result.sample_value.end());
+    std::vector<threshold_crossing> untiled_crossings(untiled_result.crossings.begin(), untiled_result.crossings.end());
+
+    for (auto& s: samples) {
+        s.raw.handle = tiled_state.voltage.data()+(s.raw.handle-untiled_state.voltage.data());
+    }
+    auto tiled_result = tiled.integrate(20, 0.025, events, samples);
+
+    EXPECT_FALSE(untiled_crossings.empty());
+    ASSERT_EQ(untiled_crossings.size(), tiled_result.crossings.size());
+    for (auto i: util::count_along(untiled_crossings)) {
+        EXPECT_EQ(untiled_crossings[i].index, tiled_result.crossings[i].index);
+        EXPECT_EQ(untiled_crossings[i].time, tiled_result.crossings[i].time);
+    }
+
+    EXPECT_TRUE(util::equal(untiled_samples, tiled_result.sample_value));
+    EXPECT_TRUE(util::equal(untiled_state.voltage, tiled_state.voltage));
+    EXPECT_TRUE(util::equal(untiled_state.time, tiled_state.time));
+    for (auto& [name, ion]: untiled_state.ion_data) {
+        EXPECT_TRUE(util::equal(ion.eX_, tiled_state.ion_data.at(name).eX_));
+        EXPECT_TRUE(util::equal(ion.iX_, tiled_state.ion_data.at(name).iX_));
+    }
+}
+
+TEST(fvm_lowered, fused_density) {
+    arb::proc_allocation resources;
+    arb::execution_context context(resources);
+
+    // Cells alternating with and without stimulus, with kamt fused with pas on
+    // the dendrites and kdrmt fused with hh on the soma.
+
+    std::vector<cable_cell> cells;
+    for (unsigned i = 0; i<6; ++i) {
+        auto desc = make_cell_ball_and_3stick(i%2==0);
+        desc.decorations.paint("soma"_lab, "kdrmt");
+        desc.decorations.paint("dend"_lab, "kamt");
+        desc.decorations.place(mlocation{0, 0.5}, "expsyn", "syn");
+        desc.decorations.place(mlocation{0, 0.5}, threshold_detector{10}, "detector");
+        cells.push_back(desc);
+    }
+
+    struct fused_recipe: cable1d_recipe {
+        fused_recipe(const std::vector<cable_cell>& cells, std::size_t block_size): cable1d_recipe(cells) {
+            cell_gprop_.fused_density_block_size = block_size;
+        }
+    };
+
+    std::vector<cell_gid_type> gids = {0, 1, 2, 3, 4, 5};
+
+    fvm_cell unfused(context), fused(context);
+    auto fvm_info = unfused.initialize(gids, fused_recipe(cells, 0));
+    fused.initialize(gids, fused_recipe(cells, 4));
+
+    // Members of a fused group are adjacent.
+    auto index_of = [&](const std::string& name) {
+        auto& mechs = fused.*private_mechanisms_ptr;
+        return std::find_if(mechs.begin(), mechs.end(), [&](auto& m) { return m->internal_name()==name; })-mechs.begin();
+    };
+    EXPECT_EQ(1, std::abs(index_of("kamt")-index_of("pas")));
+    EXPECT_EQ(1, std::abs(index_of("kdrmt")-index_of("hh")));
+
+    // Groups that would run as a single block are not reordered.
+    auto mechanism_names = [](fvm_cell& cell) {
+        std::vector<std::string> names;
+        for (auto& m: cell.*private_mechanisms_ptr) names.push_back(m->internal_name());
+        return names;
+    };
+    fvm_cell one_block(context);
+    one_block.initialize(gids, fused_recipe(cells, 1<<20));
+    EXPECT_EQ(mechanism_names(unfused), mechanism_names(one_block));
+
+    std::vector<deliverable_event> events;
+    for (unsigned i = 0; i<gids.size(); ++i) {
+        events.push_back(deliverable_event(1.0+i, fvm_info.target_handles[i], 0.05));
+    }
+    util::sort_by(events, [](auto& e) { return e.handle.intdom_index; });
+
+    const auto& unfused_state = *(unfused.*private_state_ptr);
+    const auto& fused_state = *(fused.*private_state_ptr);
+
+    auto unfused_result = unfused.integrate(20, 0.025, events, {});
+    std::vector<threshold_crossing> unfused_crossings(unfused_result.crossings.begin(), unfused_result.crossings.end());
+    auto fused_result = fused.integrate(20, 0.025, events, {});
+
+    EXPECT_FALSE(unfused_crossings.empty());
+    ASSERT_EQ(unfused_crossings.size(), fused_result.crossings.size());
+    for (auto i: util::count_along(unfused_crossings)) {
+        EXPECT_EQ(unfused_crossings[i].index, fused_result.crossings[i].index);
+        EXPECT_EQ(unfused_crossings[i].time, fused_result.crossings[i].time);
+    }
+
+    EXPECT_TRUE(util::equal(unfused_state.voltage, fused_state.voltage));
+    for (auto& [name, ion]: unfused_state.ion_data) {
+        EXPECT_TRUE(util::equal(ion.iX_, fused_state.ion_data.at(name).iX_));
+    }
+    for (auto name: {"kamt", "kdrmt"}) {
+        auto m = find_mechanism(unfused, name);
+        auto n = find_mechanism(fused, name);
+        ASSERT_TRUE(m && n);
+        EXPECT_EQ(mechanism_field(m, "m"), mechanism_field(n, "m"));
+    }
+}
+
+TEST(fvm_lowered, fused_density_mixed_simd_width) {
+    arb::proc_allocation resources;
+    arb::execution_context context(resources);
+
+    // hh and pas fused with pas_simd2, which has a SIMD width of two, on the
+    // dendrites; the block size is not a multiple of the SIMD widths.
+
+    std::vector<cable_cell> cells;
+    for (unsigned i = 0; i<5; ++i) {
+        auto desc = make_cell_ball_and_3stick(false);
+        if (i==0) {
+            desc.decorations.place(mlocation{0, 0.5}, i_clamp::box(1, 5, 0.3), "clamp");
+        }
+        desc.decorations.paint("dend"_lab, "hh");
+        desc.decorations.paint("dend"_lab, "pas_simd2");
+        desc.decorations.place(mlocation{0, 0.5}, threshold_detector{10}, "detector");
+        cells.push_back(desc);
+    }
+
+    struct fused_recipe: cable1d_recipe {
+        fused_recipe(const std::vector<cable_cell>& cells, std::size_t block_size): cable1d_recipe(cells) {
+            cell_gprop_.fused_density_block_size = block_size;
+            catalogue() = make_unit_test_catalogue(global_default_catalogue());
+        }
+    };
+
+    std::vector<cell_gid_type> gids = {0, 1, 2, 3, 4};
+
+    fvm_cell unfused(context), fused(context);
+    unfused.initialize(gids, fused_recipe(cells, 0));
+    fused.initialize(gids, fused_recipe(cells, 3));
+
+    auto hh = find_mechanism(fused, "hh");
+    auto pas = find_mechanism(fused, "pas_simd2");
+    ASSERT_TRUE(hh && pas);
+    EXPECT_EQ(2u, backend::mechanism_simd_width(pas));
+
+    const auto& unfused_state = *(unfused.*private_state_ptr);
+    const auto& fused_state = *(fused.*private_state_ptr);
+
+    auto unfused_result = unfused.integrate(10, 0.025, {}, {});
+    std::vector<threshold_crossing> unfused_crossings(unfused_result.crossings.begin(), unfused_result.crossings.end());
+    auto fused_result = fused.integrate(10, 0.025, {}, {});
+
+    EXPECT_FALSE(unfused_crossings.empty());
+    ASSERT_EQ(unfused_crossings.size(), fused_result.crossings.size());
+    for (auto i: util::count_along(unfused_crossings)) {
+        EXPECT_EQ(unfused_crossings[i].index, fused_result.crossings[i].index);
+        EXPECT_EQ(unfused_crossings[i].time, fused_result.crossings[i].time);
+    }
+
+    EXPECT_TRUE(util::equal(unfused_state.voltage, fused_state.voltage));
+    EXPECT_EQ(mechanism_field(find_mechanism(unfused, "hh"), "m"), mechanism_field(hh, "m"));
+}
+
+TEST(fvm_lowered, adaptive_dt) {
+    arb::proc_allocation resources;
+    arb::execution_context context(resources);
+
+    // A stimulated cell and a quiescent cell, each with a detector on the soma.
+
+    std::vector<cable_cell> cells;
+    for (unsigned i = 0; i<2; ++i) {
+        auto desc = make_cell_ball_and_stick(false);
+        if (i==0) {
+            desc.decorations.place(mlocation{0, 0.5}, i_clamp::box(5, 20, 0.2), "clamp");
+        }
+        desc.decorations.place(mlocation{0, 0.5}, threshold_detector{10}, "detector");
+        cells.push_back(desc);
+    }
+
+    struct adaptive_recipe: cable1d_recipe {
+        adaptive_recipe(const std::vector<cable_cell>& cells, double tolerance): cable1d_recipe(cells) {
+            cell_gprop_.adaptive_dt_tolerance = tolerance;
+        }
+    };
+
+    std::vector<cell_gid_type> gids = {0, 1};
+
+    fvm_cell fixed(context), adaptive(context);
+    fixed.initialize(gids, adaptive_recipe(cells, 0));
+    adaptive.initialize(gids, adaptive_recipe(cells, 0.01));
+
+    const auto& fixed_state = *(fixed.*private_state_ptr);
+    const auto& adaptive_state = *(adaptive.*private_state_ptr);
+
+    EXPECT_FALSE(fixed_state.adaptive_dt());
+    ASSERT_TRUE(adaptive_state.adaptive_dt());
+
+    // Reference solution with a fine fixed time step.
+    auto fixed_result = fixed.integrate(30, 0.0025, {}, {});
+    std::vector<threshold_crossing> fixed_crossings(fixed_result.crossings.begin(), fixed_result.crossings.end());
+
+    // During the upstroke of the spike, the stimulated cell takes shorter
+    // steps than the quiescent cell, which takes the longest permitted.
+    const double dt_max = 0.1;
+    adaptive.integrate(7.2, dt_max, {}, {});
+    EXPECT_LT(adaptive_state.dt_next[0], dt_max);
+    EXPECT_GE(adaptive_state.dt_next[1], dt_max);
+
+    auto adaptive_result = adaptive.integrate(30, dt_max, {}, {});
+
+    // The stimulated cell spikes at about the same time, and both cells
+    // finish at the same time.
+    ASSERT_EQ(1u, fixed_crossings.size());
+    ASSERT_EQ(1u, adaptive_result.crossings.size());
+    EXPECT_EQ(fixed_crossings[0].index, adaptive_result.crossings[0].index);
+    EXPECT_NEAR(fixed_crossings[0].time, adaptive_result.crossings[0].time, 0.1);
+
+    for (auto i: util::make_span(fixed_state.n_cv)) {
+        EXPECT_NEAR(fixed_state.voltage[i], adaptive_state.voltage[i], 0.1);
+    }
+
+    EXPECT_EQ(30., adaptive_state.time[0]);
+    EXPECT_EQ(30., adaptive_state.time[1]);
+}
+
+TEST(fvm_lowered, adaptive_dt_truncated_step) {
+    arb::proc_allocation resources;
+    arb::execution_context context(resources);
+
+    auto desc = make_cell_ball_and_stick(false);
+    desc.decorations.place(mlocation{0, 0.5}, i_clamp::box(5, 20, 0.2), "clamp");
+    std::vector<cable_cell> cells = {desc};
+
+    struct adaptive_recipe: cable1d_recipe {
+        adaptive_recipe(const std::vector<cable_cell>& cells): cable1d_recipe(cells) {
+            cell_gprop_.adaptive_dt_tolerance = 0.01;
+        }
+    };
+
+    fvm_cell fvcell(context);
+    fvcell.initialize({0}, adaptive_recipe(cells));
+    const auto& state = *(fvcell.*private_state_ptr);
+
+    // Integrate into the upstroke of the spike, where dt is limited by the
+    // error estimate.
+    const double dt_max = 0.1;
+    fvcell.integrate(7.2, dt_max, {}, {});
+    double dt_next = state.dt_next[0];
+    ASSERT_LT(dt_next, dt_max);
+
+    // A step truncated to a tenth of the proposed dt by the end of the
+    // integration interval does not reduce the next step.
+    fvcell.integrate(7.2+0.1*dt_next, dt_max, {}, {});
+    EXPECT_GT(state.dt_next[0], 0.8*dt_next);
+}
+
+TEST(fvm_lowered, implicit_gap_junctions) {
+    arb::proc_allocation resources;
+    arb::execution_context context(resources);
+
+    // Two cells coupled strongly at the soma by a gap junction, with a
+    // stimulus on the first; the coupling time constant of the somata is much
+    // less than the time step.
+
+    std::vector<cable_cell> cells;
+    for (unsigned i = 0; i<2; ++i) {
+        auto desc = make_cell_ball_and_stick(false);
+        if (i==0) {
+            desc.decorations.place(mlocation{0, 0.5}, i_clamp::box(5, 20, 0.4), "clamp");
+        }
+        desc.decorations.place(mlocation{0, 0.5}, gap_junction_site{}, "gj");
+        desc.decorations.place(mlocation{0, 0.5}, threshold_detector{10}, "detector");
+        cells.push_back(desc);
+    }
+
+    struct gj_recipe: cable1d_recipe {
+        gj_recipe(const std::vector<cable_cell>& cells, bool implicit): cable1d_recipe(cells) {
+            cell_gprop_.implicit_gap_junctions = implicit;
+        }
+
+        std::vector<gap_junction_connection> gap_junctions_on(cell_gid_type gid) const override {
+            return {gap_junction_connection({(gid+1)%2, "gj"}, {"gj"}, 0.5)};
+        }
+    };
+
+    std::vector<cell_gid_type> gids = {0, 1};
+
+    fvm_cell explicit_fine(context), explicit_coarse(context), implicit_coarse(context);
+    explicit_fine.initialize(gids, gj_recipe(cells, false));
+    explicit_coarse.initialize(gids, gj_recipe(cells, false));
+    implicit_coarse.initialize(gids, gj_recipe(cells, true));
+
+    const auto& fine_state = *(explicit_fine.*private_state_ptr);
+    const auto& explicit_state = *(explicit_coarse.*private_state_ptr);
+    const auto& implicit_state = *(implicit_coarse.*private_state_ptr);
+
+    EXPECT_FALSE(explicit_state.implicit_gj());
+    ASSERT_TRUE(implicit_state.implicit_gj());
+
+    auto crossings = [](const fvm_integration_result& r) {
+        std::vector<threshold_crossing> c(r.crossings.begin(), r.crossings.end());
+        util::sort_by(c, [](const threshold_crossing& x) { return x.index; });
+        return c;
+    };
+
+    // Reference solution with a fine time step.
+    auto fine_crossings = crossings(explicit_fine.integrate(30, 0.001, {}, {}));
+
+    // With a coarse time step, explicit gap junction currents are unstable
+    // once the stimulus drives the cells apart, while the implicit solution
+    // follows the reference to within the error of the time step.
+    const double dt = 0.05;
+    explicit_coarse.integrate(6, dt, {}, {});
+    auto v_explicit = explicit_state.voltage_bounds();
+    EXPECT_FALSE(v_explicit.first>-100 && v_explicit.second<100);
+
+    auto implicit_crossings = crossings(implicit_coarse.integrate(30, dt, {}, {}));
+
+    ASSERT_EQ(2u, fine_crossings.size());
+    ASSERT_EQ(2u, implicit_crossings.size());
+    for (auto i: util::make_span(2)) {
+        EXPECT_EQ(fine_crossings[i].index, implicit_crossings[i].index);
+        EXPECT_NEAR(fine_crossings[i].time, implicit_crossings[i].time, 0.2);
+    }
+
+    for (auto i: util::make_span(fine_state.n_cv)) {
+        EXPECT_NEAR(fine_state.voltage[i], implicit_state.voltage[i], 0.5);
+    }
+}
+
+TEST(fvm_lowered, steady_state_initialization) {
+    arb::proc_allocation resources;
+    arb::execution_context context(resources);
+
+    // A ball-and-stick cell with HH soma and passive dendrite, whose resting
+    // state differs from the initial membrane potential.
+
+    std::vector<cable_cell> cells = {make_cell_ball_and_stick(false)};
+
+    struct steady_recipe: cable1d_recipe {
+        steady_recipe(const std::vector<cable_cell>& cells, bool steady, unsigned max_iterations = 100, double tolerance = 1e-6):
+            cable1d_recipe(cells)
+        {
+            cell_gprop_.steady_state_initialization = steady;
+            cell_gprop_.steady_state_max_iterations = max_iterations;
+            cell_gprop_.steady_state_tolerance = tolerance;
+        }
+    };
+
+    fvm_cell relaxed(context), steady(context);
+    relaxed.initialize({0}, steady_recipe(cells, false));
+    steady.initialize({0}, steady_recipe(cells, true));
+
+    const auto& relaxed_state = *(relaxed.*private_state_ptr);
+    const auto& steady_state = *(steady.*private_state_ptr);
+
+    // Without steady-state initialization, the cell relaxes from the initial
+    // membrane potential over simulated time.
+    const double v_init = *neuron_parameter_defaults.init_membrane_potential;
+    for (auto i: util::make_span(relaxed_state.n_cv)) {
+        EXPECT_EQ(v_init, relaxed_state.voltage[i]);
+    }
+    relaxed.integrate(500, 0.025, {}, {});
+
+    // With it, the cell starts at rest and stays there.
+    for (auto i: util::make_span(steady_state.n_cv)) {
+        EXPECT_NEAR(relaxed_state.voltage[i], steady_state.voltage[i], 1e-3);
+    }
+    EXPECT_GT(std::abs(steady_state.voltage[0]-v_init), 0.1);
+
+    std::vector<fvm_value_type> v0(steady_state.voltage.begin(), steady_state.voltage.end());
+    steady.integrate(10, 0.025, {}, {});
+    for (auto i: util::make_span(steady_state.n_cv)) {
+        EXPECT_NEAR(v0[i], steady_state.voltage[i], 1e-4);
+    }
+
+    // A reset repeats the initialization.
+    steady.reset();
+    for (auto i: util::make_span(steady_state.n_cv)) {
+        EXPECT_EQ(v0[i], steady_state.voltage[i]);
+    }
+
+    // It is an error if the voltage does not converge within the iteration
+    // limit.
+    fvm_cell unconverged(context);
+    EXPECT_THROW(unconverged.initialize({0}, steady_recipe(cells, true, 2, 0)), range_check_failure);
+}
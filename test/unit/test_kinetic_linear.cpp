@@ -1,3 +1,4 @@
+#include <cmath>
 #include <vector>
 
 #include <arbor/mechanism.hpp>
@@ -30,7 +31,8 @@ void run_test(std::string mech_name,
         std::unordered_map<std::string, fvm_value_type> assigned_variables,
         std::vector<fvm_value_type> t0_values,
         std::vector<fvm_value_type> t1_values,
-        fvm_value_type dt) {
+        fvm_value_type dt,
+        unsigned n_steps = 1) {
 
     auto cat = make_unit_test_catalogue();
 
@@ -79,7 +81,9 @@ void run_test(std::string mech_name,
     shared_state->update_time_to(dt, dt);
     shared_state->set_dt();
 
-    test->update_state();
+    for (unsigned i = 0; i < n_steps; i++) {
+        test->update_state();
+    }
 
     if (!t1_values.empty()) {
         for (unsigned i = 0; i < state_variables.size(); i++) {
@@ -146,6 +150,39 @@ TEST(mech_kinetic, kintetic_nonlinear_scaled) {
     run_test<multicore::backend>("test4_kin_compartment", state_variables, {}, t0_values, t1_values, 0.1);
 }
 
+TEST(mech_derivimplicit, nonlinear) {
+    // One backward Euler step of x' = -x*x, y' = x - y with dt = 0.5
+    // from x = 1, y = 0 gives x + x*x/2 = 1 and y = x/3.
+    std::vector<std::string> state_variables = {"x", "y"};
+    std::vector<fvm_value_type> t0_values = {1, 0};
+    std::vector<fvm_value_type> t1_values = {std::sqrt(3.)-1, (std::sqrt(3.)-1)/3};
+
+    run_test<multicore::backend>("test_derivimplicit", state_variables, {}, t0_values, t1_values, 0.5);
+}
+
+// Backward Euler steps of the stiff system x' = -1000*(x - y*y), y' = -y
+// with dt = 0.01 from x = 0, y = 1 satisfy y[n+1] = y[n]/(1+dt) and
+// x[n+1] = (x[n] + 1000*dt*y[n+1]^2)/(1 + 1000*dt).
+std::vector<fvm_value_type> derivimplicit_stiff_reference(fvm_value_type dt, unsigned n_steps) {
+    fvm_value_type x = 0, y = 1;
+    for (unsigned i = 0; i < n_steps; i++) {
+        y = y/(1+dt);
+        x = (x + 1000*dt*y*y)/(1 + 1000*dt);
+    }
+    return {x, y};
+}
+
+TEST(mech_derivimplicit, stiff) {
+    std::vector<std::string> state_variables = {"x", "y"};
+    std::vector<fvm_value_type> t0_values = {0, 1};
+
+    for (unsigned n_steps: {1u, 2u, 20u}) {
+        SCOPED_TRACE(n_steps);
+        auto t1_values = derivimplicit_stiff_reference(0.01, n_steps);
+        run_test<multicore::backend>("test_derivimplicit_stiff", state_variables, {}, t0_values, t1_values, 0.01, n_steps);
+    }
+}
+
 TEST(mech_linear, linear_system) {
     std::vector<std::string> state_variables = {"h", "s", "d"};
     std::vector<fvm_value_type> values = {0.5, 0.2, 0.3};
@@ -211,6 +248,25 @@ TEST(mech_kinetic_gpu, kintetic_nonlinear_scaled) {
     run_test<gpu::backend>("test4_kin_compartment", state_variables, {}, t0_values, t1_values, 0.1);
 }
 
+TEST(mech_derivimplicit_gpu, nonlinear) {
+    std::vector<std::string> state_variables = {"x", "y"};
+    std::vector<fvm_value_type> t0_values = {1, 0};
+    std::vector<fvm_value_type> t1_values = {std::sqrt(3.)-1, (std::sqrt(3.)-1)/3};
+
+    run_test<gpu::backend>("test_derivimplicit", state_variables, {}, t0_values, t1_values, 0.5);
+}
+
+TEST(mech_derivimplicit_gpu, stiff) {
+    std::vector<std::string> state_variables = {"x", "y"};
+    std::vector<fvm_value_type> t0_values = {0, 1};
+
+    for (unsigned n_steps: {1u, 2u, 20u}) {
+        SCOPED_TRACE(n_steps);
+        auto t1_values = derivimplicit_stiff_reference(0.01, n_steps);
+        run_test<gpu::backend>("test_derivimplicit_stiff", state_variables, {}, t0_values, t1_values, 0.01, n_steps);
+    }
+}
+
 TEST(mech_linear_gpu, linear_system) {
     std::vector<std::string> state_variables = {"h", "s", "d"};
     std::vector<fvm_value_type> values = {0.5, 0.2, 0.3};
@@ -10,6 +10,7 @@
 #include <arbor/simulation.hpp>
 #include <arbor/spike_source_cell.hpp>
 
+#include "epoch.hpp"
 #include "lif_cell_group.hpp"
 
 using namespace arb;
@@ -221,3 +222,28 @@ TEST(lif_cell_group, ring)
     }
 }
 
+
+TEST(lif_cell_group, binning) {
+    // Two events on a single cell, each raising the membrane potential by
+    // half the threshold. Without binning, the potential decays between the
+    // events and the cell does not fire; with binning, both events fall in
+    // the bin [1, 1.5) and are applied together at t=1.
+    path_recipe recipe(1, 100, 0.1);
+    std::vector<pse_vector> lanes = {{{0, 1.3, 100}, {0, 1.4, 100}}};
+    event_lane_subrange ev_lanes(lanes.begin(), lanes.end());
+
+    {
+        cell_label_range srcs, tgts;
+        lif_cell_group group({0}, recipe, srcs, tgts);
+        group.advance(epoch(0, 0, 10), 0.01, ev_lanes);
+        EXPECT_EQ(0u, group.spikes().size());
+    }
+    {
+        cell_label_range srcs, tgts;
+        lif_cell_group group({0}, recipe, srcs, tgts);
+        group.set_binning_policy(binning_kind::regular, 0.5);
+        group.advance(epoch(0, 0, 10), 0.01, ev_lanes);
+        ASSERT_EQ(1u, group.spikes().size());
+        EXPECT_EQ(1.0, group.spikes()[0].time);
+    }
+}
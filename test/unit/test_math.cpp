@@ -1,8 +1,10 @@
 #include <cmath>
 #include <limits>
+#include <random>
 
 #include "../gtest.h"
 
+#include <arbor/fast_math.hpp>
 #include <arbor/math.hpp>
 
 using namespace arb::math;
@@ -377,3 +379,61 @@ TEST(math, exprelr) {
     }
 }
 
+
+// Check the fast approximations at accuracy level L against the C library,
+// with maximum relative error `tol` (scaled by 1+|y·log(x)| for pow).
+
+template <unsigned L>
+void check_fast_math(double tol) {
+    std::minstd_rand rng(1014);
+    std::uniform_real_distribution<double> exp_args(-700, 700), small_args(-2, 2), pow_args(-20, 20);
+
+    auto rel_err = [](double approx, double exact) { return std::abs(approx-exact)/std::abs(exact); };
+
+    for (unsigned i = 0; i<10000; ++i) {
+        double x = i%2? exp_args(rng): small_args(rng);
+        SCOPED_TRACE(x);
+
+        EXPECT_LE(rel_err(fast_exp<L>(x), std::exp(x)), tol);
+        if (x!=0) {
+            EXPECT_LE(rel_err(fast_expm1<L>(x), std::expm1(x)), tol);
+            EXPECT_LE(rel_err(fast_exprelr<L>(x), x/std::expm1(x)), tol);
+        }
+
+        // Also check log near 1, where the result is small.
+        double y = std::exp(x), y1 = 1+small_args(rng)/64;
+        if (y!=1) {
+            EXPECT_LE(rel_err(fast_log<L>(y), std::log(y)), tol);
+        }
+        if (y1!=1) {
+            EXPECT_LE(rel_err(fast_log<L>(y1), std::log(y1)), tol);
+        }
+
+        double z = pow_args(rng), w = std::exp(small_args(rng)*10);
+        EXPECT_LE(rel_err(fast_pow<L>(w, z), std::pow(w, z)), tol*(1+std::abs(z*std::log(w))));
+    }
+
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    constexpr double dmin = std::numeric_limits<double>::min();
+
+    EXPECT_EQ(inf, fast_exp<L>(710.));
+    EXPECT_EQ(0., fast_exp<L>(-710.));
+    EXPECT_EQ(1., fast_exp<L>(0.));
+    EXPECT_TRUE(std::isnan(fast_exp<L>(NAN)));
+    EXPECT_EQ(-1., fast_expm1<L>(-40.));
+    EXPECT_EQ(1., fast_exprelr<L>(0.));
+    EXPECT_EQ(0., fast_log<L>(1.));
+    EXPECT_EQ(-inf, fast_log<L>(0.));
+    EXPECT_EQ(inf, fast_log<L>(inf));
+    EXPECT_TRUE(std::isnan(fast_log<L>(-1.)));
+    EXPECT_EQ(std::log(dmin/4), fast_log<L>(dmin/4));
+    EXPECT_EQ(1., fast_pow<L>(3., 0.));
+    EXPECT_EQ(4., fast_pow<L>(-2., 2.));
+}
+
+TEST(math, fast_math) {
+    constexpr double deps = std::numeric_limits<double>::epsilon();
+
+    check_fast_math<1>(2*deps);
+    check_fast_math<2>(1e-6);
+}
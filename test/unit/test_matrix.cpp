@@ -1,4 +1,5 @@
 #include <numeric>
+#include <random>
 #include <vector>
 
 #include "../gtest.h"
@@ -7,6 +8,9 @@
 
 #include "matrix.hpp"
 #include "backends/multicore/fvm.hpp"
+#include "backends/multicore/matrix_state.hpp"
+#include "backends/multicore/matrix_state_interleaved.hpp"
+#include "util/partition.hpp"
 #include "util/rangeutil.hpp"
 #include "util/span.hpp"
 
@@ -16,9 +20,12 @@ using namespace arb;
 
 using backend     = multicore::backend;
 using array       = backend::array;
-using matrix_type = matrix<backend>;
-using index_type  = matrix_type::index_type;
-using value_type  = matrix_type::value_type;
+using index_type  = backend::index_type;
+using value_type  = backend::value_type;
+
+// Tests below that set the matrix entries directly use the flat storage.
+using matrix_type = matrix<backend, multicore::matrix_state<value_type, index_type>>;
+using matrix_interleaved_type = matrix<backend, multicore::matrix_state_interleaved<value_type, index_type>>;
 
 using vvec = std::vector<value_type>;
 
@@ -185,3 +192,128 @@ TEST(matrix, zero_diagonal_assembled)
     EXPECT_TRUE(testing::seq_almost_eq<double>(expected, x));
 }
 
+
+TEST(matrix, interleaved)
+{
+    // Compare the interleaved solver against the flat solver for a set of
+    // randomly branching cells of different sizes, more than one block's
+    // worth, with a zero dt for some integration domains.
+
+    constexpr index_type width = matrix_interleaved_type::state::width;
+    const index_type n_cell = 3*width+1;
+
+    std::mt19937 gen;
+    std::uniform_int_distribution<index_type> size_dist(1, 40);
+    std::uniform_real_distribution<value_type> dist(1, 2);
+
+    std::vector<index_type> p, c = {0}, intdom;
+    for (index_type i = 0; i<n_cell; ++i) {
+        index_type first = c.back();
+        index_type n = size_dist(gen);
+        p.push_back(-1);
+        for (index_type j = 1; j<n; ++j) {
+            p.push_back(std::uniform_int_distribution<index_type>(first, first+j-1)(gen));
+        }
+        c.push_back(first+n);
+        intdom.push_back(i/2);
+    }
+
+    auto n = c.back();
+    auto random_vec = [&](auto& v) { for (auto& x: v) x = dist(gen); };
+
+    vvec Cm(n), g(n), area(n, 1e3);
+    random_vec(Cm);
+    random_vec(g);
+
+    array dt((n_cell+1)/2);
+    random_vec(dt);
+    dt[1] = 0;
+    dt[3] = 0;
+
+    array v(n), i(n), mg(n);
+    random_vec(v);
+    random_vec(i);
+    random_vec(mg);
+
+    matrix_type flat(p, c, Cm, g, area, intdom);
+    matrix_interleaved_type interleaved(p, c, Cm, g, area, intdom);
+
+    array expected(n), x(n);
+    flat.assemble(dt, v, i, mg);
+    flat.solve(expected);
+    interleaved.assemble(dt, v, i, mg);
+    interleaved.solve(x);
+
+    // Cast to float: the solvers may differ in rounding (contraction to
+    // fused multiply-add) in the last few bits.
+    EXPECT_TRUE(testing::seq_almost_eq<float>(expected, x));
+
+    // Solving for cell ranges that start and end within blocks gives
+    // identical results.
+    expected = x;
+    util::fill(x, 0);
+    std::vector<index_type> cell_divs = {0, 1, width+2, n_cell};
+    for (auto cells: util::partition_view(cell_divs)) {
+        interleaved.assemble(dt, v, i, mg, cells.first, cells.second);
+        interleaved.solve(x, cells.first, cells.second);
+    }
+
+    EXPECT_TRUE(util::equal(expected, x));
+}
+
+TEST(matrix, fine)
+{
+    // Large cells are solved by the branch-parallel fine solver: compare
+    // against the flat solver, and check that the solution does not depend
+    // upon the number of threads.
+
+    using state_type = multicore::matrix_state_interleaved<value_type, index_type>;
+
+    std::mt19937 gen;
+    std::uniform_real_distribution<value_type> dist(1, 2);
+
+    // Cells with randomly branching trees, the large ones with many branches
+    // per level.
+    std::vector<index_type> sizes = {5, 20000, 7, 3, 30000, 1, 12};
+    std::vector<index_type> p, c = {0}, intdom;
+    for (auto n: sizes) {
+        index_type first = c.back();
+        p.push_back(-1);
+        for (index_type j = 1; j<n; ++j) {
+            p.push_back(std::uniform_int_distribution<index_type>(first, first+j-1)(gen));
+        }
+        c.push_back(first+n);
+        intdom.push_back(intdom.size());
+    }
+
+    auto n = c.back();
+    auto random_vec = [&](auto& v) { for (auto& x: v) x = dist(gen); };
+
+    vvec Cm(n), g(n), area(n, 1e3);
+    random_vec(Cm);
+    random_vec(g);
+
+    array dt(sizes.size()), v(n), i(n), mg(n);
+    random_vec(dt);
+    random_vec(v);
+    random_vec(i);
+    random_vec(mg);
+
+    multicore::matrix_state<value_type, index_type> flat(p, c, Cm, g, area, intdom);
+    state_type serial(p, c, Cm, g, area, intdom, 1000);
+    state_type threaded(p, c, Cm, g, area, intdom, 1000);
+    threaded.set_thread_pool(std::make_shared<threading::task_system>(4));
+
+    EXPECT_EQ(2u, serial.fine.size());
+
+    array expected(n), x(n), y(n);
+    flat.assemble(dt, v, i, mg);
+    flat.solve(expected);
+    serial.assemble(dt, v, i, mg);
+    serial.solve(x);
+    threaded.assemble(dt, v, i, mg);
+    threaded.solve(y);
+
+    EXPECT_TRUE(testing::seq_almost_eq<float>(expected, x));
+    EXPECT_TRUE(util::equal(x, y));
+}
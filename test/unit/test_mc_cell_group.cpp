@@ -40,6 +40,11 @@ ACCESS_BIND(
     private_spike_sources_ptr,
     &mc_cell_group::spike_sources_)
 
+ACCESS_BIND(
+    std::vector<deliverable_event> mc_cell_group::*,
+    private_staged_events_ptr,
+    &mc_cell_group::staged_events_)
+
 TEST(mc_cell_group, get_kind) {
     cable_cell cell = make_cell();
     cell_label_range srcs, tgts;
@@ -106,3 +111,58 @@ TEST(mc_cell_group, sources) {
     }
 }
 
+
+TEST(mc_cell_group, aggregate_events) {
+    // One synapse with a NET_RECEIVE linear in the weight (expsyn),
+    // and one without (expsyn_stdp).
+    soma_cell_builder builder(12.6157/2.0);
+    auto d = builder.make_cell();
+    d.decorations.place(mlocation{0, 0.25}, "expsyn", "syn_linear");
+    d.decorations.place(mlocation{0, 0.75}, "expsyn_stdp", "syn_stdp");
+    cable_cell cell(d);
+
+    struct aggregate_recipe: cable1d_recipe {
+        aggregate_recipe(const cable_cell& c, bool aggregate): cable1d_recipe(c, false) {
+            cell_gprop_.aggregate_events = aggregate;
+        }
+    };
+
+    // All events fall in the same bin [1, 1.5).
+    std::vector<pse_vector> lanes = {{
+        {0, 1.0, 0.1f},
+        {1, 1.05, 1.f},
+        {0, 1.1, 0.2f},
+        {1, 1.15, 1.f},
+        {0, 1.2, 0.3f},
+    }};
+    event_lane_subrange ev_lanes(lanes.begin(), lanes.end());
+
+    for (bool aggregate: {false, true}) {
+        cell_label_range srcs, tgts;
+        mc_cell_group group{{0}, aggregate_recipe(cell, aggregate), srcs, tgts, lowered_cell()};
+        group.set_binning_policy(binning_kind::regular, 0.5);
+        group.advance(epoch(0, 0., 5.), 0.025, ev_lanes);
+
+        const auto& staged = group.*private_staged_events_ptr;
+        if (!aggregate) {
+            EXPECT_EQ(5u, staged.size());
+            continue;
+        }
+
+        ASSERT_EQ(3u, staged.size());
+        EXPECT_TRUE(std::is_sorted(staged.begin(), staged.end(),
+            [](auto& a, auto& b) { return a.time<b.time; }));
+
+        float linear_weight = 0;
+        unsigned n_linear = 0;
+        for (auto& ev: staged) {
+            EXPECT_EQ(1.0, ev.time);
+            if (ev.weight!=1.f) {
+                linear_weight += ev.weight;
+                ++n_linear;
+            }
+        }
+        EXPECT_EQ(1u, n_linear);
+        EXPECT_FLOAT_EQ(0.6f, linear_weight);
+    }
+}
@@ -0,0 +1,151 @@
+#include <cmath>
+#include <vector>
+
+#include <arbor/mechanism.hpp>
+
+#include "backends/multicore/fvm.hpp"
+#include "util/span.hpp"
+
+#include "common.hpp"
+#include "mech_private_field_access.hpp"
+#include "unit_test_catalogue.hpp"
+
+using namespace arb;
+
+// Procedure `rates` of table_test is tabulated over [-100, 100] mV in steps of
+// 1 mV, with a = k*exp(v/50) and b = -v for v<0, v^2 otherwise.
+
+TEST(mech_table, rates) {
+    using backend = multicore::backend;
+    auto cat = make_unit_test_catalogue();
+
+    auto a = [](double k, double v) { return k*std::exp(v/50); };
+    auto b = [](double v) { return v<0? -v: v*v; };
+
+    // On grid points, between grid points, and outside of the table: enough
+    // CVs to fill more than one SIMD vector in each case.
+
+    std::vector<fvm_value_type> vinit = {-65, -64.5, 150, -101, 0.25, 3.5, 99.5, -100, 100, -0.5, 64, 10};
+    fvm_size_type ncell = 1;
+    fvm_size_type ncv = vinit.size();
+    std::vector<fvm_index_type> cv_to_intdom(ncv, 0);
+
+    std::vector<fvm_gap_junction> gj = {};
+    auto instance = cat.instance<backend>("table_test");
+    auto& table_test = instance.mech;
+
+    std::vector<fvm_value_type> temp(ncv, 300.);
+    std::vector<fvm_value_type> diam(ncv, 1.);
+    std::vector<fvm_index_type> src_to_spike = {};
+
+    auto shared_state = std::make_unique<typename backend::shared_state>(
+        ncell, ncell, 0, cv_to_intdom, cv_to_intdom, gj, vinit, temp, diam, src_to_spike, table_test->data_alignment());
+
+    mechanism_layout layout;
+    layout.weight.assign(ncv, 1.);
+    for (fvm_size_type i = 0; i<ncv; ++i) {
+        layout.cv.push_back(i);
+    }
+
+    // Tables are rebuilt when the DEPEND global k changes.
+    for (double k: {1., 3.}) {
+        mechanism_overrides overrides;
+        overrides.globals["k"] = k;
+
+        table_test->instantiate(0, *shared_state, overrides, layout);
+        shared_state->reset();
+        table_test->initialize();
+
+        auto a_values = mechanism_field(table_test.get(), "a");
+        auto b_values = mechanism_field(table_test.get(), "b");
+
+        for (auto i: util::make_span(ncv)) {
+            double v = vinit[i];
+            SCOPED_TRACE(v);
+
+            if (v<-100 || v>=100) {
+                EXPECT_DOUBLE_EQ(a(k, v), a_values[i]);
+                EXPECT_DOUBLE_EQ(b(v), b_values[i]);
+            }
+            else {
+                double v0 = std::floor(v), v1 = v0+1;
+                double f = v-v0;
+                EXPECT_DOUBLE_EQ(a(k, v0)+f*(a(k, v1)-a(k, v0)), a_values[i]);
+                EXPECT_DOUBLE_EQ(b(v0)+f*(b(v1)-b(v0)), b_values[i]);
+                EXPECT_NEAR(a(k, v), a_values[i], 1e-4*a(k, v));
+            }
+        }
+    }
+}
+
+// Procedure `rates` of table_celsius_test is tabulated as for table_test, with
+// q = celsius*exp(v/50). The table is used only if the temperature is the same
+// in all CVs, and is rebuilt when the temperature changes.
+
+TEST(mech_table, celsius) {
+    using backend = multicore::backend;
+    auto cat = make_unit_test_catalogue();
+
+    auto q = [](double celsius, double v) { return celsius*std::exp(v/50); };
+
+    std::vector<fvm_value_type> vinit = {-65, -64.5, 150, -101, 0.25, 3.5, 99.5, -100, 100, -0.5, 64, 10};
+    fvm_size_type ncell = 1;
+    fvm_size_type ncv = vinit.size();
+    std::vector<fvm_index_type> cv_to_intdom(ncv, 0);
+
+    std::vector<fvm_gap_junction> gj = {};
+    auto instance = cat.instance<backend>("table_celsius_test");
+    auto& table_test = instance.mech;
+
+    std::vector<fvm_value_type> temp(ncv, 300.);
+    std::vector<fvm_value_type> diam(ncv, 1.);
+    std::vector<fvm_index_type> src_to_spike = {};
+
+    auto shared_state = std::make_unique<typename backend::shared_state>(
+        ncell, ncell, 0, cv_to_intdom, cv_to_intdom, gj, vinit, temp, diam, src_to_spike, table_test->data_alignment());
+
+    mechanism_layout layout;
+    mechanism_overrides overrides;
+    layout.weight.assign(ncv, 1.);
+    for (fvm_size_type i = 0; i<ncv; ++i) {
+        layout.cv.push_back(i);
+    }
+
+    table_test->instantiate(0, *shared_state, overrides, layout);
+    shared_state->reset();
+
+    std::vector<fvm_value_type> varying(ncv);
+    for (auto i: util::make_span(ncv)) {
+        varying[i] = 6.3+i;
+    }
+
+    std::vector<std::vector<fvm_value_type>> temperatures = {
+        std::vector<fvm_value_type>(ncv, 6.3),
+        varying,
+        std::vector<fvm_value_type>(ncv, 37.)
+    };
+
+    for (unsigned k = 0; k<temperatures.size(); ++k) {
+        SCOPED_TRACE(k);
+        bool uniform = k!=1;
+
+        memory::copy(temperatures[k], shared_state->temperature_degC);
+        table_test->initialize();
+
+        auto q_values = mechanism_field(table_test.get(), "q");
+        for (auto i: util::make_span(ncv)) {
+            double v = vinit[i];
+            double celsius = temperatures[k][i];
+            SCOPED_TRACE(v);
+
+            if (!uniform || v<-100 || v>=100) {
+                EXPECT_DOUBLE_EQ(q(celsius, v), q_values[i]);
+            }
+            else {
+                double v0 = std::floor(v), v1 = v0+1;
+                double f = v-v0;
+                EXPECT_DOUBLE_EQ(q(celsius, v0)+f*(q(celsius, v1)-q(celsius, v0)), q_values[i]);
+            }
+        }
+    }
+}
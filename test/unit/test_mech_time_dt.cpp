@@ -0,0 +1,94 @@
+#include <type_traits>
+#include <vector>
+
+#include <arbor/mechanism.hpp>
+
+#include "backends/multicore/fvm.hpp"
+#ifdef ARB_GPU_ENABLED
+#include "backends/gpu/fvm.hpp"
+#endif
+#include "util/span.hpp"
+
+#include "common.hpp"
+#include "mech_private_field_access.hpp"
+#include "unit_test_catalogue.hpp"
+
+using namespace arb;
+
+// Time and dt are read through the CV and integration domain indices, or
+// as scalars in the multicore back end when uniform across integration domains.
+
+template <typename backend>
+void run_time_dt_test() {
+    auto cat = make_unit_test_catalogue();
+
+    // two cells in separate integration domains, two CVs each:
+
+    fvm_size_type ncell = 2;
+    fvm_size_type ncv = 4;
+    std::vector<fvm_index_type> cv_to_intdom = {0, 0, 1, 1};
+
+    std::vector<fvm_gap_junction> gj = {};
+    auto instance = cat.instance<backend>("time_dt_test");
+    auto& time_dt_test = instance.mech;
+
+    std::vector<fvm_value_type> temp(ncv, 300.);
+    std::vector<fvm_value_type> diam(ncv, 1.);
+    std::vector<fvm_value_type> vinit(ncv, -65);
+    std::vector<fvm_index_type> src_to_spike = {};
+
+    mechanism_layout layout;
+    mechanism_overrides overrides;
+
+    layout.weight.assign(ncv, 1.);
+    for (fvm_size_type i = 0; i < ncv; ++i) {
+        layout.cv.push_back(i);
+    }
+
+    auto shared_state = std::make_unique<typename backend::shared_state>(
+            ncell, ncell, 0, cv_to_intdom, cv_to_intdom, gj, vinit, temp, diam, src_to_spike, time_dt_test->data_alignment());
+
+    time_dt_test->instantiate(0, *shared_state, overrides, layout);
+    shared_state->reset();
+    time_dt_test->initialize();
+
+    // same time and dt in both integration domains:
+
+    shared_state->update_time_to(0.025, 1.);
+    shared_state->set_dt();
+    time_dt_test->update_state();
+
+    EXPECT_EQ(std::vector<fvm_value_type>(ncv, 0.), mechanism_field(time_dt_test.get(), "t_seen"));
+    EXPECT_EQ(std::vector<fvm_value_type>(ncv, 0.025), mechanism_field(time_dt_test.get(), "dt_seen"));
+    if constexpr (std::is_same_v<backend, multicore::backend>) {
+        EXPECT_EQ(0.025, shared_state->dt_uniform);
+    }
+
+    // different times and steps in the two integration domains:
+
+    memory::copy(std::vector<fvm_value_type>{0.025, 0.03}, shared_state->time);
+    memory::copy(std::vector<fvm_value_type>{0.05, 0.04}, shared_state->time_to);
+    shared_state->set_dt();
+    time_dt_test->update_state();
+
+    if constexpr (std::is_same_v<backend, multicore::backend>) {
+        EXPECT_EQ(-1, shared_state->dt_uniform);
+    }
+
+    std::vector<fvm_value_type> expected_t = {0.025, 0.025, 0.03, 0.03};
+    std::vector<fvm_value_type> expected_dt = {0.025, 0.025, 0.01, 0.01};
+    EXPECT_EQ(expected_t, mechanism_field(time_dt_test.get(), "t_seen"));
+    for (auto i: util::make_span(ncv)) {
+        EXPECT_DOUBLE_EQ(expected_dt[i], mechanism_field(time_dt_test.get(), "dt_seen")[i]);
+    }
+}
+
+TEST(mech_time_dt, time_dt) {
+    run_time_dt_test<multicore::backend>();
+}
+
+#ifdef ARB_GPU_ENABLED
+TEST(mech_time_dt_gpu, time_dt) {
+    run_time_dt_test<gpu::backend>();
+}
+#endif
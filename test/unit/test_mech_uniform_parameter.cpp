@@ -0,0 +1,97 @@
+#include <vector>
+
+#include <arbor/mechanism.hpp>
+
+#include "backends/multicore/fvm.hpp"
+#include "util/span.hpp"
+
+#include "common.hpp"
+#include "mech_private_field_access.hpp"
+#include "unit_test_catalogue.hpp"
+
+using namespace arb;
+
+// RANGE parameters with the same value on all instances are read as scalars;
+// check that param_as_state copies the parameter exactly as it changes between
+// uniform and non-uniform values.
+
+TEST(mech_uniform_parameter, param_as_state) {
+    using backend = multicore::backend;
+    auto cat = make_unit_test_catalogue();
+
+    fvm_size_type ncell = 1;
+    fvm_size_type ncv = 11;
+    std::vector<fvm_index_type> cv_to_intdom(ncv, 0);
+
+    std::vector<fvm_gap_junction> gj = {};
+    auto instance = cat.instance<backend>("param_as_state");
+    auto& mech = instance.mech;
+
+    std::vector<fvm_value_type> temp(ncv, 300.);
+    std::vector<fvm_value_type> diam(ncv, 1.);
+    std::vector<fvm_value_type> vinit(ncv, -65);
+    std::vector<fvm_index_type> src_to_spike = {};
+
+    auto shared_state = std::make_unique<typename backend::shared_state>(
+        ncell, ncell, 0, cv_to_intdom, cv_to_intdom, gj, vinit, temp, diam, src_to_spike, mech->data_alignment());
+
+    mechanism_layout layout;
+    mechanism_overrides overrides;
+
+    layout.weight.assign(ncv, 1.);
+    for (fvm_size_type i = 0; i<ncv; ++i) {
+        layout.cv.push_back(i);
+    }
+
+    mech->instantiate(0, *shared_state, overrides, layout);
+    shared_state->reset();
+
+    std::vector<fvm_value_type> varying(ncv);
+    for (auto i: util::make_span(ncv)) {
+        varying[i] = 0.5*i;
+    }
+
+    std::vector<std::vector<fvm_value_type>> params = {
+        std::vector<fvm_value_type>(ncv, 1.), // default
+        varying,
+        std::vector<fvm_value_type>(ncv, 5.),
+        varying
+    };
+
+    for (unsigned k = 0; k<params.size(); ++k) {
+        SCOPED_TRACE(k);
+        if (k>0) {
+            mech->set_parameter("p", params[k]);
+        }
+        mech->initialize();
+
+        auto s = mechanism_field(mech.get(), "s");
+        for (auto i: util::make_span(ncv)) {
+            EXPECT_EQ(params[k][i], s[i]);
+        }
+    }
+}
+
+// A mechanism without instances has no parameter values to compare.
+
+TEST(mech_uniform_parameter, no_instances) {
+    using backend = multicore::backend;
+    auto cat = make_unit_test_catalogue();
+
+    std::vector<fvm_index_type> cv_to_intdom(1, 0);
+    std::vector<fvm_gap_junction> gj = {};
+    auto instance = cat.instance<backend>("param_as_state");
+    auto& mech = instance.mech;
+
+    std::vector<fvm_value_type> temp(1, 300.);
+    std::vector<fvm_value_type> diam(1, 1.);
+    std::vector<fvm_value_type> vinit(1, -65);
+    std::vector<fvm_index_type> src_to_spike = {};
+
+    auto shared_state = std::make_unique<typename backend::shared_state>(
+        1, 1, 0, cv_to_intdom, cv_to_intdom, gj, vinit, temp, diam, src_to_spike, mech->data_alignment());
+
+    mech->instantiate(0, *shared_state, mechanism_overrides{}, mechanism_layout{});
+    EXPECT_EQ(0u, mech->size());
+    mech->set_parameter("p", {});
+}
@@ -280,3 +280,49 @@ TEST(merge_events, tourney_poisson)
     EXPECT_TRUE(std::is_sorted(lf.begin(), lf.end()));
     EXPECT_EQ(lf, expected);
 }
+
+// Test the tournament tree and the two- and three-way merge paths on lanes
+// with events that share time and target, but differ in weight.
+TEST(merge_events, tree_merge_ties)
+{
+    std::vector<pse_vector> lanes = {
+        {{0, 1, 2}, {1, 1, 1}, {0, 2, 1}, {0, 3, 3}},
+        {{0, 1, 1}, {0, 2, 2}, {2, 2, 1}},
+        {{0, 1, 3}, {1, 1, 0}, {0, 2, 1}, {0, 4, 1}, {0, 5, 1}},
+        {},
+        {{1, 1, 1}, {0, 3, 2}},
+        {{0, 0.5, 1}},
+    };
+
+    for (auto n: {1u, 2u, 3u, 4u, 5u, 6u}) {
+        pse_vector expected;
+        std::vector<event_span> spans;
+        for (auto i=0u; i<n; ++i) {
+            util::append(expected, lanes[i]);
+            spans.push_back(util::range_pointer_view(lanes[i]));
+        }
+        util::sort(expected);
+
+        pse_vector lf;
+        tree_merge_events(spans, lf);
+
+        EXPECT_TRUE(std::is_sorted(lf.begin(), lf.end()));
+        EXPECT_EQ(expected, lf);
+
+        // Empty lanes are skipped, not removed from the caller's sources.
+        EXPECT_EQ(n, spans.size());
+
+        // Exercise the tournament tree directly, irrespective of lane count.
+        spans.clear();
+        for (auto i=0u; i<n; ++i) {
+            spans.push_back(util::range_pointer_view(lanes[i]));
+        }
+        impl::tourney_tree tree(spans);
+        lf.clear();
+        while (!tree.empty()) {
+            lf.push_back(tree.head());
+            tree.pop();
+        }
+        EXPECT_EQ(expected, lf);
+    }
+}
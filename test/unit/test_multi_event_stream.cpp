@@ -210,3 +210,65 @@ TEST(multi_event_stream, time_if_before) {
 	}
     }
 }
+
+TEST(multi_event_stream, partition_by_key) {
+    using multi_event_stream = multicore::multi_event_stream<deliverable_event>;
+
+    // Partition events by mechanism id.
+    multi_event_stream m(n_cell, mech_2+1);
+    ASSERT_EQ(n_cell, m.n_streams());
+    ASSERT_EQ(mech_2+1, m.n_keys());
+
+    // Add an event with a key out of range on cell_1 at t=1: it is never
+    // delivered, but bounds the integration times as any other.
+    auto events = common_events;
+    events.insert(events.begin()+1, deliverable_event(1.f, target_handle(-1, 0u, cell_1), 0.f));
+    m.init(events);
+
+    // The earliest event on each cell over all keys restricts t.
+    std::vector<double> t(n_cell, 10.);
+    m.event_time_if_before(t);
+
+    for (unsigned i = 0; i<n_cell; ++i) {
+        EXPECT_EQ(i==cell_1? 1.: i==cell_3? 3.: i==cell_2? 2.: 10., t[i]);
+    }
+
+    // Marked events for each key comprise only those of that key.
+    auto marked_handles = [&m](cell_local_size_type key, unsigned i) {
+        std::vector<cell_local_size_type> indices;
+        auto marked = m.marked_events(key);
+        for (auto p = marked.begin_marked(i); p<marked.end_marked(i); ++p) {
+            EXPECT_EQ(key, p->mech_id);
+            indices.push_back(p->mech_index);
+        }
+        return indices;
+    };
+
+    std::vector<time_type> t_until(n_cell, 2.5);
+    m.mark_until_after(t_until);
+
+    for (cell_local_size_type key = 0; key<m.n_keys(); ++key) {
+        for (unsigned i = 0; i<n_cell; ++i) {
+            using v = std::vector<cell_local_size_type>;
+            EXPECT_EQ(key==mech_2 && i==cell_2? v{1u}: v{}, marked_handles(key, i));
+        }
+    }
+
+    m.drop_marked_events();
+    t_until.assign(n_cell, 5.);
+    m.mark_until_after(t_until);
+
+    for (cell_local_size_type key = 0; key<m.n_keys(); ++key) {
+        for (unsigned i = 0; i<n_cell; ++i) {
+            using v = std::vector<cell_local_size_type>;
+            v expected;
+            if (key==mech_1 && i==cell_1) expected = {0u};
+            if (key==mech_1 && i==cell_2) expected = {4u};
+            if (key==mech_2 && i==cell_3) expected = {2u};
+            EXPECT_EQ(expected, marked_handles(key, i));
+        }
+    }
+
+    m.drop_marked_events();
+    EXPECT_TRUE(m.empty());
+}
@@ -0,0 +1,175 @@
+#include "../gtest.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <arbor/profile/profiler.hpp>
+#include <arbor/version.hpp>
+
+#include "hardware/perf_counters.hpp"
+#include "profile/recorder.hpp"
+
+using namespace arb;
+
+namespace {
+    // Loop with one floating point multiply-add per iteration, which the
+    // compiler can not remove.
+    double work(unsigned n) {
+        volatile double x = 1;
+        for (unsigned i = 0; i<n; ++i) {
+            x = x*1.000001+1e-9;
+        }
+        return x;
+    }
+}
+
+TEST(perf_counters, counts) {
+    hw::perf_counts a, b;
+    a.cycles = 10;
+    a.instructions = 20;
+    a.llc_misses = 30;
+    a.fp_ops = 40;
+    b.cycles = 1;
+    b.instructions = 2;
+    b.llc_misses = 3;
+    b.fp_ops = 4;
+
+    auto d = a-b;
+    EXPECT_EQ(9u, d.cycles);
+    EXPECT_EQ(18u, d.instructions);
+    EXPECT_EQ(27u, d.llc_misses);
+    EXPECT_EQ(36u, d.fp_ops);
+
+    d += b;
+    EXPECT_EQ(a.cycles, d.cycles);
+    EXPECT_EQ(a.instructions, d.instructions);
+    EXPECT_EQ(a.llc_misses, d.llc_misses);
+    EXPECT_EQ(a.fp_ops, d.fp_ops);
+}
+
+TEST(perf_counters, scale_count) {
+    // Counts of a group that ran all the time it was enabled, or never ran,
+    // are not scaled.
+    EXPECT_EQ(100u, hw::scale_count(100, 10, 10));
+    EXPECT_EQ(0u, hw::scale_count(0, 10, 0));
+
+    // A group that ran for a quarter of the time counted a quarter of the events.
+    EXPECT_EQ(400u, hw::scale_count(100, 40, 10));
+}
+
+TEST(perf_counters, group) {
+    hw::perf_counter_group group;
+
+    // Counters that can not be opened read as zero.
+    if (!group.available()) {
+        EXPECT_FALSE(group.has_fp_ops());
+        auto c = group.read();
+        EXPECT_EQ(0u, c.cycles);
+        EXPECT_EQ(0u, c.instructions);
+        EXPECT_EQ(0u, c.llc_misses);
+        EXPECT_EQ(0u, c.fp_ops);
+        return;
+    }
+
+    const unsigned n = 1000000;
+    auto c0 = group.read();
+    work(n);
+    auto c1 = group.read();
+
+    // The counts are cumulative, and count at least one instruction for each
+    // loop iteration.
+    EXPECT_GT(c1.cycles, c0.cycles);
+    EXPECT_GE(c1.instructions-c0.instructions, n);
+    EXPECT_GE(c1.llc_misses, c0.llc_misses);
+    if (group.has_fp_ops()) {
+        EXPECT_GE(c1.fp_ops-c0.fp_ops, n);
+    }
+    else {
+        EXPECT_EQ(0u, c1.fp_ops);
+    }
+}
+
+#ifdef ARB_PROFILE_ENABLED
+TEST(perf_counters, recorder) {
+    const unsigned n = 1000000;
+    profile::recorder r;
+
+    EXPECT_THROW(r.leave(), std::runtime_error);
+
+    // Each leave adds one call and the time and counts since the matching
+    // enter to the region.
+    r.enter(1);
+    work(n);
+    r.leave();
+    auto first = r.accumulators().at(1);
+
+    r.enter(0);
+    EXPECT_THROW(r.enter(1), std::runtime_error);
+    r.leave();
+
+    r.enter(1);
+    work(n);
+    r.leave();
+
+    auto& acc = r.accumulators();
+    ASSERT_EQ(2u, acc.size());
+    EXPECT_EQ(1u, acc[0].count);
+    EXPECT_EQ(1u, first.count);
+    EXPECT_EQ(2u, acc[1].count);
+    EXPECT_GT(first.time, 0.);
+    EXPECT_GT(acc[1].time, first.time);
+
+    if (r.has_counters()) {
+        EXPECT_GE(first.counts.instructions, n);
+        EXPECT_GE(acc[1].counts.instructions, first.counts.instructions+n);
+        EXPECT_LT(acc[0].counts.instructions, n);
+    }
+    else {
+        EXPECT_EQ(0u, acc[1].counts.cycles);
+        EXPECT_EQ(0u, acc[1].counts.instructions);
+    }
+
+    r.clear();
+    EXPECT_TRUE(r.accumulators().empty());
+}
+
+TEST(perf_counters, profile_columns) {
+    const auto npos = std::string::npos;
+
+    profile::profile p;
+    p.names = {"a_b"};
+    p.counts = {1};
+    p.times = {0.5};
+    p.num_threads = 1;
+    p.wall_time = 1;
+
+    auto print = [](const profile::profile& p) {
+        std::stringstream out;
+        out << p;
+        return out.str();
+    };
+
+    // Without counts, there are no counter columns.
+    auto text = print(p);
+    EXPECT_EQ(npos, text.find("IPC"));
+    EXPECT_EQ(npos, text.find("GB/s"));
+    EXPECT_EQ(npos, text.find("GFP/s"));
+
+    // IPC 2; 10^6 misses of 64 bytes in 0.5 s is 0.128 GB/s.
+    p.cycles = {1000};
+    p.instructions = {2000};
+    p.llc_misses = {1000000};
+    text = print(p);
+    EXPECT_NE(npos, text.find("IPC"));
+    EXPECT_NE(npos, text.find("GB/s"));
+    EXPECT_EQ(npos, text.find("GFP/s"));
+    EXPECT_NE(npos, text.find("    2.00    0.13\n"));
+
+    // 5x10^8 floating point instructions in 0.5 s is 1 GFP/s.
+    p.fp_ops = {500000000};
+    text = print(p);
+    EXPECT_NE(npos, text.find("GFP/s"));
+    EXPECT_NE(npos, text.find("    2.00    0.13    1.00\n"));
+}
+#endif
@@ -19,6 +19,7 @@
 #include <arbor/util/pp_util.hpp>
 #include <arbor/version.hpp>
 #include <arborenv/gpu_env.hpp>
+#include <arborio/label_parse.hpp>
 
 #include "backends/event.hpp"
 #include "backends/multicore/fvm.hpp"
@@ -39,6 +40,7 @@
 #include "../simple_recipes.hpp"
 
 using namespace arb;
+using namespace arborio::literals;
 using util::any_cast;
 
 using multicore_fvm_cell = fvm_lowered_cell_impl<multicore::backend>;
@@ -1385,3 +1387,185 @@ TEST(probe, get_probe_metadata) {
     EXPECT_EQ((mlocation{2, 1.}), locs[1]);
     EXPECT_EQ((mlocation{5, 1.}), locs[2]);
 }
+
+// Test sample sinks against sampler output, with a ring buffer smaller than
+// the number of samples taken in a run.
+
+TEST(probe, sample_sink) {
+    auto m = common_morphology::m_mlt_b6;
+    decor d;
+    d.place(mlocation{0, 0}, i_clamp(0.3), "clamp");
+    d.paint(reg::all(), "hh");
+
+    cable1d_recipe rec(cable_cell{m, {}, d}, false);
+    rec.add_probe(0, 0, cable_probe_membrane_voltage{mlocation{1, 0.5}});
+    rec.add_probe(0, 1, cable_probe_total_current_cell{});
+
+    context ctx = make_context();
+    simulation sim(rec, partition_load_balance(rec, ctx), ctx);
+
+    schedule sched = regular_schedule(0.1);
+
+    trace_vector<double> v_trace;
+    trace_vector<std::vector<double>, mcable_list> i_trace;
+    sim.add_sampler(one_probe({0, 0}), sched, make_simple_sampler(v_trace));
+    sim.add_sampler(one_probe({0, 1}), sched, make_simple_sampler(i_trace));
+
+    const std::size_t capacity = 4;
+    const std::size_t n_cable = any_cast<const mcable_list*>(sim.get_probe_metadata({0, 1}).at(0).meta)->size();
+
+    struct sink_data {
+        std::vector<time_type> times;
+        std::vector<double> values;
+        std::vector<time_type> committed_times;
+        std::vector<std::vector<double>> committed_values;
+    };
+
+    auto make_sink = [&](sink_data& s, std::size_t width) {
+        s.times.resize(capacity);
+        s.values.resize(capacity*width);
+        return sample_ring_buffer{s.times.data(), s.values.data(), width, capacity};
+    };
+
+    auto make_commit = [&](sink_data& s) {
+        return [&s](probe_metadata, const sample_ring_buffer& ring, std::size_t first, std::size_t count) {
+            EXPECT_LE(count, ring.capacity);
+            for (std::size_t i = 0; i<count; ++i) {
+                std::size_t row = (first+i)%ring.capacity;
+                s.committed_times.push_back(ring.times[row]);
+                s.committed_values.push_back(std::vector<double>(ring.values+row*ring.width, ring.values+(row+1)*ring.width));
+            }
+        };
+    };
+
+    sink_data v_sink, i_sink;
+    EXPECT_THROW(sim.add_sample_sink({0, 0}, 0, sched, make_sink(v_sink, 2), make_commit(v_sink)), bad_sample_sink);
+    EXPECT_THROW(sim.add_sample_sink({0, 1}, 0, sched, make_sink(i_sink, n_cable+1), make_commit(i_sink)), bad_sample_sink);
+
+    sim.add_sample_sink({0, 0}, 0, sched, make_sink(v_sink, 1), make_commit(v_sink));
+    sim.add_sample_sink({0, 1}, 0, sched, make_sink(i_sink, n_cable), make_commit(i_sink));
+
+    // Two runs: samples retained across calls wrap around the ring buffer.
+    sim.run(0.25, 0.025);
+    sim.run(1.0, 0.025);
+
+    ASSERT_EQ(1u, v_trace.size());
+    ASSERT_EQ(1u, i_trace.size());
+    const auto& v_samples = v_trace[0];
+    const auto& i_samples = i_trace[0];
+
+    ASSERT_EQ(10u, v_samples.size());
+    ASSERT_EQ(10u, i_samples.size());
+
+    // First run retains all 3 samples; second run retains the last 4 of 7.
+    std::vector<unsigned> retained = {0, 1, 2, 6, 7, 8, 9};
+
+    ASSERT_EQ(retained.size(), v_sink.committed_times.size());
+    ASSERT_EQ(retained.size(), i_sink.committed_times.size());
+
+    for (auto j: util::count_along(retained)) {
+        unsigned k = retained[j];
+        EXPECT_EQ(v_samples[k].t, v_sink.committed_times[j]);
+        ASSERT_EQ(1u, v_sink.committed_values[j].size());
+        EXPECT_EQ(v_samples[k].v, v_sink.committed_values[j][0]);
+
+        EXPECT_EQ(i_samples[k].t, i_sink.committed_times[j]);
+        EXPECT_EQ(i_samples[k].v, i_sink.committed_values[j]);
+    }
+}
+
+// A sink may be removed by its own commit callback: the removal takes effect
+// from the next run, and the sink being written to stays valid.
+
+TEST(probe, sample_sink_remove_in_commit) {
+    auto m = common_morphology::m_mlt_b6;
+    decor d;
+    d.paint(reg::all(), "pas");
+
+    cable1d_recipe rec(cable_cell{m, {}, d}, false);
+    rec.add_probe(0, 0, cable_probe_membrane_voltage{mlocation{1, 0.5}});
+
+    context ctx = make_context();
+    simulation sim(rec, partition_load_balance(rec, ctx), ctx);
+
+    std::vector<time_type> times(4);
+    std::vector<double> values(4);
+    std::vector<std::size_t> counts;
+    sampler_association_handle h;
+
+    h = sim.add_sample_sink({0, 0}, 0, regular_schedule(0.1),
+        sample_ring_buffer{times.data(), values.data(), 1, times.size()},
+        [&](probe_metadata, const sample_ring_buffer&, std::size_t, std::size_t count) {
+            counts.push_back(count);
+            sim.remove_sampler(h);
+        });
+
+    sim.run(0.25, 0.025);
+    sim.run(0.5, 0.025);
+
+    ASSERT_EQ(1u, counts.size());
+    EXPECT_EQ(3u, counts[0]);
+}
+
+// The unit test catalogue mechanisms hh_single and expsyn_single are the
+// default hh and expsyn, with state variables stored in single precision.
+// Compare sampled voltage and state against the double precision originals.
+
+TEST(probe, single_precision_state) {
+    context ctx = make_context();
+
+    auto run = [&](const std::string& suffix) {
+        soma_cell_builder builder(12.6157/2.0);
+        builder.add_branch(0, 200, 1.0/2, 1.0/2, 4, "dend");
+        auto desc = builder.make_cell();
+        desc.decorations.paint("soma"_lab, "hh"+suffix);
+        desc.decorations.paint("dend"_lab, "pas");
+        desc.decorations.place(builder.location({1, 0.5}), "expsyn"+suffix, "syn");
+
+        auto soma = builder.location({0, 0.5});
+        cable1d_recipe rec(cable_cell{desc});
+        rec.catalogue() = make_unit_test_catalogue(global_default_catalogue());
+        rec.add_probe(0, 0, cable_probe_membrane_voltage{soma});
+        rec.add_probe(0, 0, cable_probe_density_state{soma, "hh"+suffix, "m"});
+        rec.add_probe(0, 0, cable_probe_point_state{0u, "expsyn"+suffix, "g"});
+
+        multicore_fvm_cell lcell(*ctx);
+        auto fvm_info = lcell.initialize({0}, rec);
+
+        const unsigned n_probe = 3;
+        std::vector<sample_event> samples;
+        for (unsigned i = 0; i<80; ++i) {
+            for (unsigned p = 0; p<n_probe; ++p) {
+                probe_handle h = fvm_info.probe_map.data_on({0, p}).front().raw_handle_range()[0];
+                samples.push_back(sample_event{0.25*i, 0, {h, sample_size_type(n_probe*i+p)}});
+            }
+        }
+
+        auto target = fvm_info.target_handles[0];
+        std::vector<deliverable_event> events = {{1.0, target, 0.05}, {8.0, target, 0.05}};
+
+        auto result = lcell.integrate(20, 0.025, events, samples);
+        return std::vector<double>(result.sample_value.begin(), result.sample_value.end());
+    };
+
+    auto trace = run("");
+    auto trace_single = run("_single");
+
+    ASSERT_EQ(trace.size(), trace_single.size());
+    for (auto i: util::count_along(trace)) {
+        EXPECT_NEAR(trace[i], trace_single[i], 1e-3);
+    }
+
+    // Samples of single precision state are exactly representable as float
+    // (SIMD kernels keep state in double precision), and the voltage trace
+    // includes a spike.
+    double v_max = trace[0];
+    for (unsigned i = 0; i<trace_single.size(); i += 3) {
+#ifndef ARB_VECTORIZE_ENABLED
+        EXPECT_EQ(trace_single[i+1], double(float(trace_single[i+1])));
+        EXPECT_EQ(trace_single[i+2], double(float(trace_single[i+2])));
+#endif
+        v_max = std::max(v_max, trace[i]);
+    }
+    EXPECT_GT(v_max, 0.);
+}
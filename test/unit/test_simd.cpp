@@ -5,6 +5,7 @@
 #include <random>
 #include <unordered_set>
 
+#include <arbor/fast_math.hpp>
 #include <arbor/simd/avx.hpp>
 #include <arbor/simd/neon.hpp>
 #include <arbor/simd/sve.hpp>
@@ -499,7 +500,11 @@ TYPED_TEST_P(simd_value, mask_unpack) {
         for (unsigned j = 0; j<N; ++j) {
             EXPECT_EQ((bool)(packed&(1ull<<j)), b[j]);
         }
+        EXPECT_EQ(packed!=0, mask::unpack(packed).any());
     }
+
+    EXPECT_FALSE(mask(false).any());
+    EXPECT_TRUE(mask::unpack(1ull<<(N-1)).any());
 }
 
 TYPED_TEST_P(simd_value, maths) {
@@ -866,7 +871,73 @@ TYPED_TEST_P(simd_fp_value, log_special_values) {
     }
 }
 
-REGISTER_TYPED_TEST_CASE_P(simd_fp_value, fp_maths, exp_special_values, expm1_special_values, log_special_values);
+// Fast approximations should agree with the scalar implementations in
+// arbor/fast_math.hpp up to rounding, and propagate special values alike.
+
+template <unsigned L, typename simd>
+void check_simd_fast_maths() {
+    using fp = typename simd::scalar_type;
+    constexpr unsigned N = simd::width;
+
+    using limits = std::numeric_limits<fp>;
+    constexpr fp inf = limits::infinity();
+    constexpr fp qnan = limits::quiet_NaN();
+    const fp exp_max_arg = limits::max_exponent*std::log(2.);
+
+    // Relative tolerance: about one rounding in the polynomial evaluation,
+    // amplified by |y·log(x)| for pow.
+    const fp tol = 8*limits::epsilon();
+
+    // The AVX2 and AVX512 logarithms use a different reduction from the
+    // scalar one, and agree with it only to the accuracy of level 2.
+    const fp log_scale = L==1? 1: 5e-8/tol;
+
+    auto near = [tol](fp expected, fp value, fp scale = 1) {
+        return (std::isnan(expected) && std::isnan(value)) || expected==value ||
+               std::abs(expected-value)<=tol*scale*std::abs(expected);
+    };
+
+    std::minstd_rand rng(1014);
+    for (unsigned i = 0; i<nrounds; ++i) {
+        fp u[N], v[N], w[N], r[N];
+
+        fill_random(u, rng, -exp_max_arg, exp_max_arg);
+        fill_random(v, rng, fp(0), fp(10));
+        fill_random(w, rng, fp(-10), fp(10));
+        if (i==0) {
+            fp specials[] = {0, qnan, inf, -inf};
+            for (unsigned j = 0; j<N && j<4; ++j) {
+                u[j] = specials[j];
+                v[j] = -specials[j];
+            }
+        }
+
+        fast_exp<L>(simd(u)).copy_to(r);
+        for (unsigned j = 0; j<N; ++j) EXPECT_TRUE(near(arb::math::fast_exp<L>(u[j]), r[j]));
+
+        fast_expm1<L>(simd(u)).copy_to(r);
+        for (unsigned j = 0; j<N; ++j) EXPECT_TRUE(near(arb::math::fast_expm1<L>(u[j]), r[j]));
+
+        fast_exprelr<L>(simd(w)).copy_to(r);
+        for (unsigned j = 0; j<N; ++j) EXPECT_TRUE(near(arb::math::fast_exprelr<L>(w[j]), r[j]));
+
+        fast_log<L>(simd(v)).copy_to(r);
+        for (unsigned j = 0; j<N; ++j) EXPECT_TRUE(near(arb::math::fast_log<L>(v[j]), r[j], log_scale));
+
+        fast_pow<L>(simd(v), simd(w)).copy_to(r);
+        for (unsigned j = 0; j<N; ++j) {
+            fp scale = log_scale*(1+std::abs(w[j]*std::log(v[j])));
+            EXPECT_TRUE(near(arb::math::fast_pow<L>(v[j], w[j]), r[j], scale));
+        }
+    }
+}
+
+TYPED_TEST_P(simd_fp_value, fast_maths) {
+    check_simd_fast_maths<1, TypeParam>();
+    check_simd_fast_maths<2, TypeParam>();
+}
+
+REGISTER_TYPED_TEST_CASE_P(simd_fp_value, fp_maths, exp_special_values, expm1_special_values, log_special_values, fast_maths);
 
 typedef ::testing::Types<
 
@@ -1,10 +1,12 @@
 #include "../gtest.h"
 
 #include <random>
+#include <sstream>
 #include <vector>
 #include <any>
 
 #include <arbor/cable_cell.hpp>
+#include <arbor/arbexcept.hpp>
 #include <arbor/common_types.hpp>
 #include <arbor/context.hpp>
 #include <arbor/domain_decomposition.hpp>
@@ -18,6 +20,7 @@
 #include "util/transform.hpp"
 
 #include "common.hpp"
+#include "common_cells.hpp"
 using namespace arb;
 
 struct play_spikes: public recipe {
@@ -190,3 +193,133 @@ TEST(simulation, restart) {
         }
     }
 }
+
+// A ring of cable cells driven by an event generator, with a
+// spike source driving a LIF cell that feeds back into the ring.
+
+struct checkpoint_recipe: public recipe {
+    explicit checkpoint_recipe(unsigned n_cable): n_(n_cable) {
+        properties_.default_parameters = neuron_parameter_defaults;
+    }
+
+    cell_size_type num_cells() const override { return n_+2; }
+
+    cell_kind get_cell_kind(cell_gid_type gid) const override {
+        return gid<n_? cell_kind::cable: gid==n_? cell_kind::spike_source: cell_kind::lif;
+    }
+
+    util::unique_any get_cell_description(cell_gid_type gid) const override {
+        if (gid<n_) {
+            auto d = make_cell_ball_and_stick(false);
+            d.decorations.place(mlocation{0, 0.02}, threshold_detector{-10}, "src");
+            d.decorations.place(mlocation{0, 0.8}, "expsyn", "tgt");
+            return cable_cell(d);
+        }
+        else if (gid==n_) {
+            return spike_source_cell("src", regular_schedule(1., 3.));
+        }
+        else {
+            lif_cell lif("src", "tgt");
+            lif.tau_m = 0.01;
+            lif.t_ref = 0;
+            lif.V_th = lif.E_L + 0.001;
+            return lif;
+        }
+    }
+
+    std::vector<cell_connection> connections_on(cell_gid_type gid) const override {
+        if (gid<n_) {
+            std::vector<cell_connection> conns = {cell_connection({(gid+n_-1)%n_, "src"}, {"tgt"}, 0.1, 2.)};
+            if (gid==1) conns.push_back(cell_connection({n_+1, "src"}, {"tgt"}, 0.01, 1.5));
+            return conns;
+        }
+        else if (gid==n_+1) {
+            return {cell_connection({n_, "src"}, {"tgt"}, 1., 1.)};
+        }
+        return {};
+    }
+
+    std::vector<event_generator> event_generators(cell_gid_type gid) const override {
+        if (gid==0) return {poisson_generator({"tgt"}, 0.1, 0., 0.2, std::minstd_rand(17))};
+        return {};
+    }
+
+    std::any get_global_properties(cell_kind) const override { return properties_; }
+
+    unsigned n_;
+    cable_cell_global_properties properties_;
+};
+
+TEST(simulation, checkpoint_restore) {
+    checkpoint_recipe rec(4);
+    auto ctx = n_thread_context(2);
+    auto decomp = partition_load_balance(rec, ctx);
+
+    auto spike_lt = [](spike a, spike b) { return a.time<b.time || (a.time==b.time && a.source<b.source); };
+    auto collect = [](simulation& sim, std::vector<spike>& spikes) {
+        sim.set_global_spike_callback([&spikes](const std::vector<spike>& s) {
+            spikes.insert(spikes.end(), s.begin(), s.end());
+        });
+    };
+
+    constexpr double dt = 0.025;
+    double t_checkpoint = 17.3;
+    double t_final = 40;
+
+    // Reference: checkpoint part way through, then continue.
+
+    simulation sim(rec, decomp, ctx);
+    sim.run(t_checkpoint, dt);
+
+    std::stringstream saved;
+    sim.checkpoint(saved);
+    const std::string data = saved.str();
+
+    std::vector<spike> expected;
+    collect(sim, expected);
+    sim.run(t_final, dt);
+    std::sort(expected.begin(), expected.end(), spike_lt);
+
+    // Spikes are expected from every kind of cell after the checkpoint.
+    ASSERT_FALSE(expected.empty());
+    for (cell_kind kind: {cell_kind::cable, cell_kind::spike_source, cell_kind::lif}) {
+        EXPECT_TRUE(std::any_of(expected.begin(), expected.end(), [&](auto& s) { return rec.get_cell_kind(s.source.gid)==kind; }));
+    }
+
+    // Restore into a new simulation, and into one that has already been run,
+    // and compare the subsequent spikes.
+
+    simulation fresh(rec, decomp, ctx);
+    simulation used(rec, decomp, ctx);
+    used.run(t_final, dt);
+
+    for (simulation* s: {&fresh, &used}) {
+        std::istringstream in(data);
+        s->restore(in);
+
+        std::vector<spike> collected;
+        collect(*s, collected);
+        EXPECT_EQ(t_final, s->run(t_final, dt));
+        std::sort(collected.begin(), collected.end(), spike_lt);
+
+        ASSERT_EQ(expected.size(), collected.size());
+        for (unsigned i = 0; i<expected.size(); ++i) {
+            EXPECT_EQ(expected[i].source, collected[i].source);
+            EXPECT_EQ(expected[i].time, collected[i].time);
+        }
+        EXPECT_EQ(sim.num_spikes(), s->num_spikes());
+    }
+
+    // Truncated checkpoints and checkpoints of a different model are rejected.
+
+    {
+        std::istringstream in(data.substr(0, data.size()/2));
+        EXPECT_THROW(fresh.restore(in), bad_checkpoint);
+    }
+    {
+        checkpoint_recipe other(5);
+        simulation sim_other(other, partition_load_balance(other, ctx), ctx);
+        std::istringstream in(data);
+        EXPECT_THROW(sim_other.restore(in), bad_checkpoint);
+    }
+}
@@ -204,6 +204,75 @@ TEST(SPIKES_TEST_CLASS, threshold_watcher) {
     EXPECT_FALSE(watch.is_crossed(2));
 }
 
+TEST(SPIKES_TEST_CLASS, threshold_watcher_many) {
+    using value_type = backend::value_type;
+    using index_type = backend::index_type;
+    using array = backend::array;
+    using iarray = backend::iarray;
+
+    // Enough detectors to cover both whole SIMD blocks and a remainder, each
+    // on its own CV and cell, with the odd numbered detectors crossing.
+    execution_context context;
+    const index_type n = 19;
+
+    std::vector<index_type> index(n);
+    std::vector<value_type> thresh(n, 1.);
+    std::vector<index_type> src_to_spike_vec(n);
+    for (index_type i = 0; i<n; ++i) {
+        index[i] = i;
+        src_to_spike_vec[i] = n-1-i;
+    }
+
+    array values(n, 0.);
+    iarray cell_index(n);
+    iarray src_to_spike(n);
+    memory::copy(index, cell_index);
+    memory::copy(src_to_spike_vec, src_to_spike);
+
+    array time_before(n, 0.);
+    array time_after(n, 1.);
+    array time_since_spike(n, -1.0);
+
+    backend::threshold_watcher watch(cell_index.data(), values.data(), src_to_spike.data(),
+                                     &time_before, &time_after, index, thresh, context);
+
+    std::vector<value_type> v(n, 0.);
+    for (index_type i = 1; i<n; i += 2) v[i] = 3.;
+    memory::copy(v, values);
+    watch.test(&time_since_spike);
+
+    auto crossings = watch.crossings();
+    util::sort_by(crossings, [](const threshold_crossing& c) { return c.index; });
+    ASSERT_EQ(unsigned(n/2), crossings.size());
+
+    std::vector<value_type> tss(n);
+    memory::copy(time_since_spike, tss);
+    for (index_type i = 0; i<n; ++i) {
+        EXPECT_EQ(i%2==1, watch.is_crossed(i));
+        if (i%2) {
+            EXPECT_EQ(unsigned(i), crossings[i/2].index);
+            EXPECT_DOUBLE_EQ(1./3., crossings[i/2].time);
+            EXPECT_DOUBLE_EQ(2./3., tss[n-1-i]);
+        }
+        else {
+            EXPECT_EQ(-1.0, tss[n-1-i]);
+        }
+    }
+
+    // With unchanged values, there are no new crossings and the recorded
+    // times since spike are cleared.
+    memory::copy(time_after, time_before);
+    memory::fill(time_after, 2.);
+    watch.test(&time_since_spike);
+    EXPECT_EQ(unsigned(n/2), watch.crossings().size());
+
+    memory::copy(time_since_spike, tss);
+    for (index_type i = 0; i<n; ++i) {
+        EXPECT_EQ(i%2==1, watch.is_crossed(i));
+        EXPECT_EQ(-1.0, tss[i]);
+    }
+}
+
 TEST(SPIKES_TEST_CLASS, threshold_watcher_interpolation) {
     double dt = 0.025;
     double duration = 1;
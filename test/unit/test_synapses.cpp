@@ -14,6 +14,7 @@
 #include "backends/multicore/mechanism.hpp"
 #include "util/maputil.hpp"
 #include "util/range.hpp"
+#include "util/span.hpp"
 
 #include "../common_cells.hpp"
 #include "common.hpp"
@@ -180,3 +181,65 @@ TEST(synapses, syn_basic_state) {
     EXPECT_TRUE(testing::seq_almost_eq<fvm_value_type>(expected, mechanism_field(exp2syn, "B")));
 }
 
+
+TEST(synapses, syn_event_delivery) {
+    using value_type = fvm_value_type;
+    using index_type = fvm_index_type;
+
+    // Deliver runs of events to expsyn instances in orders that give
+    // contiguous, independent and conflicting instance indices within a
+    // vector of events, with events split over two integration domains.
+
+    int num_syn = 16;
+    int num_comp = 2;
+    int num_intdom = 2;
+
+    value_type temp_K = *neuron_parameter_defaults.temperature_K;
+
+    auto expsyn = unique_cast<multicore::mechanism>(global_default_catalogue().instance<backend>("expsyn").mech);
+    ASSERT_TRUE(expsyn);
+
+    shared_state state(num_intdom,
+        num_intdom,
+        0,
+        std::vector<index_type>{0, 1},
+        std::vector<index_type>{0, 1},
+        {},
+        std::vector<value_type>(num_comp, -65),
+        std::vector<value_type>(num_comp, temp_K),
+        std::vector<value_type>(num_comp, 1.),
+        std::vector<index_type>(0),
+        expsyn->data_alignment());
+
+    state.reset();
+
+    std::vector<index_type> syn_cv(num_syn, 0);
+    std::fill(syn_cv.begin()+num_syn/2, syn_cv.end(), 1);
+    std::vector<index_type> syn_mult(num_syn, 1);
+    std::vector<value_type> syn_weight(num_syn, 1.0);
+
+    expsyn->instantiate(0, state, {}, {syn_cv, syn_weight, syn_mult});
+    expsyn->initialize();
+
+    std::vector<cell_local_size_type> targets[2] = {
+        {0, 1, 2, 3, 4, 5, 6, 7, 7, 6, 5, 4, 3, 2, 1, 0, 3, 3, 3, 3, 5, 0, 2, 5, 1, 7, 6, 4, 2},
+        {8, 11, 9, 14, 12, 10, 15, 13, 8, 8, 9, 10, 11, 12, 13, 14, 15}
+    };
+
+    std::vector<deliverable_event> events;
+    std::vector<value_type> expected(num_syn, 0.);
+    for (unsigned intdom: {0u, 1u}) {
+        for (auto i: util::count_along(targets[intdom])) {
+            auto syn = targets[intdom][i];
+            float weight = 0.25f*(i+1);
+            events.push_back({0., {0, syn, intdom}, weight});
+            expected[syn] += weight;
+        }
+    }
+
+    state.deliverable_events.init(events);
+    state.deliverable_events.mark_until_after(state.time);
+    expsyn->deliver_events();
+
+    EXPECT_TRUE(testing::seq_almost_eq<fvm_value_type>(expected, mechanism_field(expsyn, "g")));
+}
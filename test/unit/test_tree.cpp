@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <vector>
 
 #include "../gtest.h"
@@ -319,3 +320,34 @@ TEST(tree, depth_from_root) {
         EXPECT_EQ(expected, depth_from_root(tree(parent_index)));
     }
 }
+
+TEST(tree, minimize_depth) {
+    auto max_depth = [](const tree& t) {
+        auto depth = depth_from_root(t);
+        return *std::max_element(depth.begin(), depth.end());
+    };
+
+    {
+        //     0-1-2-3-4  ~>  2 is the new root
+        tree t(std::vector<int_type>{0, 0, 1, 2, 3});
+        auto perm = t.minimize_depth();
+        EXPECT_EQ(2u, perm[0]);
+        EXPECT_EQ(2u, max_depth(t));
+    }
+    {
+        //     0
+        //     |
+        //     1
+        //    / \.
+        //   2   3
+        //   |
+        //   4
+        //   |
+        //   5
+        tree t(std::vector<int_type>{0, 0, 1, 1, 2, 4});
+        auto perm = t.minimize_depth();
+        EXPECT_EQ(6u, perm.size());
+        EXPECT_EQ(2u, max_depth(t));
+        EXPECT_TRUE(is_minimal_degree(t.parents()));
+    }
+}
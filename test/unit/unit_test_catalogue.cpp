@@ -10,6 +10,9 @@
 #include "mechanisms/ca_linear.hpp"
 #include "mechanisms/celsius_test.hpp"
 #include "mechanisms/diam_test.hpp"
+#include "mechanisms/time_dt_test.hpp"
+#include "mechanisms/table_test.hpp"
+#include "mechanisms/table_celsius_test.hpp"
 #include "mechanisms/non_linear.hpp"
 #include "mechanisms/param_as_state.hpp"
 #include "mechanisms/post_events_syn.hpp"
@@ -32,6 +35,8 @@
 #include "mechanisms/linear_ca_conc.hpp"
 #include "mechanisms/test_cl_valence.hpp"
 #include "mechanisms/test_ca_read_valence.hpp"
+#include "mechanisms/test_derivimplicit.hpp"
+#include "mechanisms/test_derivimplicit_stiff.hpp"
 #include "mechanisms/read_eX.hpp"
 #include "mechanisms/write_Xi_Xo.hpp"
 #include "mechanisms/write_multiple_eX.hpp"
@@ -41,6 +46,9 @@
 #include "mechanisms/test_ca.hpp"
 #include "mechanisms/test_kin1.hpp"
 #include "mechanisms/test_kinlva.hpp"
+#include "mechanisms/single/hh.hpp"
+#include "mechanisms/single/expsyn.hpp"
+#include "mechanisms/simd2/pas.hpp"
 
 #include "../gtest.h"
 
@@ -66,6 +74,9 @@ mechanism_catalogue make_unit_test_catalogue(const mechanism_catalogue& from) {
     ADD_MECH(cat, ca_linear)
     ADD_MECH(cat, celsius_test)
     ADD_MECH(cat, diam_test)
+    ADD_MECH(cat, time_dt_test)
+    ADD_MECH(cat, table_test)
+    ADD_MECH(cat, table_celsius_test)
     ADD_MECH(cat, param_as_state)
     ADD_MECH(cat, post_events_syn)
     ADD_MECH(cat, test_linear_state)
@@ -88,12 +99,17 @@ mechanism_catalogue make_unit_test_catalogue(const mechanism_catalogue& from) {
     ADD_MECH(cat, linear_ca_conc)
     ADD_MECH(cat, test_cl_valence)
     ADD_MECH(cat, test_ca_read_valence)
+    ADD_MECH(cat, test_derivimplicit)
+    ADD_MECH(cat, test_derivimplicit_stiff)
     ADD_MECH(cat, read_eX)
     ADD_MECH(cat, write_Xi_Xo)
     ADD_MECH(cat, write_multiple_eX)
     ADD_MECH(cat, write_eX)
     ADD_MECH(cat, read_cai_init)
     ADD_MECH(cat, write_cai_breakpoint)
+    ADD_MECH(cat, hh_single)
+    ADD_MECH(cat, expsyn_single)
+    ADD_MECH(cat, pas_simd2)
 
     return cat;
 }